@@ -0,0 +1,58 @@
+#include "BenchHarness.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+
+namespace {
+    constexpr int MAX_CALIBRATED_ITERATIONS = 1 << 24;
+}
+
+BenchRunner::BenchRunner() :
+    repetitions(15),
+    minBatchMs(20.0),
+    caseCount(0)
+{
+}
+
+double BenchRunner::TimeBatch(const std::function<void()>& setup,
+                              const std::function<void(int)>& body, int iterations) const {
+    if (setup) setup();
+    auto start = std::chrono::steady_clock::now();
+    body(iterations);
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count();
+}
+
+void BenchRunner::Run(const char* name, const BenchParams& params, double itemsPerOp,
+                      const std::function<void()>& setup,
+                      const std::function<void(int)>& body,
+                      int maxIterations) {
+    if (!nameFilter.empty() && std::string(name).find(nameFilter) == std::string::npos) {
+        return;
+    }
+
+    // Calibrate: double the batch until it is long enough to time reliably
+    int iterations = 1;
+    int limit = maxIterations > 0 ? maxIterations : MAX_CALIBRATED_ITERATIONS;
+    while (iterations < limit && TimeBatch(setup, body, iterations) < minBatchMs * 1e6) {
+        iterations = std::min(iterations * 2, limit);
+    }
+
+    // Warm-up batch, then the measured ones
+    TimeBatch(setup, body, iterations);
+    samples.clear();
+    for (int rep = 0; rep < repetitions; rep++) {
+        samples.push_back(TimeBatch(setup, body, iterations) / iterations);
+    }
+    std::sort(samples.begin(), samples.end());
+
+    double median = samples[samples.size() / 2];
+    double items = std::max(itemsPerOp, 1.0);
+    std::printf("{\"bench\":\"%s\",\"racers\":%d,\"obstacles\":%d,\"iterations\":%d,\"reps\":%d,"
+                "\"ns_per_op\":%.1f,\"ns_per_op_min\":%.1f,\"ns_per_op_max\":%.1f,"
+                "\"items_per_op\":%.0f,\"ns_per_item\":%.2f}\n",
+                name, params.racers, params.obstacles, iterations, repetitions,
+                median, samples.front(), samples.back(), items, median / items);
+    std::fflush(stdout);
+    caseCount++;
+}
@@ -0,0 +1,57 @@
+#ifndef BENCHHARNESS_H
+#define BENCHHARNESS_H
+
+#include <functional>
+#include <string>
+#include <vector>
+
+// Keeps the compiler from discarding a computed value
+template <typename T>
+inline void DoNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+struct BenchParams {
+    int racers;
+    int obstacles;
+};
+
+// Minimal benchmark runner. Each case is calibrated to a minimum batch
+// duration, warmed up, then timed for a fixed number of repetitions. One JSON
+// line per case is printed with the median, min and max time per operation
+// and per item (e.g. per bike or per pair).
+class BenchRunner {
+public:
+    BenchRunner();
+
+    void SetFilter(const std::string& filter) { nameFilter = filter; }
+    void SetRepetitions(int reps) { repetitions = reps; }
+    void SetMinBatchMs(double ms) { minBatchMs = ms; }
+
+    // setup runs before every timed batch and is not measured; body runs
+    // `iterations` operations. maxIterations caps batches whose state would
+    // drift too far (e.g. a race finishing).
+    void Run(const char* name, const BenchParams& params, double itemsPerOp,
+             const std::function<void()>& setup,
+             const std::function<void(int iterations)>& body,
+             int maxIterations = 0);
+
+    int GetCaseCount() const { return caseCount; }
+
+private:
+    double TimeBatch(const std::function<void()>& setup,
+                     const std::function<void(int)>& body, int iterations) const;
+
+    std::string nameFilter;
+    int repetitions;
+    double minBatchMs;
+    int caseCount;
+    std::vector<double> samples;
+};
+
+#endif // BENCHHARNESS_H
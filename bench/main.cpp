@@ -0,0 +1,497 @@
+// BikeRaceBench: microbenchmarks for the simulation hot paths. Runs without
+// a window; results are printed as one JSON line per case.
+//
+//     ./bin/BikeRaceBench [--filter name] [--reps n] [--min-batch-ms ms]
+//     ./bin/BikeRaceBench --bandwidth      (snapshot bandwidth report only)
+
+#include "BenchHarness.h"
+#include "core/InputManager.h"
+#include "entities/Bike.h"
+#include "level/Checkpoint.h"
+#include "level/Obstacle.h"
+#include "level/Track.h"
+#include "net/SnapshotCodec.h"
+#include "physics/PhysicsEngine.h"
+#include "systems/EngineSynth.h"
+#include "systems/LevelManager.h"
+#include "utils/Config.h"
+#include "utils/Logger.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+    constexpr uint32_t SEED = 12345;
+    constexpr int TICKS_PER_BATCH_LIMIT = 120;   // 2 s of racing, well before anyone finishes
+
+    const int RACER_COUNTS[] = {5, 50, 500};
+    const int OBSTACLE_COUNTS[] = {3, 50, 500};
+
+    // Deterministic scatter over the playable area (|x|, |z| < 90)
+    std::vector<Vector3> ScatterPositions(int count, uint32_t seed) {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> coord(-90.0f, 90.0f);
+        std::vector<Vector3> positions(count);
+        for (auto& p : positions) {
+            p = {coord(rng), 0.5f, coord(rng)};
+        }
+        return positions;
+    }
+
+    // Packed grid so neighbouring bikes (radius 2) overlap
+    std::vector<Vector3> PackedPositions(int count) {
+        std::vector<Vector3> positions(count);
+        int columns = 20;
+        for (int i = 0; i < count; i++) {
+            positions[i] = {(i % columns) * 3.0f - 30.0f, 0.5f, (i / columns) * 3.0f - 30.0f};
+        }
+        return positions;
+    }
+
+    std::vector<std::unique_ptr<Bike>> MakeBikes(const std::vector<Vector3>& positions) {
+        std::vector<std::unique_ptr<Bike>> bikes;
+        for (const Vector3& p : positions) {
+            bikes.push_back(std::make_unique<Bike>());
+            bikes.back()->Initialize(p, RED);
+        }
+        return bikes;
+    }
+
+    // A LevelManager with the requested racers on the beginner track plus
+    // extra scattered obstacles
+    struct RaceFixture {
+        PhysicsEngine physics;
+        InputManager input;
+        LevelManager level;
+        int extraObstacles;
+
+        RaceFixture(int racers, int obstacles) : extraObstacles(obstacles) {
+            level.Initialize(&physics, &input);
+            level.SetRacerCount(racers);
+        }
+
+        // Fresh race, countdown skipped
+        void Reset() {
+            std::srand(SEED);
+            level.SetSeed(SEED);
+            level.LoadLevel(1);
+            Track* track = level.GetCurrentTrack();
+            int existing = (int)track->GetObstacles().size();
+            std::vector<Vector3> positions = ScatterPositions(std::max(extraObstacles - existing, 0), SEED + 1);
+            for (const Vector3& p : positions) {
+                track->AddObstacle({p.x, 1.0f, p.z}, ObstacleType::STATIC_BARRIER, {2, 2, 2});
+            }
+            level.StartRace();
+            level.Update(3.0f + Config::FIXED_TIMESTEP);
+        }
+    };
+
+    void BenchApplyPhysics(BenchRunner& runner) {
+        for (int racers : RACER_COUNTS) {
+            std::vector<Vector3> start = ScatterPositions(racers, SEED);
+            auto bikes = MakeBikes(start);
+            PhysicsEngine physics;
+            Vector3 velocity = {12.0f, 0.0f, 20.0f};
+
+            runner.Run("physics.apply_physics", {racers, 0}, racers, nullptr, [&](int iterations) {
+                for (int it = 0; it < iterations; it++) {
+                    for (int i = 0; i < racers; i++) {
+                        bikes[i]->SetPosition(start[i]);
+                        bikes[i]->SetVelocity(velocity);
+                        physics.ApplyPhysics(bikes[i].get(), Config::FIXED_TIMESTEP);
+                    }
+                    DoNotOptimize(bikes[0]->GetPosition());
+                }
+            });
+        }
+    }
+
+    void BenchResolveCollision(BenchRunner& runner) {
+        for (int racers : RACER_COUNTS) {
+            std::vector<Vector3> start = PackedPositions(racers);
+            auto bikes = MakeBikes(start);
+            PhysicsEngine physics;
+            double pairs = racers * (racers - 1) / 2.0;
+
+            runner.Run("physics.resolve_collision", {racers, 0}, pairs, nullptr, [&](int iterations) {
+                for (int it = 0; it < iterations; it++) {
+                    for (int i = 0; i < racers; i++) {
+                        bikes[i]->SetPosition(start[i]);
+                        bikes[i]->SetVelocity({0.0f, 0.0f, 10.0f});
+                    }
+                    for (int i = 0; i < racers; i++) {
+                        for (int j = i + 1; j < racers; j++) {
+                            physics.ResolveCollision(bikes[i].get(), bikes[j].get());
+                        }
+                    }
+                    DoNotOptimize(bikes[0]->GetPosition());
+                }
+            });
+        }
+    }
+
+    void BenchObstacleCollision(BenchRunner& runner) {
+        for (int racers : RACER_COUNTS) {
+            for (int obstacleCount : OBSTACLE_COUNTS) {
+                std::vector<Vector3> bikePositions = ScatterPositions(racers, SEED);
+                std::vector<std::unique_ptr<Obstacle>> obstacles;
+                for (const Vector3& p : ScatterPositions(obstacleCount, SEED + 1)) {
+                    obstacles.push_back(std::make_unique<Obstacle>(Vector3{p.x, 1.0f, p.z},
+                                                                   ObstacleType::STATIC_BARRIER,
+                                                                   Vector3{2, 2, 2}));
+                }
+
+                runner.Run("obstacle.check_collision", {racers, obstacleCount}, (double)racers * obstacleCount,
+                           nullptr, [&](int iterations) {
+                    int hits = 0;
+                    for (int it = 0; it < iterations; it++) {
+                        for (const Vector3& bikePos : bikePositions) {
+                            for (const auto& obstacle : obstacles) {
+                                hits += obstacle->CheckCollision(bikePos, 2.0f) ? 1 : 0;
+                            }
+                        }
+                    }
+                    DoNotOptimize(hits);
+                });
+            }
+        }
+
+        // The whole pass, bike pairs and obstacles, from the starting grid.
+        // Per racer cost should stay flat as both counts grow.
+        for (int racers : RACER_COUNTS) {
+            for (int obstacleCount : OBSTACLE_COUNTS) {
+                RaceFixture fixture(racers, obstacleCount);
+
+                runner.Run("level.check_collisions", {racers, obstacleCount}, racers,
+                           [&]() { fixture.Reset(); },
+                           [&](int iterations) {
+                    for (int it = 0; it < iterations; it++) {
+                        fixture.level.CheckCollisions();
+                    }
+                    DoNotOptimize(fixture.level.GetPlayer(0)->GetBike()->GetPosition());
+                }, TICKS_PER_BATCH_LIMIT);
+            }
+        }
+    }
+
+    void BenchCheckpointPassage(BenchRunner& runner) {
+        Track track;
+        track.LoadTrack("Beginner Circuit");
+        const auto& checkpoints = track.GetCheckpoints();
+
+        for (int racers : RACER_COUNTS) {
+            std::vector<Vector3> bikePositions = ScatterPositions(racers, SEED);
+
+            runner.Run("checkpoint.check_passage", {racers, 0}, (double)racers * checkpoints.size(),
+                       nullptr, [&](int iterations) {
+                int passed = 0;
+                for (int it = 0; it < iterations; it++) {
+                    for (const Vector3& bikePos : bikePositions) {
+                        for (const auto& checkpoint : checkpoints) {
+                            passed += checkpoint->CheckPassage(bikePos, 2.0f) ? 1 : 0;
+                        }
+                    }
+                }
+                DoNotOptimize(passed);
+            });
+        }
+    }
+
+    void BenchUpdatePlayerPositions(BenchRunner& runner) {
+        for (int racers : RACER_COUNTS) {
+            RaceFixture fixture(racers, 0);
+            fixture.Reset();
+
+            // Spread progress so the ranking sort has work to do
+            std::mt19937 rng(SEED);
+            int checkpointCount = fixture.level.GetCurrentTrack()->GetTotalCheckpoints();
+            for (int id = 0; id < racers; id++) {
+                fixture.level.GetPlayer(id)->SetCheckpointsPassed((int)(rng() % checkpointCount));
+            }
+
+            runner.Run("level.update_player_positions", {racers, 0}, racers, nullptr, [&](int iterations) {
+                for (int it = 0; it < iterations; it++) {
+                    fixture.level.UpdatePlayerPositions();
+                }
+                DoNotOptimize(fixture.level.GetPlayer(0)->GetRacePosition());
+            });
+        }
+    }
+
+    void BenchDriveAI(BenchRunner& runner) {
+        Track track;
+        track.LoadTrack("Intermediate Track");
+        BikeStats stats = Bike::GetBaseStats();
+        RacingLine line;
+        int obstacleCount = (int)track.GetObstacles().size();
+        runner.Run("racing_line.build", {0, obstacleCount}, 1, nullptr, [&](int iterations) {
+            for (int it = 0; it < iterations; it++) {
+                line.Build(track, stats);
+            }
+            DoNotOptimize(line.GetSampleCount());
+        });
+
+        for (int racers : RACER_COUNTS) {
+            RaceFixture fixture(racers, 0);
+            fixture.Reset();
+            // A couple of seconds in, so racers are spread along the line
+            for (int tick = 0; tick < 120; tick++) {
+                fixture.level.Update(Config::FIXED_TIMESTEP);
+            }
+            const RacingLine& raceLine = fixture.level.GetCurrentTrack()->GetRacingLine();
+            AIParams params = AIParams::Defaults(3);
+            AISensors sensors = AISensors::Clear();
+
+            runner.Run("player.drive_ai", {racers, 0}, racers, nullptr, [&](int iterations) {
+                RacerInput input = {};
+                for (int it = 0; it < iterations; it++) {
+                    for (int id = 0; id < racers; id++) {
+                        input = fixture.level.GetPlayer(id)->DriveAI(raceLine, params, sensors);
+                    }
+                }
+                DoNotOptimize(input.turn);
+            });
+        }
+
+        // Per racer cost of the ray fan; should stay flat as obstacles grow
+        for (int racers : RACER_COUNTS) {
+            for (int obstacleCount : OBSTACLE_COUNTS) {
+                RaceFixture fixture(racers, obstacleCount);
+                fixture.Reset();
+                for (int tick = 0; tick < 120; tick++) {
+                    fixture.level.Update(Config::FIXED_TIMESTEP);
+                }
+
+                runner.Run("level.sense_ai", {racers, obstacleCount}, racers, nullptr, [&](int iterations) {
+                    for (int it = 0; it < iterations; it++) {
+                        fixture.level.SenseAI();
+                    }
+                    DoNotOptimize(fixture.level.GetPlayer(0)->GetBike()->GetPosition());
+                });
+            }
+        }
+    }
+
+    void BenchSnapshot(BenchRunner& runner) {
+        for (int racers : RACER_COUNTS) {
+            RaceFixture fixture(racers, 50);
+            fixture.Reset();
+            RaceSnapshot snapshot;
+            fixture.level.SaveState(snapshot);
+
+            runner.Run("level.save_state", {racers, 50}, racers, nullptr, [&](int iterations) {
+                for (int it = 0; it < iterations; it++) {
+                    fixture.level.SaveState(snapshot);
+                }
+                DoNotOptimize(snapshot.GetHeader().raceTick);
+            });
+            runner.Run("level.load_state", {racers, 50}, racers, nullptr, [&](int iterations) {
+                bool loaded = true;
+                for (int it = 0; it < iterations; it++) {
+                    loaded &= fixture.level.LoadState(snapshot);
+                }
+                DoNotOptimize(loaded);
+            });
+        }
+    }
+
+    void BenchLevelTick(BenchRunner& runner) {
+        for (int racers : RACER_COUNTS) {
+            for (int obstacleCount : OBSTACLE_COUNTS) {
+                RaceFixture fixture(racers, obstacleCount);
+
+                runner.Run("level.tick", {racers, obstacleCount}, racers,
+                           [&]() { fixture.Reset(); },
+                           [&](int iterations) {
+                    for (int it = 0; it < iterations; it++) {
+                        fixture.level.Update(Config::FIXED_TIMESTEP);
+                    }
+                    DoNotOptimize(fixture.level.GetPlayer(0)->GetBike()->GetPosition());
+                }, TICKS_PER_BATCH_LIMIT);
+            }
+        }
+    }
+
+    // One audio callback's worth of engine sound with every voice in use;
+    // items are output frames
+    void BenchEngineSynth(BenchRunner& runner) {
+        constexpr unsigned int FRAMES = 1024;
+        EngineSynth synth;
+        std::vector<float> output(FRAMES * 2);
+        int tick = 0;
+
+        runner.Run("audio.engine_synth_render", {EngineSynth::VOICE_COUNT, 0}, FRAMES, nullptr, [&](int iterations) {
+            for (int it = 0; it < iterations; it++) {
+                // New parameters every buffer, as from a tick
+                for (int voice = 0; voice < EngineSynth::VOICE_COUNT; voice++) {
+                    float speed = (float)((tick + voice * 7) % 60);
+                    synth.SetVoice(voice, {EngineSynth::RpmFromSpeed(speed, 60.0f), 1.0f, 0.5f, voice % 2 ? 0.5f : -0.5f});
+                }
+                tick++;
+                synth.Render(output.data(), FRAMES);
+            }
+            DoNotOptimize(output[0]);
+        });
+    }
+}
+
+namespace {
+    // Bytes per racer if position, velocity and direction went out as raw
+    // floats every tick, the baseline the codec is measured against
+    constexpr int RAW_RACER_BYTES = 3 * sizeof(Vector3);
+    constexpr int BANDWIDTH_SECONDS = 20;
+    constexpr int BROADCAST_INTERVAL_TICKS = 3;   // As on the server: 20 Hz
+    constexpr int ACK_DELAY_SNAPSHOTS = 2;        // ~100 ms round trip
+    constexpr int SLOW_ACK_DELAY_SNAPSHOTS = 6;   // ~300 ms, longer than the far refresh interval
+    constexpr float LOSS_PERCENT = 5.0f;
+    constexpr double MAX_INTEREST_RATIO = 0.9;    // Interest must save at least 10% over delta...
+    constexpr int MIN_INTEREST_RACERS = 50;       // ...once the field spreads past the near band
+
+    struct BandwidthResult {
+        double bytes;
+        double packets;
+        double encodeUs;
+        int mismatches;
+    };
+
+    // Streams recorded frames to one simulated client through a lossy link
+    BandwidthResult StreamSnapshots(const std::vector<std::vector<RaceProtocol::QuantizedRacer>>& frames,
+                                    float trackLength, bool acknowledge, bool interest, int viewer,
+                                    int ackDelay = ACK_DELAY_SNAPSHOTS) {
+        SnapshotEncoder encoder;
+        SnapshotDecoder decoder;
+        encoder.SetInterestEnabled(interest);
+        encoder.SetTrackLength(trackLength);
+        std::mt19937 rng(SEED);
+        std::uniform_real_distribution<float> unit(0.0f, 100.0f);
+        std::deque<std::pair<size_t, uint16_t>> acks;   // (deliver before frame, sequence)
+
+        BandwidthResult result = {};
+        for (size_t frame = 0; frame < frames.size(); frame++) {
+            while (!acks.empty() && acks.front().first <= frame) {
+                encoder.Acknowledge(acks.front().second);
+                acks.pop_front();
+            }
+
+            const auto& racers = frames[frame];
+            auto start = std::chrono::steady_clock::now();
+            int fragments = encoder.Encode({0, (uint32_t)frame, 0}, racers.data(), (int)racers.size(), viewer);
+            result.encodeUs += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+            for (int f = 0; f < fragments; f++) {
+                result.bytes += encoder.GetPacketSize(f);
+                result.packets++;
+                if (unit(rng) < LOSS_PERCENT) continue;
+                if (!decoder.Decode(encoder.GetPacket(f), encoder.GetPacketSize(f))) continue;
+
+                // Complete: the client must hold exactly what the encoder
+                // expects it to, which without interest is the current frame
+                const auto& decoded = decoder.GetRacers();
+                const auto& expected = encoder.GetClientView();
+                for (size_t i = 0; i < racers.size(); i++) {
+                    if (decoded[i] != expected[i] || (!interest && decoded[i] != racers[i])) {
+                        result.mismatches++;
+                    }
+                }
+                if (acknowledge) {
+                    acks.push_back({frame + ackDelay, decoder.GetAckSequence()});
+                }
+            }
+        }
+        result.encodeUs /= std::max<size_t>(frames.size(), 1);
+        return result;
+    }
+
+    // False if any client diverged or interest management stopped paying off
+    bool ReportSnapshotBandwidth() {
+        bool ok = true;
+        for (int racers : RACER_COUNTS) {
+            // Record the race once so every encoding sees the same frames
+            RaceFixture fixture(racers, 3);
+            fixture.Reset();
+            float trackLength = fixture.level.GetCurrentTrack()->GetRacingLine().GetLength();
+            std::vector<std::vector<RaceProtocol::QuantizedRacer>> frames;
+            int ticks = BANDWIDTH_SECONDS * 60;
+            for (int tick = 0; tick < ticks; tick++) {
+                fixture.level.Update(Config::FIXED_TIMESTEP);
+                if (tick % BROADCAST_INTERVAL_TICKS != 0) continue;
+
+                frames.emplace_back(racers);
+                for (int i = 0; i < racers; i++) {
+                    const Player* player = fixture.level.GetPlayer(i);
+                    const Bike* bike = player->GetBike();
+                    frames.back()[i] = RaceProtocol::Quantize({bike->GetPosition(), bike->GetRotation(),
+                        bike->GetSpeed(), player->GetCurrentLap(), player->HasFinishedRace()});
+                }
+            }
+
+            int viewer = 1;   // An AI racer, so the viewpoint actually moves
+            BandwidthResult quantized = StreamSnapshots(frames, trackLength, false, false, viewer);
+            BandwidthResult delta = StreamSnapshots(frames, trackLength, true, false, viewer);
+            BandwidthResult interest = StreamSnapshots(frames, trackLength, true, true, viewer);
+            BandwidthResult slowAck = StreamSnapshots(frames, trackLength, true, true, viewer, SLOW_ACK_DELAY_SNAPSHOTS);
+            bool interestSaves = interest.bytes <= delta.bytes * MAX_INTEREST_RATIO &&
+                                 slowAck.bytes <= delta.bytes * MAX_INTEREST_RATIO;
+            int mismatches = quantized.mismatches + delta.mismatches + interest.mismatches + slowAck.mismatches;
+            if (mismatches > 0 || (racers >= MIN_INTEREST_RACERS && !interestSaves)) ok = false;
+
+            double seconds = BANDWIDTH_SECONDS;
+            double rawBytesPerSecond = 60.0 * racers * RAW_RACER_BYTES;
+            std::printf("{\"bench\":\"snapshot_bandwidth\",\"racers\":%d,\"seconds\":%d,\"loss_pct\":%.0f,"
+                        "\"raw_kbytes_per_s\":%.1f,\"quantized_kbytes_per_s\":%.1f,\"delta_kbytes_per_s\":%.1f,"
+                        "\"interest_kbytes_per_s\":%.1f,\"interest_packets_per_s\":%.1f,"
+                        "\"interest_slow_ack_kbytes_per_s\":%.1f,\"interest_saves\":%s,\"encode_us_avg\":%.2f,"
+                        "\"mismatches\":%d}\n",
+                        racers, BANDWIDTH_SECONDS, LOSS_PERCENT, rawBytesPerSecond / 1024.0,
+                        quantized.bytes / seconds / 1024.0, delta.bytes / seconds / 1024.0,
+                        interest.bytes / seconds / 1024.0, interest.packets / seconds,
+                        slowAck.bytes / seconds / 1024.0, interestSaves ? "true" : "false", interest.encodeUs,
+                        mismatches);
+            std::fflush(stdout);
+        }
+        return ok;
+    }
+}
+
+int main(int argc, char** argv) {
+    // Results go to stdout; keep log lines out of it
+    Logger::GetInstance().SetConsoleOutput(false);
+
+    BenchRunner runner;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--bandwidth") {
+            bool ok = ReportSnapshotBandwidth();
+            Logger::GetInstance().Shutdown();
+            return ok ? 0 : 1;
+        } else if (arg == "--filter" && i + 1 < argc) {
+            runner.SetFilter(argv[++i]);
+        } else if (arg == "--reps" && i + 1 < argc) {
+            runner.SetRepetitions(std::max(std::atoi(argv[++i]), 1));
+        } else if (arg == "--min-batch-ms" && i + 1 < argc) {
+            runner.SetMinBatchMs(std::atof(argv[++i]));
+        } else {
+            std::fprintf(stderr, "Usage: %s [--filter name] [--reps n] [--min-batch-ms ms] | --bandwidth\n", argv[0]);
+            return 2;
+        }
+    }
+
+    BenchApplyPhysics(runner);
+    BenchResolveCollision(runner);
+    BenchObstacleCollision(runner);
+    BenchCheckpointPassage(runner);
+    BenchUpdatePlayerPositions(runner);
+    BenchDriveAI(runner);
+    BenchSnapshot(runner);
+    BenchLevelTick(runner);
+    BenchEngineSynth(runner);
+
+    Logger::GetInstance().Shutdown();
+    return runner.GetCaseCount() > 0 ? 0 : 1;
+}
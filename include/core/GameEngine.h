@@ -1,10 +1,13 @@
 #ifndef GAMEENGINE_H
 #define GAMEENGINE_H
 
+#include <future>
 #include <memory>
 #include <string>
+#include <vector>
 #include <cstdarg>
 #include <cstddef>
+#include <cstdint>
 #include "raylib.h"
 
 // Forward declarations
@@ -13,6 +16,14 @@ class UIManager;
 class LevelManager;
 class AudioManager;
 class PhysicsEngine;
+class ResolutionScaler;
+class RenderQueue;
+class RenderBackend;
+class PerfOverlay;
+class RollbackSession;
+class InputLatencyMonitor;
+class ThreadPool;
+class SaveGame;
 
 enum class GameState {
     MAIN_MENU,
@@ -35,6 +46,44 @@ public:
     void Run();
     void Shutdown();
 
+    // Headless mode: subsystems without a window, audio device or GPU resources
+    void InitializeHeadless();
+    bool IsHeadless() const { return headless; }
+
+    // Records every track's scene into the null backend and prints per-frame
+    // submission stats as JSON lines. Returns non-zero if any draw was invalid.
+    int RunRenderBenchmark(int framesPerTrack);
+
+    // Races each racer count on the beginner track with every racer AI and
+    // prints the mean and worst per-tick time of each simulation section,
+    // plus render submission into the null backend, as JSON lines
+    int RunStressTest(const std::vector<int>& racerCounts, int ticks);
+
+    // Runs menu frames until the deferred startup work is done (or the
+    // frame limit), then prints the startup timeline and the time to the
+    // first interactive frame as JSON lines; call after Initialize()
+    int RunStartupReport(int maxFrames);
+
+    // Re-runs a recorded race as fast as possible and prints a JSON summary.
+    // Returns non-zero if the replay can't be loaded or doesn't reproduce
+    // the recorded final state.
+    int RunReplay(const std::string& path);
+
+    // Input-to-display latency: every input edge is followed from the poll
+    // that saw it to the first frame shown after the tick that used it, and
+    // a histogram is printed as JSON at shutdown. Costs nothing when off.
+    void EnableLatencyMonitor();
+    // Unattended latency run: scripted steering drives player 1 through
+    // races for the given number of frames. Headless, the frame counts as
+    // shown once flushed into the null backend. Returns non-zero if no
+    // input was measured.
+    int RunLatencyTest(int frames);
+
+    // Two-player online race with rollback netcode; call after Initialize().
+    // The host picks the seed and track, the client receives them on joining.
+    bool HostOnlineRace(uint16_t port, int trackID);
+    bool JoinOnlineRace(const std::string& hostAddress);
+
     // State management
     void SetState(GameState newState);
     GameState GetState() const { return currentState; }
@@ -46,8 +95,15 @@ public:
     InputManager* GetInputManager() const { return inputManager.get(); }
     UIManager* GetUIManager() const { return uiManager.get(); }
     LevelManager* GetLevelManager() const { return levelManager.get(); }
-    AudioManager* GetAudioManager() const { return audioManager.get(); }
+    // Null until the audio worker has the device and sound banks up
+    AudioManager* GetAudioManager() const { return audioReady ? audioManager.get() : nullptr; }
     PhysicsEngine* GetPhysicsEngine() const { return physicsEngine.get(); }
+    ResolutionScaler* GetResolutionScaler() const { return resolutionScaler.get(); }
+    RenderQueue* GetRenderQueue() const { return renderQueue.get(); }
+    PerfOverlay* GetPerfOverlay() const { return perfOverlay.get(); }
+
+    // Dynamic resolution
+    void SetFrameTimeBudget(float budgetMs);
 
 private:
     GameEngine(); // Defined in .cpp
@@ -55,12 +111,25 @@ private:
     GameEngine(const GameEngine&) = delete;
     GameEngine& operator=(const GameEngine&) = delete;
 
+    void CreateSubsystems();
+    void RunFrame();
     void Update();
-    void Render();
+    bool Render();   // Returns true if the 3D scene was drawn this frame
+    void RenderScene();
     void ProcessInput();
+    void UpdateAudio();
+    void FinishAudioStartup();
+    void PlayMusic(const char* musicName);   // Or once audio is ready
+    bool IsStartupComplete() const;   // Picks up the worker's result once it is done
+    void CreateSceneTarget();
+    void SaveRaceReplay();
+    void BeginOnlineRace(std::unique_ptr<RollbackSession> session);
+    void UpdateOnlineRace();
+    void EndOnlineRace();
 
     // State
     bool isRunning;
+    bool headless;
     GameState currentState;
     float deltaTime;
     float accumulator;
@@ -71,6 +140,24 @@ private:
     std::unique_ptr<LevelManager> levelManager;
     std::unique_ptr<AudioManager> audioManager;
     std::unique_ptr<PhysicsEngine> physicsEngine;
+    std::unique_ptr<ResolutionScaler> resolutionScaler;
+    std::unique_ptr<RenderQueue> renderQueue;
+    std::unique_ptr<RenderBackend> renderBackend;
+    std::unique_ptr<PerfOverlay> perfOverlay;
+    std::unique_ptr<ThreadPool> loadPool;   // Asset decompression and decoding
+    std::unique_ptr<RollbackSession> netSession;   // Only during online races
+    std::unique_ptr<InputLatencyMonitor> latencyMonitor;   // Only when measuring
+    std::unique_ptr<SaveGame> saveGame;   // Not in headless runs
+    std::future<void> audioStartup;   // Audio device and sound banks, on a worker
+    bool audioReady;   // Until set, the worker owns audioManager
+    int impactSound;   // SoundHandle of the collision effect
+    const char* pendingMusic;   // Asked for before audio was ready
+
+    // Offscreen target for the 3D scene, allocated once at native size.
+    // Only the bottom-left scaled region is rendered into each frame.
+    RenderTexture2D sceneTarget;
+    bool sceneTargetLoaded;
+    long long framesPresented;
 };
 
 #endif // GAMEENGINE_H
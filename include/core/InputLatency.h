@@ -0,0 +1,54 @@
+#ifndef INPUTLATENCY_H
+#define INPUTLATENCY_H
+
+#include <array>
+#include <cstdint>
+
+// Follows input edges from the poll that saw them (InputManager::Update),
+// through the fixed-step tick that consumed them, to the first frame drawn
+// after that tick (EndDrawing returning, or the flush to the null backend
+// when headless). Fixed-size; nothing allocates while measuring.
+class InputLatencyMonitor {
+public:
+    static constexpr int FINE_BUCKET_COUNT = 80;                 // 0.05 ms buckets up to 4 ms...
+    static constexpr int BUCKET_COUNT = FINE_BUCKET_COUNT + 96;  // ...then 1 ms up to 100; the last also takes everything slower
+    static constexpr int PENDING_CAPACITY = 32;  // Consumed edges waiting for their frame
+
+    InputLatencyMonitor();
+
+    // Seconds on the clock every timestamp here uses
+    static double Now();
+
+    void OnConsumed(double sampleTime, double tickTime);
+    void OnPresented(double presentTime);
+    void Reset();
+
+    int GetSampleCount() const { return sampleCount; }
+    // Interpolated within its bucket, never above the slowest sample
+    float GetPercentileMs(float percentile) const;
+
+    // One JSON line on stdout with the percentiles, the split between
+    // waiting for a tick and waiting for a frame, and the non-empty buckets
+    void PrintReport(const char* label) const;
+
+private:
+    struct Pending {
+        double sampleTime;
+        double tickTime;
+    };
+
+    static int BucketFor(double ms);
+    static double BucketStartMs(int bucket);
+
+    std::array<Pending, PENDING_CAPACITY> pending;
+    int pendingCount;
+    int droppedCount;
+
+    std::array<uint32_t, BUCKET_COUNT> histogram;
+    int sampleCount;
+    double maxMs;
+    double sampleToTickMs;     // Sums, for the averages
+    double tickToPresentMs;
+};
+
+#endif // INPUTLATENCY_H
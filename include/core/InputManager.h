@@ -2,6 +2,13 @@
 #define INPUTMANAGER_H
 
 #include "raylib.h"
+#include "utils/Config.h"
+#include <array>
+#include <bitset>
+#include <cstdint>
+#include <random>
+
+class InputLatencyMonitor;
 
 enum class InputAction {
     ACCELERATE,
@@ -15,21 +22,71 @@ enum class InputAction {
     MENU_UP,
     MENU_DOWN,
     MENU_LEFT,
-    MENU_RIGHT
+    MENU_RIGHT,
+    COUNT
+};
+
+using ActionBits = std::bitset<(size_t)InputAction::COUNT>;
+
+// Every bound key and gamepad control, read once per frame. Driving actions
+// are per player; menu and pause actions are shared by both keyboards.
+struct InputSnapshot {
+    static constexpr int SHARED_SLOT = Config::MAX_HUMAN_PLAYERS;
+    static constexpr int SLOT_COUNT = Config::MAX_HUMAN_PLAYERS + 1;
+
+    std::array<ActionBits, SLOT_COUNT> down;
+    std::array<ActionBits, SLOT_COUNT> pressed;    // Down now, up last frame
+    std::array<ActionBits, SLOT_COUNT> released;   // Up now, down last frame
+
+    // Gamepad axes per player, quantized to -127..127 (0 without a gamepad);
+    // partly pushed, they give partial driving input (GetActionAmount)
+    std::array<int8_t, Config::MAX_HUMAN_PLAYERS> steer;
+    std::array<int8_t, Config::MAX_HUMAN_PLAYERS> throttle;
+    std::array<int8_t, Config::MAX_HUMAN_PLAYERS> brake;
+
+    double time;   // When it was polled (InputLatencyMonitor::Now)
+};
+
+// A change in one action's state, stamped with the poll that saw it
+struct InputEdge {
+    double time;
+    uint8_t slot;
+    InputAction action;
+    bool pressed;      // false: released
 };
 
 class InputManager {
 public:
-    InputManager() = default;
+    static constexpr int EDGE_CAPACITY = 64;   // Edges kept for ticks that haven't run yet
+
+    InputManager();
     ~InputManager() = default;
 
+    // Polls the devices into the snapshot; once per frame, before any query
     void Update();
+    const InputSnapshot& GetSnapshot() const { return snapshot; }
 
     // Player 1 input (WASD or Gamepad 1)
     bool IsActionPressed(int playerID, InputAction action) const;
     bool IsActionDown(int playerID, InputAction action) const;
     bool IsActionReleased(int playerID, InputAction action) const;
     float GetAxisValue(int playerID, InputAction action) const;
+    // How far a held driving action goes, 0..1: the position of a gamepad
+    // stick or trigger past its deadzone, else all the way (keys, buttons)
+    float GetActionAmount(int playerID, InputAction action) const;
+
+    // Driving actions for one fixed-step tick: down now, or pressed at any
+    // point since this player's previous tick (so a tap that starts and
+    // ends between two ticks still reaches the simulation)
+    ActionBits TakeTickActions(int playerID);
+
+    // Edges taken by TakeTickActions are reported here, with the tick's time
+    void SetLatencyMonitor(InputLatencyMonitor* monitor) { latencyMonitor = monitor; }
+
+    // Scripted driving for unattended runs: player 1 holds the throttle and
+    // switches between left, straight and right at random intervals,
+    // instead of reading the keyboard or gamepad
+    void EnableSyntheticInput(uint32_t seed);
 
     // General input
     bool IsPausePressed() const;
@@ -43,22 +100,31 @@ public:
     bool IsMenuRightPressed() const;
 
 private:
-    // Helper functions
-    bool CheckKeyboardInput(int playerID, InputAction action, bool checkPressed) const;
-    bool CheckGamepadInput(int playerID, InputAction action, bool checkPressed) const;
-
-    // Keyboard mappings
-    struct KeyMapping {
-        KeyboardKey accelerate;
-        KeyboardKey brake;
-        KeyboardKey turnLeft;
-        KeyboardKey turnRight;
-        KeyboardKey nitro;
+    struct KeyBinding {
+        int slot;
+        InputAction action;
+        KeyboardKey key;
     };
 
-    // Keyboard mappings - Player 0 (human) uses arrow keys
-    KeyMapping player1Keys = {KEY_UP, KEY_DOWN, KEY_LEFT, KEY_RIGHT, KEY_LEFT_SHIFT};
-    KeyMapping player2Keys = {KEY_W, KEY_S, KEY_A, KEY_D, KEY_RIGHT_SHIFT};
+    void PollGamepad(int playerID, InputSnapshot& next) const;
+    void PollSynthetic(InputSnapshot& next);
+    int GetSlot(int playerID, InputAction action) const;
+    void PushEdge(double time, int slot, InputAction action, bool pressed);
+
+    static const KeyBinding KEY_BINDINGS[];
+
+    InputSnapshot snapshot;
+
+    // Ring of the newest edges; edgeCount only ever grows
+    std::array<InputEdge, EDGE_CAPACITY> edges;
+    uint64_t edgeCount;
+    std::array<uint64_t, Config::MAX_HUMAN_PLAYERS> tickEdgeMark;   // Edges each player's ticks have seen
+    InputLatencyMonitor* latencyMonitor;
+
+    bool synthetic;
+    std::mt19937 syntheticRng;
+    double syntheticNextChange;
+    int syntheticSteer;        // -1, 0 or 1
 };
 
 #endif // INPUTMANAGER_H
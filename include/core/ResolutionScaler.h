@@ -0,0 +1,42 @@
+#ifndef RESOLUTIONSCALER_H
+#define RESOLUTIONSCALER_H
+
+// Picks the 3D scene render scale that keeps frame time inside a budget.
+// Frame times are smoothed with an exponential moving average and the scale
+// only moves after the average has stayed outside a hysteresis band for a
+// number of frames, so a single hitch doesn't make the image pump.
+class ResolutionScaler {
+public:
+    ResolutionScaler();
+    ~ResolutionScaler() = default;
+
+    void Configure(float budgetMs, float minScale, float maxScale);
+    void SetEnabled(bool enabled);
+    bool IsEnabled() const { return enabled; }
+
+    // Feed the measured work time of the last frame. Returns true if the scale changed.
+    bool AddFrameSample(float frameTimeMs);
+
+    float GetScale() const { return scale; }
+    float GetBudgetMs() const { return budgetMs; }
+    float GetSmoothedFrameTimeMs() const { return smoothedMs; }
+
+    // Scaled size for a given native size, never smaller than 1 pixel
+    int GetScaledWidth(int nativeWidth) const;
+    int GetScaledHeight(int nativeHeight) const;
+
+private:
+    bool enabled;
+    float budgetMs;
+    float minScale;
+    float maxScale;
+    float scale;
+
+    float smoothedMs;
+    bool hasSample;
+    int framesOverBudget;
+    int framesUnderBudget;
+    int cooldownFrames;
+};
+
+#endif // RESOLUTIONSCALER_H
@@ -0,0 +1,56 @@
+#ifndef AIPARAMS_H
+#define AIPARAMS_H
+
+#include <array>
+#include <string>
+
+// The numbers behind Player::DriveAI, one set per difficulty. Built-in
+// defaults are overridden by Config::AI_PARAMS_FILE, which BikeRaceTuner
+// writes.
+struct AIParams {
+    static constexpr int DIFFICULTY_COUNT = 3;
+
+    float lookaheadBase;    // Metres ahead on the line to steer at...
+    float lookaheadTime;    // ...plus this many seconds of travel
+    float steerGain;        // Turn per radian off the target
+    float cornerSpeed;      // Share of the line's target speed
+    float nitroStraight;    // Metres of straight ahead before using nitro
+    float sideAvoid;        // Turn away from a side ray at full threat
+    float aheadAvoid;       // Turn off a blocked centre ray
+    float liftTime;         // Seconds to contact: off the throttle...
+    float brakeTime;        // ...and on the brakes
+
+    // difficulty: 1=Easy, 2=Medium, 3=Hard
+    static AIParams Defaults(int difficulty);
+
+    // Every field by name, with the range the tuner searches and loading
+    // clamps to
+    struct Field {
+        const char* name;
+        float AIParams::* member;
+        float min;
+        float max;
+    };
+    static constexpr int FIELD_COUNT = 9;
+    static const Field FIELDS[FIELD_COUNT];
+};
+
+using AIParamsTable = std::array<AIParams, AIParams::DIFFICULTY_COUNT>;
+
+namespace AIParamsFile {
+    AIParamsTable Defaults();
+    const char* GetSectionName(int difficulty);
+
+    // "[easy]" / "[medium]" / "[hard]" sections of "name = value" lines.
+    // Anything the file leaves out keeps the value already in the table.
+    bool Load(const std::string& path, AIParamsTable& table);
+    // The same from text already in memory; source names it in warnings
+    bool Parse(const std::string& text, const std::string& source, AIParamsTable& table);
+    // Config::AI_PARAMS_ASSET through the asset archive (what the game and
+    // server load at startup)
+    bool LoadAsset(AIParamsTable& table);
+    // comment lines are written at the top, each prefixed with "# "
+    bool Save(const std::string& path, const AIParamsTable& table, const std::string& comment);
+}
+
+#endif // AIPARAMS_H
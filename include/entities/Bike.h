@@ -6,6 +6,9 @@
 #include <cstdarg>
 #include <cstddef>
 #include "raylib.h"
+#include "render/AssetCache.h"
+
+class RenderQueue;
 
 struct BikeStats {
     float maxSpeed;
@@ -22,8 +25,17 @@ public:
     ~Bike();
 
     void Initialize(Vector3 startPosition, Color bikeColor);
+    // Stats of a bike with no upgrades
+    static BikeStats GetBaseStats();
     void Update(float deltaTime);
-    void Render() const;
+    void Render(RenderQueue& queue) const;
+
+    // Draws the bike shape at an arbitrary transform; alpha < 255 gives a
+    // translucent copy (used for the ghost racer)
+    static void RenderShape(RenderQueue& queue, Vector3 position, float rotation,
+                            Color color, unsigned char alpha = 255);
+    // One box the size of the bike, for bikes far from the camera
+    static void RenderLowDetail(RenderQueue& queue, Vector3 position, float rotation, Color color);
 
     // Movement
     void Accelerate(float amount);
@@ -39,10 +51,11 @@ public:
     Vector3 GetPosition() const { return position; }
     Vector3 GetVelocity() const { return velocity; }
     Vector3 GetDirection() const { return direction; }
+    float GetRotation() const { return rotation; }
     float GetSpeed() const; // Implemented in cpp
     float GetMaxSpeed() const { return stats.maxSpeed; }
     BikeStats GetStats() const { return stats; }
-    Model GetModel() const { return model; }
+    const Model* GetModel() const { return model.Get(); }   // nullptr when headless
     Color GetColor() const { return color; }
 
     // Setters
@@ -56,10 +69,28 @@ public:
     bool IsOnGround() const { return onGround; }
     void SetOnGround(bool grounded) { onGround = grounded; }
 
+    // Everything the simulation reads or writes, for snapshots
+    struct State {
+        Vector3 position;
+        Vector3 velocity;
+        Vector3 direction;
+        float rotation;
+        bool onGround;
+        Vector3 acceleration;
+        float turnInput;
+        BikeStats stats;
+        bool isBoosted;
+        float boostMultiplier;
+        float boostTimer;
+    };
+    void SaveState(State& state) const;
+    void LoadState(const State& state);
+
 private:
     void LoadModel();
     void UpdatePhysics(float deltaTime);
     void UpdateRotation(float deltaTime);
+    void ApplyTurn(float deltaTime);
 
     // Transform
     Vector3 position;
@@ -70,6 +101,7 @@ private:
     // Physics state
     bool onGround;
     Vector3 acceleration;
+    float turnInput; // Set by Turn(), applied in the next Update()
 
     // Stats
     BikeStats stats;
@@ -81,9 +113,8 @@ private:
     float boostTimer;
 
     // Visual
-    Model model;
+    ModelHandle model;   // Shared by every bike
     Color color;
-    bool modelLoaded;
 };
 
 #endif // BIKE_H
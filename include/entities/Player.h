@@ -2,15 +2,53 @@
 #define PLAYER_H
 
 #include "Bike.h"
+#include "AIParams.h"
+#include <cstdint>
 #include <string>
 #include <memory>
 
+class RacingLine;
+
 struct PlayerStats {
-    int totalRacesWon;
-    int totalRacesPlayed;
-    float bestLapTime;
-    int upgradesUnlocked;
-    int currentPoints;
+    int totalRacesWon = 0;
+    int totalRacesPlayed = 0;
+    float bestLapTime = 999999.0f;
+    int upgradesUnlocked = 0;
+    int currentPoints = 0;
+};
+
+// One tick of racer controls. Stored quantised so a live race and its
+// replay feed ProcessInput exactly the same values.
+struct RacerInput {
+    int8_t accelerate;   // 0..127 maps to 0..1
+    int8_t brake;        // 0..127 maps to 0..1
+    int8_t turn;         // -127..127 maps to -1..1
+    bool nitro;
+
+    static RacerInput FromAxes(float accel, float brake, float turn, bool nitro);
+
+    bool operator==(const RacerInput& other) const {
+        return accelerate == other.accelerate && brake == other.brake &&
+               turn == other.turn && nitro == other.nitro;
+    }
+    bool operator!=(const RacerInput& other) const { return !(*this == other); }
+};
+
+// What an AI racer's ray fan saw this tick (LevelManager::SenseAI). The
+// rays spread evenly over FAN_DEGREES around the heading, from the full
+// left-turn side to the full right-turn side. clearance is the free
+// distance as a share of RANGE; closingSpeed is how fast that gap shrinks.
+struct AISensors {
+    static constexpr int RAY_COUNT = 5;
+    static constexpr float FAN_DEGREES = 100.0f;
+    static constexpr float RANGE = 20.0f;
+
+    float clearance[RAY_COUNT];
+    float closingSpeed[RAY_COUNT];
+
+    // Degrees from the heading; negative is the left (turn < 0) side
+    static float RayAngle(int ray) { return (ray / (float)(RAY_COUNT - 1) - 0.5f) * FAN_DEGREES; }
+    static AISensors Clear();
 };
 
 class Player {
@@ -20,7 +58,7 @@ public:
 
     void Initialize(Vector3 startPosition, Color bikeColor);
     void Update(float deltaTime);
-    void Render() const;
+    void Render(RenderQueue& queue) const;
 
     // Race state
     void StartRace();
@@ -38,7 +76,9 @@ public:
     float GetBestLapTime() const { return stats.bestLapTime; }
     float GetTotalRaceTime() const { return totalRaceTime; }
     PlayerStats GetStats() const { return stats; }
+    void SetStats(const PlayerStats& newStats) { stats = newStats; }   // Career restored from a save
     int GetRacePosition() const { return racePosition; }
+    bool HasFinishedRace() const { return raceFinished; }
     int GetTotalPoints() const { return stats.currentPoints; }
 
     // Setters
@@ -48,12 +88,31 @@ public:
     void AddPoints(int points) { stats.currentPoints += points; }
 
 
+    // Race state and bike, for snapshots
+    struct State {
+        Bike::State bike;
+        int currentLap;
+        int checkpointsPassed;
+        float currentLapTime;
+        float totalRaceTime;
+        int racePosition;
+        bool raceFinished;
+        PlayerStats stats;
+        int lineSample;
+    };
+    void SaveState(State& state) const;
+    void LoadState(const State& state);
+
+    void ProcessInput(const RacerInput& input);
     void ProcessInput(float accel, float brake, float turn, bool nitro);
     
     // AI Control
     void SetAI(bool ai) { isAI = ai; }
     bool IsAI() const { return isAI; }
-    void UpdateAI(float deltaTime, const Vector3& nextCheckpointPos, int difficulty = 1); // difficulty: 1=Easy, 2=Medium, 3=Hard
+    // Follows the track's racing line: steers at a point ahead on it and
+    // holds its target speed, swerving and braking for what the sensors
+    // see. params are the difficulty's set.
+    RacerInput DriveAI(const RacingLine& line, const AIParams& params, const AISensors& sensors);
 
 private:
     int playerID;
@@ -68,6 +127,7 @@ private:
     float totalRaceTime;
     int racePosition;
     bool raceFinished;
+    int lineSample;   // Nearest racing line sample, tracked by DriveAI (-1: not yet found)
 
     // Statistics
     PlayerStats stats;
@@ -4,15 +4,18 @@
 #include "raylib.h"
 #include "raymath.h"
 
+class RenderQueue;
+
 class Checkpoint {
 public:
     Checkpoint(Vector3 position, float radius, int id);
     ~Checkpoint() = default;
 
     bool CheckPassage(Vector3 bikePosition, float bikeRadius) const;
-    void Render() const; // For debug visualization
+    void Render(RenderQueue& queue) const; // For debug visualization
 
     Vector3 GetPosition() const { return position; }
+    float GetRadius() const { return radius; }
     int GetID() const { return checkpointID; }
     void SetActive(bool active) { isActive = active; }
     bool IsActive() const { return isActive; }
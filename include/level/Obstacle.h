@@ -3,6 +3,9 @@
 
 #include "raylib.h"
 #include "raymath.h"
+#include "render/AssetCache.h"
+
+class RenderQueue;
 
 enum class ObstacleType {
     STATIC_BARRIER,
@@ -13,10 +16,9 @@ enum class ObstacleType {
 class Obstacle {
 public:
     Obstacle(Vector3 position, ObstacleType type, Vector3 size = {2.0f, 2.0f, 2.0f});
-    ~Obstacle();
 
     void Update(float deltaTime);
-    void Render() const;
+    void Render(RenderQueue& queue) const;
 
     // Collision
     bool CheckCollision(Vector3 bikePosition, float bikeRadius) const;
@@ -28,6 +30,14 @@ public:
     ObstacleType GetType() const { return type; }
     Vector3 GetPosition() const { return position; }
 
+    // Moving platforms are the only obstacles with simulation state
+    struct State {
+        Vector3 position;
+        float currentMoveOffset;
+    };
+    void SaveState(State& state) const;
+    void LoadState(const State& state);
+
 private:
     void LoadModel();
     void UpdateMoving(float deltaTime);
@@ -36,6 +46,7 @@ private:
     Vector3 size;
     ObstacleType type;
     BoundingBox boundingBox;
+    Color color;
 
     // For moving obstacles
     Vector3 moveDirection;
@@ -43,8 +54,7 @@ private:
     float moveDistance;
     float currentMoveOffset;
 
-    Model model;
-    bool modelLoaded;
+    ModelHandle model;   // Shared by obstacles of the same size
 };
 
 #endif // OBSTACLE_H
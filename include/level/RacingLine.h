@@ -0,0 +1,63 @@
+#ifndef RACINGLINE_H
+#define RACINGLINE_H
+
+#include "raylib.h"
+#include <vector>
+
+class Track;
+class RenderQueue;
+struct BikeStats;
+
+struct RacingLineSample {
+    Vector3 position;
+    float targetSpeed;     // Fastest speed that still makes the bends ahead
+    float straightAhead;   // Metres until the line next bends
+};
+
+// The line AI racers follow around a track, built once when the track
+// loads. The checkpoint centres are joined with a spline, relaxed towards
+// the straightest path that still passes every checkpoint and clears the
+// obstacles, and resampled every SAMPLE_SPACING metres. Each sample carries
+// a target speed from the bike's measured turning circle, with brake points
+// worked backwards from the bends. Following the line is then a few lookups per
+// tick: racers keep the index of their nearest sample and step it forward.
+class RacingLine {
+public:
+    static constexpr float SAMPLE_SPACING = 1.0f;
+
+    RacingLine();
+
+    void Build(const Track& track, const BikeStats& stats);
+    void Clear();
+
+    bool IsEmpty() const { return samples.empty(); }
+    bool IsClosed() const { return closed; }
+    int GetSampleCount() const { return (int)samples.size(); }
+    float GetLength() const { return samples.size() * SAMPLE_SPACING; }
+    // Tightest circle the bike the line was built for can turn at low speed
+    float GetTurnRadius() const { return turnRadius; }
+    int GetCheckpointSample(int checkpoint) const { return checkpointSamples[checkpoint]; }
+
+    // Wraps around closed lines and stops at the ends of open ones
+    int Advance(int index, int steps) const;
+    const RacingLineSample& GetSample(int index) const { return samples[Advance(index, 0)]; }
+    // Samples forward from one index to another (negative behind, on open lines)
+    int StepsBetween(int from, int to) const;
+
+    // Follows a racer along the line: steps a previous index forward while
+    // the next sample is closer, or searches the stretch leading to its
+    // next checkpoint when it has none or has wandered off the line
+    int Follow(int index, Vector3 position, int nextCheckpoint) const;
+
+    void RenderDebug(RenderQueue& queue) const;
+
+private:
+    int FindNearest(Vector3 position, int nextCheckpoint) const;
+
+    std::vector<RacingLineSample> samples;
+    std::vector<int> checkpointSamples;   // Sample nearest each checkpoint
+    bool closed;   // Laps join the finish back to the first checkpoint
+    float turnRadius;
+};
+
+#endif // RACINGLINE_H
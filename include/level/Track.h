@@ -4,10 +4,14 @@
 #include "raylib.h"
 #include "Checkpoint.h"
 #include "Obstacle.h"
+#include "RacingLine.h"
+#include "render/AssetCache.h"
 #include <vector>
 #include <string>
 #include <memory>
 
+class RenderQueue;
+
 struct TrackData {
     std::string name;
     int difficulty; // 1 = Beginner, 2 = Intermediate, 3 = Advanced, 4 = Expert
@@ -24,8 +28,8 @@ public:
 
     bool LoadTrack(const std::string& trackName);
     void Update(float deltaTime);
-    void Render() const;
-    void RenderDebug() const;
+    void Render(RenderQueue& queue) const;
+    void RenderDebug(RenderQueue& queue) const;
 
     // Checkpoint management
     bool CheckCheckpoint(int playerID, Vector3 bikePosition, int currentCheckpoint);
@@ -44,6 +48,9 @@ public:
     // Collections accessors
     const std::vector<std::unique_ptr<Checkpoint>>& GetCheckpoints() const { return checkpoints; }
     const std::vector<std::unique_ptr<Obstacle>>& GetObstacles() const { return obstacles; }
+    void AddObstacle(Vector3 position, ObstacleType type, Vector3 size);
+    // Built by LoadTrack; obstacles added later aren't avoided
+    const RacingLine& GetRacingLine() const { return racingLine; }
 
 private:
     void CreateBeginnerTrack();
@@ -52,11 +59,11 @@ private:
     void LoadTrackModel();
 
     TrackData trackData;
-    Model trackModel;
-    bool modelLoaded;
+    ModelHandle trackModel;
 
     std::vector<std::unique_ptr<Checkpoint>> checkpoints;
     std::vector<std::unique_ptr<Obstacle>> obstacles;
+    RacingLine racingLine;
 
     // Track mesh for collision
     BoundingBox trackBounds;
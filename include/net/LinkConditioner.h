@@ -0,0 +1,44 @@
+#ifndef LINKCONDITIONER_H
+#define LINKCONDITIONER_H
+
+#include "UdpSocket.h"
+#include <cstdint>
+#include <random>
+#include <vector>
+
+// Artificial network conditions, applied to outgoing packets
+struct LinkSettings {
+    float latencyMs;     // One-way delay
+    float jitterMs;      // Uniform extra delay in [0, jitter]; reorders packets
+    float lossPercent;
+};
+
+// Delays and drops packets on their way out of a socket, so rollback can be
+// exercised on a loopback interface. With default settings packets go
+// straight through.
+class LinkConditioner {
+public:
+    explicit LinkConditioner(uint32_t seed = 1);
+
+    void Configure(const LinkSettings& linkSettings);
+    const LinkSettings& GetSettings() const { return settings; }
+
+    void Send(UdpSocket& socket, const NetAddress& to, const uint8_t* data, size_t size, double now);
+    // Sends the queued packets whose delay has elapsed
+    void Flush(UdpSocket& socket, double now);
+
+private:
+    struct DelayedPacket {
+        double releaseTime;
+        NetAddress to;
+        size_t size;
+        uint8_t data[UdpSocket::MAX_PACKET_SIZE];
+    };
+
+    LinkSettings settings;
+    std::mt19937 rng;
+    std::vector<DelayedPacket> queue;   // Unordered; slots are reused
+    size_t queued;
+};
+
+#endif // LINKCONDITIONER_H
@@ -0,0 +1,12 @@
+#ifndef NETLOOPBACKTEST_H
+#define NETLOOPBACKTEST_H
+
+#include "LinkConditioner.h"
+
+// Runs a host and a client in one process over 127.0.0.1 with scripted
+// inputs and the given link conditions, on a simulated 60 Hz clock. Prints
+// one JSON line with rollback depth and re-simulation cost and returns
+// non-zero if the two races disagree on any confirmed tick.
+int RunNetLoopbackTest(const LinkSettings& link, int ticks);
+
+#endif // NETLOOPBACKTEST_H
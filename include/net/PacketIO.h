@@ -0,0 +1,70 @@
+#ifndef PACKETIO_H
+#define PACKETIO_H
+
+#include "../entities/Player.h"
+#include <cstdint>
+
+// Little-endian field helpers shared by the packet formats
+namespace PacketIO {
+    inline void WriteU16(uint8_t* out, uint16_t value) {
+        out[0] = (uint8_t)value;
+        out[1] = (uint8_t)(value >> 8);
+    }
+
+    inline uint16_t ReadU16(const uint8_t* in) {
+        return (uint16_t)(in[0] | (in[1] << 8));
+    }
+
+    inline void WriteU32(uint8_t* out, uint32_t value) {
+        for (int i = 0; i < 4; i++) out[i] = (uint8_t)(value >> (8 * i));
+    }
+
+    inline uint32_t ReadU32(const uint8_t* in) {
+        return (uint32_t)in[0] | ((uint32_t)in[1] << 8) | ((uint32_t)in[2] << 16) | ((uint32_t)in[3] << 24);
+    }
+
+    // Unsigned LEB128 varint; returns the bytes written (at most 5)
+    inline int WriteVarint(uint8_t* out, uint32_t value) {
+        int size = 0;
+        while (value >= 0x80) {
+            out[size++] = (uint8_t)(value | 0x80);
+            value >>= 7;
+        }
+        out[size++] = (uint8_t)value;
+        return size;
+    }
+
+    // Returns the bytes read, or 0 if the varint runs past end
+    inline int ReadVarint(const uint8_t* in, const uint8_t* end, uint32_t& value) {
+        value = 0;
+        for (int i = 0; i < 5 && in + i < end; i++) {
+            value |= (uint32_t)(in[i] & 0x7F) << (7 * i);
+            if (!(in[i] & 0x80)) return i + 1;
+        }
+        return 0;
+    }
+
+    // Maps small negative and positive deltas to small unsigned values
+    inline uint32_t ZigZag(int32_t value) {
+        return ((uint32_t)value << 1) ^ (uint32_t)(value >> 31);
+    }
+
+    inline int32_t UnZigZag(uint32_t value) {
+        return (int32_t)(value >> 1) ^ -(int32_t)(value & 1);
+    }
+
+    constexpr int INPUT_SIZE = 4;
+
+    inline void WriteInput(uint8_t* out, const RacerInput& input) {
+        out[0] = (uint8_t)input.accelerate;
+        out[1] = (uint8_t)input.brake;
+        out[2] = (uint8_t)input.turn;
+        out[3] = input.nitro ? 1 : 0;
+    }
+
+    inline RacerInput ReadInput(const uint8_t* in) {
+        return {(int8_t)in[0], (int8_t)in[1], (int8_t)in[2], in[3] != 0};
+    }
+}
+
+#endif // PACKETIO_H
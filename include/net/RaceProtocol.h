@@ -0,0 +1,70 @@
+#ifndef RACEPROTOCOL_H
+#define RACEPROTOCOL_H
+
+#include "UdpSocket.h"
+#include "raylib.h"
+#include <cstddef>
+#include <cstdint>
+
+// Packets between BikeRaceServer and its clients. The server is
+// authoritative: clients send controls, the server simulates and sends back
+// racer state as delta snapshots (see SnapshotCodec.h). Every packet starts
+// with MAGIC and a type byte.
+//
+//   JOIN     client -> server   (nothing else)
+//   WELCOME  server -> client   race u16, player u16, seed u32, track u8, racers u16
+//   FULL     server -> client   every slot is taken
+//   INPUT    client -> server   race u16, player u16, RacerInput (PacketIO),
+//                               newest complete snapshot u16
+//   STATE    server -> client   race u16, tick u32, raceState u8, snapshot u16,
+//                               baseline u16, fragment u8, fragments u8,
+//                               racers u16, then racer deltas
+//   LEAVE    client -> server   (nothing else)
+namespace RaceProtocol {
+    constexpr uint8_t MAGIC = 0xB9;
+
+    enum PacketType : uint8_t {
+        JOIN = 1,
+        WELCOME = 2,
+        FULL = 3,
+        INPUT = 4,
+        STATE = 5,
+        LEAVE = 6
+    };
+
+    constexpr size_t WELCOME_SIZE = 13;
+    constexpr size_t INPUT_SIZE = 12;
+    constexpr size_t STATE_HEADER_SIZE = 17;
+    constexpr uint16_t NO_SNAPSHOT = 0xFFFF;
+
+    // One racer as the simulation sees it
+    struct RacerRecord {
+        Vector3 position;
+        float rotation;   // Degrees
+        float speed;
+        int lap;
+        bool finished;
+    };
+
+    // The same racer as sent to clients: centimetres, 1/65536 turns, cm/s
+    struct QuantizedRacer {
+        int16_t x;
+        int16_t y;
+        int16_t z;
+        uint16_t yaw;
+        int16_t speed;
+        uint8_t lap;
+        uint8_t flags;
+
+        bool operator==(const QuantizedRacer& other) const {
+            return x == other.x && y == other.y && z == other.z && yaw == other.yaw &&
+                   speed == other.speed && lap == other.lap && flags == other.flags;
+        }
+        bool operator!=(const QuantizedRacer& other) const { return !(*this == other); }
+    };
+
+    QuantizedRacer Quantize(const RacerRecord& racer);
+    RacerRecord Dequantize(const QuantizedRacer& racer);
+}
+
+#endif // RACEPROTOCOL_H
@@ -0,0 +1,106 @@
+#ifndef ROLLBACKSESSION_H
+#define ROLLBACKSESSION_H
+
+#include "UdpSocket.h"
+#include "LinkConditioner.h"
+#include "../systems/LevelManager.h"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+// Per-frame rollback counters (reset by BeginFrame)
+struct RollbackStats {
+    int rollbacks;          // Times the race was rewound
+    int rollbackDepth;      // Deepest rewind, in ticks
+    int resimulatedTicks;
+    float resimMs;          // Time spent restoring and re-simulating
+    int ticksAhead;         // Simulated ticks still waiting for the peer's input
+    int stalls;             // Ticks held back because the peer fell too far behind
+};
+
+// Two-player online race with GGPO-style rollback. Both peers simulate the
+// whole race from the same seed; only per-tick RacerInputs cross the
+// network. Missing remote input is predicted (the last one received) and
+// when the real one differs the race is restored to that tick and
+// re-simulated. Every packet repeats all inputs the peer hasn't
+// acknowledged, so lost packets need no retransmit logic.
+class RollbackSession {
+public:
+    static constexpr int INPUT_DELAY = 2;        // Local input applies this many ticks later
+    static constexpr int MAX_PREDICTION = 8;     // Ticks we may run past the peer's input
+    static constexpr int HISTORY = 64;           // Ring size; covers prediction and early input
+
+    struct RaceSetup {
+        uint32_t seed;
+        int trackID;
+        int bikeIndex;
+    };
+
+    explicit RollbackSession(LevelManager& level);
+    ~RollbackSession();   // Hands human input back to the local devices
+
+    // The host is player 1 and picks the race; the client is player 2
+    bool Host(uint16_t port, const RaceSetup& setup);
+    bool Join(const NetAddress& hostAddress);
+    void SetLinkSettings(const LinkSettings& settings) { conditioner.Configure(settings); }
+
+    bool IsConnected() const { return connected; }
+    int GetLocalPlayer() const { return localPlayer; }
+    uint16_t GetLocalPort() const { return socket.GetLocalPort(); }
+    uint32_t GetCurrentTick() const { return currentTick; }
+    // True once the race has finished in a state both players' inputs are
+    // final for, so a finish that was only predicted can't end it
+    bool IsRaceOver() const;
+
+    // Call once per frame: reads incoming packets and releases delayed ones
+    void Poll(double now);
+    // Simulates the next tick. Returns false, without simulating, while
+    // the peer is more than MAX_PREDICTION ticks behind.
+    bool AdvanceTick(const RacerInput& localInput, double now);
+
+    void BeginFrame() { frameStats = {}; }
+    const RollbackStats& GetFrameStats() const { return frameStats; }
+
+    // Receives the state checksum of every tick once both inputs are final,
+    // in tick order, so two peers can be compared for desyncs
+    void SetChecksumLog(std::vector<uint64_t>* log) { checksumLog = log; }
+
+private:
+    void StartRace(const RaceSetup& raceSetup);
+    void HandlePacket(const uint8_t* data, int size, const NetAddress& from, double now);
+    void ReceiveInputs(const uint8_t* data, int size);
+    void SendInputs(double now);
+    void Rollback();
+    void SimulateTick(uint32_t tick);
+    void LogConfirmedChecksums();
+
+    LevelManager& level;
+    UdpSocket socket;
+    LinkConditioner conditioner;
+    NetAddress peer;
+    RaceSetup setup;
+    bool isHost;
+    bool connected;
+    int localPlayer;
+    double lastHelloTime;
+
+    uint32_t currentTick;       // Next tick to simulate
+    uint32_t localInputEnd;     // One past the newest local input
+    uint32_t localAcked;        // The peer has all our inputs below this
+    uint32_t remoteConfirmed;   // We have all the peer's inputs below this
+    uint32_t rollbackFrom;      // Earliest mispredicted tick, or NO_ROLLBACK
+    uint32_t checksummedUpTo;
+    RacerInput lastRemoteInput; // Prediction for unconfirmed ticks
+
+    std::array<RacerInput, HISTORY> localInputs;
+    std::array<RacerInput, HISTORY> remoteInputs;
+    std::array<uint32_t, HISTORY> remoteInputTicks;   // Which tick each remote slot holds
+    std::array<RacerInput, HISTORY> usedRemoteInputs; // What each simulated tick assumed
+    std::array<RaceSnapshot, HISTORY> snapshots;      // State before each tick
+    std::array<uint64_t, HISTORY> checksums;          // State after each tick
+
+    RollbackStats frameStats;
+    std::vector<uint64_t>* checksumLog;
+};
+
+#endif // ROLLBACKSESSION_H
@@ -0,0 +1,113 @@
+#ifndef SNAPSHOTCODEC_H
+#define SNAPSHOTCODEC_H
+
+#include "RaceProtocol.h"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+// Header fields shared by every fragment of one snapshot
+struct SnapshotInfo {
+    uint16_t raceID;
+    uint32_t tick;
+    uint8_t raceState;
+};
+
+// Server side, one per client. Each snapshot is a delta against the newest
+// one the client acknowledged, or against zero when none is held any more:
+// unchanged racers cost nothing and changed ones send only the fields that
+// moved, as zigzag varints. With interest management on, racers far from
+// the client's own bike (relative to the lap length) are refreshed only
+// every few snapshots; in between the client keeps the value it last
+// acknowledged for them, and only racers it has never acknowledged are
+// sent regardless.
+class SnapshotEncoder {
+public:
+    static constexpr int HISTORY = 16;         // Snapshots kept as possible baselines
+    static constexpr int MAX_FRAGMENTS = 32;
+
+    SnapshotEncoder();
+
+    void SetInterestEnabled(bool enabled) { interestEnabled = enabled; }
+    // Distance bands are fractions of the lap (racing line) length
+    void SetTrackLength(float meters) { trackLength = meters; }
+    // Forgets every baseline; the next snapshot is sent whole
+    void Reset();
+    void Acknowledge(uint16_t sequence);
+
+    // Encodes the next snapshot as STATE packets and returns how many.
+    // viewer is the client's own racer, or -1 for a spectator, who gets
+    // everyone at full rate.
+    int Encode(const SnapshotInfo& info, const RaceProtocol::QuantizedRacer* racers, int racerCount, int viewer);
+    const uint8_t* GetPacket(int fragment) const { return packets[fragment].data; }
+    size_t GetPacketSize(int fragment) const { return packets[fragment].size; }
+    // Each racer as the client shows it once the last snapshot arrives
+    const std::vector<RaceProtocol::QuantizedRacer>& GetClientView() const { return history[lastSequence % HISTORY].racers; }
+
+private:
+    struct Snapshot {
+        uint16_t sequence;
+        bool valid;
+        std::vector<RaceProtocol::QuantizedRacer> racers;
+        std::vector<uint8_t> known;   // Per racer: holds a value actually sent
+    };
+
+    struct Packet {
+        uint8_t data[UdpSocket::MAX_PACKET_SIZE];
+        size_t size;
+    };
+
+    int RefreshInterval(const RaceProtocol::QuantizedRacer& racer, const RaceProtocol::QuantizedRacer& viewer) const;
+
+    std::array<Snapshot, HISTORY> history;
+    std::array<Packet, MAX_FRAGMENTS> packets;
+    uint16_t nextSequence;
+    uint16_t lastSequence;     // Of the newest snapshot encoded
+    uint16_t ackedSequence;    // NO_SNAPSHOT until the client acknowledges one
+    uint32_t encodeCount;
+    bool interestEnabled;
+    float trackLength;
+};
+
+// Client side: rebuilds snapshots from STATE fragments, in any order. A
+// snapshot completes once all its fragments arrived and its baseline was
+// still held; anything older than the newest complete one is ignored.
+class SnapshotDecoder {
+public:
+    static constexpr int HISTORY = SnapshotEncoder::HISTORY;
+
+    SnapshotDecoder();
+
+    // Returns true when this packet completed a snapshot
+    bool Decode(const uint8_t* data, size_t size);
+
+    bool HasSnapshot() const { return latest >= 0; }
+    // Echoed in every INPUT so the server can delta against it
+    uint16_t GetAckSequence() const;
+    const SnapshotInfo& GetInfo() const { return info; }
+    const std::vector<RaceProtocol::QuantizedRacer>& GetRacers() const { return history[latest].racers; }
+    uint64_t GetUndecodable() const { return undecodable; }
+
+private:
+    struct Snapshot {
+        uint16_t sequence;
+        bool valid;
+        std::vector<RaceProtocol::QuantizedRacer> racers;
+    };
+
+    bool StartPending(uint16_t sequence, uint16_t baseline, int racerCount, int fragmentCount);
+    bool ApplyFragment(const uint8_t* data, const uint8_t* end);
+
+    std::array<Snapshot, HISTORY> history;
+    Snapshot pending;
+    bool pendingActive;
+    uint32_t pendingFragments;   // Bit per fragment received
+    int pendingFragmentCount;
+    SnapshotInfo pendingInfo;
+
+    int latest;                  // History slot of the newest complete snapshot
+    SnapshotInfo info;
+    uint64_t undecodable;        // Fragments whose baseline was gone
+};
+
+#endif // SNAPSHOTCODEC_H
@@ -0,0 +1,48 @@
+#ifndef UDPSOCKET_H
+#define UDPSOCKET_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// IPv4 address and port, host byte order
+struct NetAddress {
+    uint32_t ip;
+    uint16_t port;
+
+    // "a.b.c.d:port" (or "localhost:port")
+    static bool Parse(const std::string& text, NetAddress& address);
+    std::string ToString() const;
+
+    bool operator==(const NetAddress& other) const { return ip == other.ip && port == other.port; }
+    bool operator!=(const NetAddress& other) const { return !(*this == other); }
+};
+
+// Non-blocking IPv4 UDP socket. Send may be called from several threads at
+// once (the dedicated server's race workers share one socket).
+class UdpSocket {
+public:
+    static constexpr size_t MAX_PACKET_SIZE = 1200;   // Stays under typical MTUs
+
+    UdpSocket();
+    ~UdpSocket();
+
+    // Binds all interfaces; port 0 picks a free one
+    bool Open(uint16_t port);
+    void Close();
+    bool IsOpen() const;
+
+    bool Send(const NetAddress& to, const uint8_t* data, size_t size);
+    // Returns the packet size, or -1 when nothing is waiting
+    int Receive(NetAddress& from, uint8_t* buffer, size_t capacity);
+
+    uint16_t GetLocalPort() const;
+
+private:
+    UdpSocket(const UdpSocket&) = delete;
+    UdpSocket& operator=(const UdpSocket&) = delete;
+
+    intptr_t handle;
+};
+
+#endif // UDPSOCKET_H
@@ -0,0 +1,63 @@
+#ifndef SPATIALGRID_H
+#define SPATIALGRID_H
+
+#include "raylib.h"
+#include <vector>
+
+// One ray of a batched cast, on the ground plane (x, z)
+struct SensorRay {
+    Vector2 origin;
+    Vector2 direction;   // Unit length
+    float length;
+    int ignoreOwner;     // Circles with this owner are skipped (the caster)
+};
+
+struct SensorHit {
+    float distance;      // The ray's length when nothing was hit
+    int owner;           // Owner of the circle hit, or -1
+};
+
+// Circles on the ground plane bucketed into a uniform grid, for casting
+// many short rays at once. Each ray only visits the cells it crosses, so
+// its cost depends on what's nearby rather than on how many circles there
+// are. Rebuilding reuses the arrays; after the first build of a given size
+// it doesn't allocate.
+class SpatialGrid {
+public:
+    SpatialGrid(float cellSize, float halfExtent);
+
+    void Clear();
+    // Owner is returned in hits; circles are inserted into every cell they
+    // overlap. Call Build after the last Add.
+    void Add(Vector2 centre, float radius, int owner);
+    void Build();
+
+    int GetCircleCount() const { return (int)circles.size(); }
+
+    // Nearest hit along each ray; a ray starting inside a circle hits at 0
+    void CastRays(const SensorRay* rays, int count, SensorHit* hits) const;
+    // Owners of every circle overlapping the query circle, ascending and
+    // each once. Replaces the contents of owners.
+    void Query(Vector2 centre, float radius, std::vector<int>& owners) const;
+
+private:
+    struct Circle {
+        Vector2 centre;
+        float radius;
+        int owner;
+    };
+
+    int CellCoord(float value) const;
+    float CastRay(const SensorRay& ray, int& owner) const;
+
+    float cellSize;
+    float halfExtent;
+    int cellsPerSide;
+
+    std::vector<Circle> circles;
+    std::vector<int> cellStart;     // Per cell, offset into cellItems (CSR)
+    std::vector<int> cellItems;     // Circle indices, grouped by cell
+    std::vector<int> cellFill;      // Scratch for Build
+};
+
+#endif // SPATIALGRID_H
@@ -0,0 +1,92 @@
+#ifndef ASSETCACHE_H
+#define ASSETCACHE_H
+
+#include "raylib.h"
+#include <cstddef>
+#include <map>
+#include <string>
+#include <utility>
+
+class AssetCache;
+
+// One cached model and who is using it
+struct CachedModel {
+    Model model;
+    bool loaded;        // False once UnloadAll has released it
+    int refCount;
+    int reuses;         // Times handed out again after the first load
+    size_t cpuBytes;    // Mesh arrays and model structs kept in RAM
+    size_t gpuBytes;    // Vertex and index buffers uploaded
+};
+
+// Shared reference to a cached model. Copies add a reference; the model
+// stays cached at zero references until AssetCache::Collect. Empty in
+// headless runs (no GPU context).
+class ModelHandle {
+public:
+    ModelHandle() : entry(nullptr) {}
+    ModelHandle(const ModelHandle& other) : entry(other.entry) { Retain(); }
+    ModelHandle(ModelHandle&& other) noexcept : entry(other.entry) { other.entry = nullptr; }
+    ModelHandle& operator=(ModelHandle other) {
+        std::swap(entry, other.entry);
+        return *this;
+    }
+    ~ModelHandle() { Release(); }
+
+    const Model* Get() const { return (entry && entry->loaded) ? &entry->model : nullptr; }
+    explicit operator bool() const { return Get() != nullptr; }
+
+private:
+    friend class AssetCache;
+    explicit ModelHandle(CachedModel* entry) : entry(entry) { Retain(); }
+    void Retain() { if (entry) entry->refCount++; }
+    void Release() { if (entry) entry->refCount--; entry = nullptr; }
+
+    CachedModel* entry;
+};
+
+// Models keyed by their content: a generated mesh's shape and parameters,
+// or a file path. Identical requests share one upload, so reloading a
+// level reuses what the last one left instead of generating it again.
+// Main thread only (GPU resources). Without a GPU context (headless, where
+// the server and tuner load levels on worker threads) it hands out empty
+// handles without touching the cache, and Collect does nothing.
+class AssetCache {
+public:
+    static AssetCache& GetInstance() {
+        static AssetCache instance;
+        return instance;
+    }
+
+    // Generated meshes have a white material; tint them when drawing
+    ModelHandle GetCube(Vector3 size);
+    ModelHandle GetPlane(float width, float length, int resX, int resZ);
+    ModelHandle GetModelFile(const std::string& path);
+
+    // Unloads models no handle refers to
+    void Collect();
+    // Unloads everything, before the window closes; outstanding handles
+    // become empty
+    void UnloadAll();
+
+    int GetModelCount() const { return (int)models.size(); }
+    size_t GetCpuBytes() const;
+    size_t GetGpuBytes() const;
+    // One log line per model: key, references, reuses and memory
+    void LogReport() const;
+
+private:
+    AssetCache() = default;
+    ~AssetCache() = default;
+    AssetCache(const AssetCache&) = delete;
+    AssetCache& operator=(const AssetCache&) = delete;
+
+    // Looks the key up; on a miss, generates with make (skipped without a
+    // GPU context) and measures the result
+    template <typename MakeModel>
+    ModelHandle Acquire(const std::string& key, MakeModel make);
+
+    std::map<std::string, CachedModel> models;   // Node-based: entries never move
+};
+
+#endif // ASSETCACHE_H
@@ -0,0 +1,50 @@
+#ifndef RENDERBACKEND_H
+#define RENDERBACKEND_H
+
+#include "raylib.h"
+#include "RenderQueue.h"
+
+// Executes the sorted commands of a RenderQueue
+class RenderBackend {
+public:
+    virtual ~RenderBackend() = default;
+
+    virtual void BeginScene(const Camera3D& camera) = 0;
+    virtual void Execute(const RenderCommand& command) = 0;
+    virtual void EndScene() = 0;
+};
+
+// Draws through raylib's immediate mode API
+class RaylibRenderBackend : public RenderBackend {
+public:
+    void BeginScene(const Camera3D& camera) override;
+    void Execute(const RenderCommand& command) override;
+    void EndScene() override;
+};
+
+// Never touches the GPU: counts draws and validates their parameters, so
+// submission can be measured on machines without a display
+class NullRenderBackend : public RenderBackend {
+public:
+    NullRenderBackend();
+
+    void BeginScene(const Camera3D& camera) override;
+    void Execute(const RenderCommand& command) override;
+    void EndScene() override;
+
+    void ResetCounters();
+    int GetSceneCount() const { return sceneCount; }
+    int GetDrawCount() const { return drawCount; }
+    int GetInvalidCount() const { return invalidCount; }
+    bool IsSceneOpen() const { return sceneOpen; }
+
+private:
+    static bool IsValid(const RenderCommand& command);
+
+    int sceneCount;
+    int drawCount;
+    int invalidCount;
+    bool sceneOpen;
+};
+
+#endif // RENDERBACKEND_H
@@ -0,0 +1,97 @@
+#ifndef RENDERQUEUE_H
+#define RENDERQUEUE_H
+
+#include "raylib.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class RenderBackend;
+
+enum class RenderPrimitive : uint8_t {
+    CUBE,
+    CUBE_WIRES,
+    CYLINDER,
+    CYLINDER_WIRES,
+    SPHERE,
+    PLANE,
+    LINE,
+    RING,          // Flat circle lying in the XZ plane
+    BOUNDING_BOX,
+    MODEL,
+    GRID
+};
+
+// One recorded draw. Shapes are described in a local frame given by
+// position + yaw (degrees around Y), so Bike can keep its part offsets.
+struct RenderCommand {
+    RenderPrimitive primitive;
+    Color color;
+    Vector3 position;
+    float yaw;
+    Vector3 offset;   // Local-space centre (LINE: start, BOUNDING_BOX: min)
+    Vector3 size;     // CUBE: w/h/l, CYLINDER: top radius/bottom radius/height,
+                      // SPHERE/RING: x = radius, PLANE: x/z, LINE: end,
+                      // BOUNDING_BOX: max, MODEL: x = scale, GRID: x = spacing
+    int slices;       // CYLINDER / GRID
+    const Model* model;
+    uint64_t sortKey;
+};
+
+// Per-flush counters, filled for every backend
+struct RenderStats {
+    int drawCalls;
+    int stateChanges;   // Primitive, mesh or colour differs from the previous draw
+    int triangles;      // Estimated from the shape tessellation raylib uses
+    float submitMicros; // CPU time spent sorting and executing the queue
+};
+
+// Records 3D draws for one frame, sorts them and hands them to a backend.
+// Opaque draws are grouped by primitive, mesh and colour and then ordered
+// front-to-back; translucent draws go last, back-to-front.
+class RenderQueue {
+public:
+    RenderQueue();
+    ~RenderQueue() = default;
+
+    void Begin(const Camera3D& camera);
+    void Flush(RenderBackend& backend);
+
+    // Local frame for the following shape draws
+    void SetTransform(Vector3 position, float yaw);
+    void ResetTransform();
+
+    // Shape draws (offsets are in the current local frame)
+    void DrawCube(Vector3 offset, float width, float height, float length, Color color);
+    void DrawCubeWires(Vector3 offset, float width, float height, float length, Color color);
+    void DrawCylinder(Vector3 offset, float radiusTop, float radiusBottom, float height, int slices, Color color);
+    void DrawCylinderWires(Vector3 offset, float radiusTop, float radiusBottom, float height, int slices, Color color);
+    void DrawSphere(Vector3 offset, float radius, Color color);
+    void DrawPlane(Vector3 offset, Vector2 size, Color color);
+    void DrawLine(Vector3 start, Vector3 end, Color color);
+    void DrawRing(Vector3 offset, float radius, Color color);
+    void DrawBoundingBox(BoundingBox box, Color color);
+
+    // World-space draws
+    void DrawModel(const Model& model, Vector3 position, float scale, Color tint);
+    void DrawGrid(int slices, float spacing);
+
+    const Camera3D& GetCamera() const { return camera; }
+    size_t GetCommandCount() const { return commands.size(); }
+    const RenderStats& GetLastStats() const { return lastStats; }
+
+    static int EstimateTriangles(const RenderCommand& command);
+
+private:
+    RenderCommand& Push(RenderPrimitive primitive, Color color);
+    void Sort();
+    uint64_t MakeSortKey(const RenderCommand& command) const;
+
+    std::vector<RenderCommand> commands;
+    Camera3D camera;
+    Vector3 currentPosition;
+    float currentYaw;
+    RenderStats lastStats;
+};
+
+#endif // RENDERQUEUE_H
@@ -2,15 +2,39 @@
 #define AUDIOMANAGER_H
 
 #include "raylib.h"
+#include "systems/EngineSynth.h"
+#include <array>
 #include <string>
 #include <map>
+#include <vector>
+
+class ThreadPool;
+
+// Index of a loaded sound effect; names are looked up once, at load time
+using SoundHandle = int;
+constexpr SoundHandle INVALID_SOUND = -1;
+
+// Sound effect requests in one frame
+struct SoundFrameStats {
+    int started;   // Got a voice (including stolen ones)
+    int stolen;    // Cut off a quieter or lower-priority sound to play
+    int culled;    // Too quiet to hear, or lost to everything playing
+    int active;    // Voices playing at the end of the frame
+};
 
 class AudioManager {
 public:
+    static constexpr int VOICE_COUNT = 16;   // Sound effects playing at once
+
     AudioManager();
     ~AudioManager();
 
-    void Initialize();
+    // Sound effects are read through the asset archive, on the pool if given
+    void Initialize(ThreadPool* loadPool = nullptr);
+    // Stops everything and releases sounds and music; before the audio
+    // device closes
+    void Shutdown();
+    // Streams music and closes the frame's sound stats; once per frame
     void Update(float deltaTime);
 
     // Music
@@ -19,22 +43,53 @@ public:
     void SetMusicVolume(float volume);
 
     // Sound effects
-    void PlaySound(const std::string& soundName);
+    SoundHandle FindSound(const std::string& name) const;   // INVALID_SOUND if not loaded
+    // At a world position, attenuated and panned relative to the listener.
+    // When every voice is busy, the new sound takes the voice of the least
+    // important one (lowest priority, then quietest) if it outranks it.
+    void PlaySound(SoundHandle sound, Vector3 position, int priority = 0, float volume = 1.0f);
+    // At the listener (UI sounds)
+    void PlaySound(SoundHandle sound, int priority = 0, float volume = 1.0f);
     void SetSoundVolume(float volume);
 
+    // Where sounds are heard from; right is the listener's unit right vector
+    void SetListener(Vector3 position, Vector3 right);
+    // The last frame closed by Update
+    const SoundFrameStats& GetFrameStats() const { return lastFrameStats; }
+
+    // Bike engines; started by Initialize when the audio device is up
+    EngineSynth& GetEngineSynth() { return engineSynth; }
+
 private:
-    void LoadAudio();
+    struct Voice {
+        Sound alias;          // Shares the sample data of sounds[sound]
+        SoundHandle sound;    // INVALID_SOUND until first used
+        int priority;
+        float audibility;     // Level it was started at
+    };
+
+    void LoadAudio(ThreadPool* loadPool);
     void LoadMusic(const std::string& name, const std::string& filepath);
-    void LoadSound(const std::string& name, const std::string& filepath);
+    void LoadSound(const std::string& name, const std::string& assetName, const std::vector<unsigned char>& file);
+    void StartVoice(Voice& voice, SoundHandle sound, int priority, float audibility, float pan);
 
     std::map<std::string, Music> musicTracks;
-    std::map<std::string, Sound> soundEffects;
+    std::map<std::string, SoundHandle> soundNames;
+    std::vector<Sound> sounds;
+
+    std::array<Voice, VOICE_COUNT> voices;
+    Vector3 listenerPosition;
+    Vector3 listenerRight;
+    SoundFrameStats frameStats;
+    SoundFrameStats lastFrameStats;
 
     Music currentMusic;
     bool musicPlaying;
     float masterVolume;
     float musicVolume;
     float soundVolume;
+
+    EngineSynth engineSynth;
 };
 
 #endif // AUDIOMANAGER_H
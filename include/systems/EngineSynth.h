@@ -0,0 +1,80 @@
+#ifndef ENGINESYNTH_H
+#define ENGINESYNTH_H
+
+#include "raylib.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+// Engine sound synthesized on the audio thread for the bikes nearest the
+// listener. The simulation publishes a few floats per voice each tick; the
+// audio callback reads them through atomics and never allocates or locks.
+class EngineSynth {
+public:
+    static constexpr int VOICE_COUNT = 8;
+    static constexpr int SAMPLE_RATE = 44100;
+    static constexpr float IDLE_RPM = 1500.0f;
+    static constexpr float REDLINE_RPM = 11000.0f;
+
+    struct VoiceParams {
+        float rpm;
+        float load;    // 0 coasting .. 1 full throttle
+        float gain;    // 0 silent
+        float pan;     // -1 left .. 1 right
+    };
+
+    EngineSynth();
+    ~EngineSynth();
+
+    // Opens the stream on the audio device (which must be initialized);
+    // only one synth can be playing at a time
+    bool Start();
+    void Stop();
+    bool IsRunning() const { return running; }
+
+    // Simulation thread: per tick, one call per voice in use, then
+    // SilenceFrom for the rest
+    void SetVoice(int voice, const VoiceParams& params);
+    void SilenceFrom(int voice);
+    void SetVolume(float volume);
+
+    // Fills frames of interleaved stereo floats. Called on the audio
+    // thread while running; benchmarks call it directly.
+    void Render(float* output, unsigned int frames);
+
+    // Engine speed for a road speed: the rev range is swept once per gear
+    static float RpmFromSpeed(float speed, float maxSpeed);
+
+private:
+    static void AudioCallback(void* buffer, unsigned int frames);
+
+    // Written by the simulation, read by the audio thread
+    struct SharedVoice {
+        std::atomic<float> rpm;
+        std::atomic<float> load;
+        std::atomic<float> gain;
+        std::atomic<float> pan;
+    };
+
+    // Audio thread only; values reached at the end of the last buffer
+    struct VoiceState {
+        float rpm;
+        float load;
+        float gain;
+        float pan;
+        float phase;
+        float filtered;
+        uint32_t noise;
+    };
+
+    std::array<SharedVoice, VOICE_COUNT> shared;
+    std::array<VoiceState, VOICE_COUNT> voices;
+    std::atomic<float> volume;
+
+    AudioStream stream;
+    bool running;
+
+    static std::atomic<EngineSynth*> active;   // raylib callbacks take no user pointer
+};
+
+#endif // ENGINESYNTH_H
@@ -0,0 +1,72 @@
+#ifndef GHOST_H
+#define GHOST_H
+
+#include "raylib.h"
+#include "../utils/MappedFile.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// On-disk layout of a best-lap file: this header followed by sampleCount
+// fixed-size samples, so any sample can be read straight from the mapping.
+// Sample i is taken i * sampleInterval seconds into the lap, except the
+// last one, which is the finish line at lapTime.
+struct GhostFileHeader {
+    char magic[4];
+    uint32_t version;
+    float lapTime;
+    float sampleInterval;
+    uint32_t sampleCount;
+};
+
+// Position in centimetres (+/-327 m covers every track), yaw in 1/65536 turns
+struct GhostSample {
+    int16_t x;
+    int16_t y;
+    int16_t z;
+    uint16_t yaw;
+};
+
+// Captures one lap of a bike's transform, every few simulation ticks
+class GhostRecorder {
+public:
+    GhostRecorder();
+
+    void BeginLap(Vector3 position, float yaw);
+    void Tick(Vector3 position, float yaw);   // Once per simulation tick
+    void EndLap(Vector3 position, float yaw);
+
+    bool IsRecording() const { return recording; }
+
+    // Writes the finished lap; the old file is only replaced once the new
+    // one is complete
+    bool Save(const std::string& path, float lapTime) const;
+
+private:
+    std::vector<GhostSample> samples;
+    int ticksInLap;
+    bool recording;
+};
+
+// A saved best lap, mapped read-only and sampled on demand
+class GhostTrack {
+public:
+    GhostTrack();
+
+    bool Load(const std::string& path);
+    void Unload();
+
+    bool IsLoaded() const { return file.IsOpen(); }
+    float GetLapTime() const { return header.lapTime; }
+
+    // Interpolated transform at the given time into the lap; false outside it
+    bool Sample(float lapTime, Vector3& position, float& yaw) const;
+
+private:
+    GhostSample ReadSample(uint32_t index) const;
+
+    MappedFile file;
+    GhostFileHeader header;
+};
+
+#endif // GHOST_H
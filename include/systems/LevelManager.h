@@ -3,9 +3,27 @@
 
 #include "../level/Track.h"
 #include "../entities/Player.h"
+#include "Ghost.h"
+#include "SaveGame.h"
+#include "../physics/SpatialGrid.h"
+#include <cstdint>
 #include <memory>
+#include <random>
 #include <vector>
 
+class RenderQueue;
+class PhysicsEngine;
+class InputManager;
+class ReplayWriter;
+class ReplayReader;
+class EngineSynth;
+
+// A bike hitting another bike or an obstacle, for sound effects
+struct ImpactEvent {
+    Vector3 position;
+    float speed;       // Closing speed, m/s
+};
+
 enum class RaceState {
     NOT_STARTED,
     COUNTDOWN,
@@ -13,16 +31,69 @@ enum class RaceState {
     FINISHED
 };
 
+// Everything a race tick changes, in one flat buffer: a header, then every
+// racer's State, then every obstacle's State. The buffer is sized on first
+// use for a level; after that saving and restoring are plain copies with no
+// allocation. Restoring on the same level rewinds the race exactly, and
+// copying one snapshot into another forks the race.
+class RaceSnapshot {
+public:
+    struct Header {
+        RaceState raceState;
+        float countdownTimer;
+        float raceTime;
+        uint32_t raceTick;
+        uint32_t playerCount;
+        uint32_t obstacleCount;
+    };
+
+    // Sizes the buffer; allocates only when it has to grow
+    void Reserve(size_t playerCount, size_t obstacleCount);
+    bool IsEmpty() const { return buffer.empty(); }
+    size_t GetSize() const { return buffer.size(); }
+
+    Header& GetHeader() { return *reinterpret_cast<Header*>(buffer.data()); }
+    const Header& GetHeader() const { return *reinterpret_cast<const Header*>(buffer.data()); }
+    Player::State* GetPlayers() { return reinterpret_cast<Player::State*>(buffer.data() + PLAYERS_OFFSET); }
+    const Player::State* GetPlayers() const { return reinterpret_cast<const Player::State*>(buffer.data() + PLAYERS_OFFSET); }
+    Obstacle::State* GetObstacles() { return reinterpret_cast<Obstacle::State*>(buffer.data() + ObstaclesOffset()); }
+    const Obstacle::State* GetObstacles() const { return reinterpret_cast<const Obstacle::State*>(buffer.data() + ObstaclesOffset()); }
+
+private:
+    static constexpr size_t AlignUp(size_t offset, size_t alignment) {
+        return (offset + alignment - 1) / alignment * alignment;
+    }
+    static constexpr size_t PLAYERS_OFFSET =
+        (sizeof(Header) + alignof(Player::State) - 1) / alignof(Player::State) * alignof(Player::State);
+    size_t ObstaclesOffset() const {
+        return AlignUp(PLAYERS_OFFSET + GetHeader().playerCount * sizeof(Player::State), alignof(Obstacle::State));
+    }
+
+    std::vector<unsigned char> buffer;
+};
+
 class LevelManager {
 public:
     LevelManager();
-    ~LevelManager() = default;
+    ~LevelManager(); // Defined in .cpp for the incomplete ReplayWriter
 
-    void Initialize();
+    // The level manager doesn't own these; the engine (or a benchmark) does
+    void Initialize(PhysicsEngine* physics, InputManager* input);
     // Level management
     void LoadLevel(int levelID, int playerBikeIndex = 0); // playerBikeIndex: 0=red, 1=blue
     void Update(float deltaTime);
-    void Render() const;
+    void Render(RenderQueue& queue) const;
+    Camera3D GetCamera() const;
+    // Impacts from the ticks since the last ClearImpacts; at most
+    // IMPACT_CAPACITY are kept, later ones are dropped
+    static constexpr int IMPACT_CAPACITY = 64;
+    const std::vector<ImpactEvent>& GetImpacts() const { return impacts; }
+    void ClearImpacts() { impacts.clear(); }
+    // Re-simulated ticks (rollback) were already heard when first run
+    void SetImpactsMuted(bool muted) { impactsMuted = muted; }
+    // Engine speed, throttle, level and pan of the bikes nearest the
+    // camera, for the audio thread; call once per frame after the ticks
+    void PublishEngineAudio(EngineSynth& synth) const;
 
     // Race management
     void StartRace();
@@ -33,7 +104,15 @@ public:
 
     // Player management
     void AddPlayer(int playerID, const std::string& name);
+    // Adds CPU racers or drops the last ones (up to Config::MAX_RACERS);
+    // the grid is laid out for the new count by the next LoadLevel
+    void SetRacerCount(int count);
     Player* GetPlayer(int playerID) const;
+    // Players below this index are human, the rest AI (applied by LoadLevel)
+    void SetHumanPlayerCount(int count) { humanPlayerCount = count; }
+    void SetViewPlayer(int playerID) { viewPlayer = playerID; }
+
+    int GetPlayerCount() const { return (int)players.size(); }
     int GetWinner() const;
 
     // Race state
@@ -45,11 +124,66 @@ public:
     void UnlockLevel(int levelID);
     bool IsLevelUnlocked(int levelID) const;
 
-private:
-    void UpdateRaceProgress(float deltaTime);
+    // What the save keeps: player 1's stats as of their last finished
+    // offline race, their best lap per track and the unlocked levels.
+    // Online races change none of it. Stats set here are given to player 1
+    // by the next LoadLevel.
+    PlayerProgress GetProgress() const;
+    void SetProgress(const PlayerProgress& progress);
+    // AI racers drive with the set for the level's difficulty (built-in
+    // defaults until set)
+    void SetAIParams(const AIParamsTable& params) { aiParams = params; }
+    const AIParamsTable& GetAIParams() const { return aiParams; }
+
+    // Fixes the starting grid seed for every following race (a fresh
+    // random seed per race by default)
+    void SetSeed(uint32_t seed);
+    void ClearSeed() { fixedSeed = false; }
+    uint32_t GetRaceSeed() const { return raceSeed; }
+
+    // Replays: when recording, every race's inputs are captured from
+    // StartRace to EndRace. A replay source replaces AI and human input.
+    void SetReplayRecording(bool enabled);
+    bool SaveReplay(const std::string& path) const;
+    void SetReplaySource(ReplayReader* reader) { replaySource = reader; }
+
+    // Ghost racer: player 1's best lap per track is saved and replayed as a
+    // translucent bike during later laps
+    void SetGhostsEnabled(bool enabled) { ghostsEnabled = enabled; }
+
+    // Human input normally comes from the devices; an external source (the
+    // network session) sets it per tick instead
+    void SetExternalHumanInput(bool external) { externalHumanInput = external; }
+    void SetHumanInput(int playerID, const RacerInput& input);
+    // Input for one tick from the devices; call once per tick, as taps are
+    // handed to the first tick after them
+    RacerInput ReadDeviceInput(int playerID) const;
+
+    // Snapshot buffers are reused, so saving allocates only the first time.
+    // Loading fails if the snapshot was taken with a different grid or track.
+    void SaveState(RaceSnapshot& snapshot) const;
+    bool LoadState(const RaceSnapshot& snapshot);
+
+    // Hash of every bike's position and velocity; equal checksums at the
+    // end of a race mean a replay reproduced it exactly
+    uint64_t ComputeStateChecksum() const;
+    uint64_t GetFinalChecksum() const { return finalChecksum; }
+
+    // Race simulation steps, run by Update() while racing
     void UpdatePlayerPositions();
     void CheckCheckpoints();
     void CheckCollisions();
+    // Casts every AI racer's sensor fan against the obstacles and the other
+    // bikes, as one batch
+    void SenseAI();
+
+private:
+    void UpdateRaceProgress(float deltaTime);
+    void EnsureStaticGrid();
+    void GatherInputs();
+    void FinishGhostLap(float lapTime);
+    void RecordBestLap(float lapTime);   // Player 1's, on the current track
+    std::string GetGhostPath(int levelID) const;
 
     std::unique_ptr<Track> currentTrack;
     std::vector<std::unique_ptr<Player>> players;
@@ -57,9 +191,52 @@ private:
     RaceState raceState;
     float countdownTimer;
     float raceTime;
+    uint32_t raceTick;
     int currentLevelID;
+    int currentBikeIndex;
 
     std::vector<bool> unlockedLevels;
+    float bestLaps[PlayerProgress::TRACK_COUNT];   // Player 1's, 0 until set
+    PlayerStats careerStats;   // Player 1's, as of their last offline race
+    AIParamsTable aiParams;
+
+    PhysicsEngine* physicsEngine;
+    InputManager* inputManager;
+    std::mt19937 rng;
+    uint32_t raceSeed;
+    bool fixedSeed;
+    std::vector<int> rankings;      // Scratch for UpdatePlayerPositions
+    std::vector<int> rankCounts;
+
+    std::vector<RacerInput> tickInputs;
+    std::vector<RacerInput> humanInputs;
+    bool externalHumanInput;
+    int humanPlayerCount;
+    int viewPlayer;
+    std::unique_ptr<ReplayWriter> replayWriter;
+    ReplayReader* replaySource;
+    uint64_t finalChecksum;
+
+    bool ghostsEnabled;
+    GhostRecorder ghostRecorder;
+    GhostTrack ghost;
+
+    RaceSnapshot gridSnapshot;   // Taken by LoadLevel; RestartRace rewinds to it
+
+    // AI sensing and collisions. Static obstacles are bucketed once per
+    // level (owner: obstacle index); bikes and moving platforms every tick.
+    SpatialGrid staticGrid;
+    SpatialGrid movingGrid;
+    SpatialGrid bikeGrid;        // Bike centres only, for bike-bike contacts
+    int staticGridObstacles;     // Obstacle count staticGrid was built for (-1: rebuild)
+    std::vector<int> movingPlatforms;
+    std::vector<int> contacts;   // Scratch for CheckCollisions
+    std::vector<ImpactEvent> impacts;
+    bool impactsMuted;
+    std::vector<SensorRay> sensorRays;
+    std::vector<SensorHit> staticHits;
+    std::vector<SensorHit> movingHits;
+    std::vector<AISensors> aiSensors;
 };
 
 #endif // LEVELMANAGER_H
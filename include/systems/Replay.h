@@ -0,0 +1,78 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include "../entities/Player.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Everything besides the inputs needed to re-run a race
+struct ReplayHeader {
+    uint32_t seed;            // Starting grid shuffle
+    int trackID;
+    int bikeIndex;
+    int racerCount;
+    int tickRate;             // Simulation ticks per second
+    uint32_t tickCount;       // Racing ticks recorded (countdown excluded)
+    uint64_t finalChecksum;   // LevelManager::ComputeStateChecksum() when the race ended
+};
+
+// Records the RacerInput every racer receives on each racing tick. Only
+// changes are stored: a record is the tick gap since the previous record,
+// the racer and a mask of changed fields, then a zigzag varint delta for
+// each changed axis (nitro just toggles). Most ticks change nothing, so
+// an hour of racing stays in the hundreds of kilobytes.
+class ReplayWriter {
+public:
+    ReplayWriter();
+
+    void Begin(const ReplayHeader& raceHeader);
+    void RecordTick(const std::vector<RacerInput>& inputs);
+    void Finish(uint64_t finalChecksum);
+
+    bool IsRecording() const { return recording; }
+    bool HasRecording() const { return finished; }
+    const ReplayHeader& GetHeader() const { return header; }
+    size_t GetStreamSize() const { return stream.size(); }
+
+    bool SaveToFile(const std::string& path) const;
+
+private:
+    ReplayHeader header;
+    std::vector<uint8_t> stream;
+    std::vector<RacerInput> previous;
+    uint32_t tick;
+    uint32_t lastRecordTick;
+    bool recording;
+    bool finished;
+};
+
+// Decodes a replay file one tick at a time
+class ReplayReader {
+public:
+    ReplayReader();
+
+    bool LoadFromFile(const std::string& path);
+    const ReplayHeader& GetHeader() const { return header; }
+
+    // Fills inputs for the next tick; returns false once every recorded
+    // tick has been read or the stream is corrupt
+    bool ReadTick(std::vector<RacerInput>& inputs);
+    bool IsAtEnd() const { return tick >= header.tickCount; }
+
+private:
+    bool ReadNextRecordTick();
+    bool ApplyRecord();
+
+    ReplayHeader header;
+    std::vector<uint8_t> stream;
+    size_t readPos;
+    std::vector<RacerInput> current;
+    uint32_t tick;
+    uint32_t nextRecordTick;
+    bool hasPendingRecord;
+    bool corrupt;
+};
+
+#endif // REPLAY_H
@@ -0,0 +1,95 @@
+#ifndef SAVEGAME_H
+#define SAVEGAME_H
+
+#include "entities/Player.h"
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Career progress kept between sessions
+struct PlayerProgress {
+    static constexpr int TRACK_COUNT = 3;
+
+    PlayerStats stats;             // Player 1's
+    float bestLaps[TRACK_COUNT];   // Seconds, per track; 0 until a lap is set
+    uint32_t unlockedLevels;       // Bit n set: level n + 1 unlocked
+};
+
+// On-disk layout of a save: this header, then recordCount records, each a
+// SaveRecordHeader followed by size bytes of payload. Every record carries
+// its own CRC-32, so a damaged one is skipped without losing the rest, and
+// record types this build doesn't know are skipped too.
+struct SaveFileHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t recordCount;
+    uint32_t reserved;
+};
+
+enum class SaveRecordType : uint16_t {
+    STATS = 1,
+    BEST_LAPS = 2,
+    UNLOCKS = 3
+};
+
+struct SaveRecordHeader {
+    SaveRecordType type;
+    uint16_t version;   // Of this record's payload layout
+    uint32_t size;
+    uint32_t crc;       // Of the payload
+};
+
+// Loads the save once at startup and writes it on a background thread.
+// Save only copies the progress and returns; the writer re-encodes just
+// the records that changed and writes nothing if none did. The file is
+// written to path + ".tmp", flushed to disk and renamed over the old one,
+// so a crash at any point leaves either the old save or the new one.
+class SaveGame {
+public:
+    explicit SaveGame(const std::string& path);
+    ~SaveGame();   // Finishes any queued write
+
+    // False, leaving progress as it was, if there is no save or it fails
+    // its checks; records that pass are applied even if others don't
+    bool Load(PlayerProgress& progress);
+
+    // Queues the progress to be written; never blocks on the disk
+    void Save(const PlayerProgress& progress);
+    // Waits until everything queued is on disk
+    void Flush();
+
+    int GetWriteCount() const;   // Files written so far
+
+private:
+    SaveGame(const SaveGame&) = delete;
+    SaveGame& operator=(const SaveGame&) = delete;
+
+    struct Record {
+        SaveRecordType type;
+        uint16_t version;                     // Written back as it was loaded
+        std::vector<unsigned char> payload;   // As last written (or loaded)
+    };
+
+    void WriterLoop();
+    // The saved records with those that differ re-encoded; true if any did
+    bool UpdateRecords(const PlayerProgress& progress, std::vector<Record>& updated) const;
+    bool WriteFile(const std::vector<Record>& contents) const;
+
+    std::string path;
+    std::vector<Record> records;   // As on disk: filled by Load, then the writer's alone
+
+    mutable std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable idle;
+    PlayerProgress pending;
+    bool hasPending;
+    bool writing;
+    bool stopping;
+    int writeCount;
+    std::thread writer;
+};
+
+#endif // SAVEGAME_H
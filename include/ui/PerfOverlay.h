@@ -0,0 +1,117 @@
+#ifndef PERFOVERLAY_H
+#define PERFOVERLAY_H
+
+#include "raylib.h"
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+enum class PerfSection {
+    INPUT,
+    AI,
+    PHYSICS,
+    CHECKPOINTS,
+    COLLISIONS,
+    RANKING,
+    UI,
+    RENDER,
+    COUNT
+};
+
+// Adds the time spent in a scope to the current frame's total for a section
+class SectionTimer {
+public:
+    explicit SectionTimer(PerfSection section) :
+        section(section), start(std::chrono::steady_clock::now()) {}
+    ~SectionTimer();
+
+    SectionTimer(const SectionTimer&) = delete;
+    SectionTimer& operator=(const SectionTimer&) = delete;
+
+private:
+    PerfSection section;
+    std::chrono::steady_clock::time_point start;
+};
+
+// Debug overlay (F3) with a rolling stacked frame-time graph per section,
+// 99th percentile and worst-frame markers, draw stats and heap allocations.
+// Samples are always collected into fixed-size rings; nothing allocates.
+class PerfOverlay {
+public:
+    static constexpr int HISTORY_FRAMES = 200;
+    static constexpr int SECTION_COUNT = (int)PerfSection::COUNT;
+
+    PerfOverlay();
+    ~PerfOverlay() = default;
+
+    void Toggle() { visible = !visible; }
+    bool IsVisible() const { return visible; }
+
+    // Called once per frame around the work being measured
+    void BeginFrame();
+    void EndFrame(float frameMs, int drawCalls, int triangles, float renderScale);
+
+    // Online races: rewind cost for the current frame, shown as an extra line
+    void SetNetStats(int rollbackDepth, float resimMs, int ticksAhead);
+    // Sound effect voices for the current frame
+    void SetSoundStats(int active, int started, int stolen, int culled);
+
+    void Render() const;
+
+    static void AddSectionTime(PerfSection section, float ms);
+    // This thread's total for a section since BeginFrame
+    static float GetSectionTime(PerfSection section);
+
+private:
+    struct FrameSample {
+        float sectionMs[SECTION_COUNT];
+        float frameMs;
+        int drawCalls;
+        int triangles;
+        int allocations;
+        bool online;
+        int rollbackDepth;
+        float resimMs;
+        int ticksAhead;
+        int soundsActive;
+        int soundsStarted;
+        int soundsStolen;
+        int soundsCulled;
+    };
+
+    const FrameSample& GetSample(int age) const;   // 0 = newest
+    void UpdateSummary();
+
+    std::array<FrameSample, HISTORY_FRAMES> history;
+    int head;            // Next slot to write
+    int count;
+    uint64_t allocationsAtFrameStart;
+    float renderScale;
+    bool visible;
+
+    // Net stats for the frame in progress
+    bool frameOnline;
+    int frameRollbackDepth;
+    float frameResimMs;
+    int frameTicksAhead;
+
+    // Sound stats for the frame in progress
+    int frameSoundsActive;
+    int frameSoundsStarted;
+    int frameSoundsStolen;
+    int frameSoundsCulled;
+
+    // Summary of the window, refreshed each frame while visible
+    std::array<float, HISTORY_FRAMES> sortScratch;
+    float p99Ms;
+    float worstMs;
+    int worstAge;
+    float sectionAvgMs[SECTION_COUNT];
+    float sectionMaxMs[SECTION_COUNT];
+    int maxRollbackDepth;
+    float maxResimMs;
+    int windowSoundsStolen;
+    int windowSoundsCulled;
+};
+
+#endif // PERFOVERLAY_H
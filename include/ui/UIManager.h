@@ -22,10 +22,13 @@ public:
     ~UIManager() = default;
 
     void Update(float deltaTime);
-    void Render() const;
+    void Render();
     void SetState(UIState state);
     UIState GetState() const { return currentState; }
 
+    // GPU resources must be released while the window is still open
+    void UnloadResources();
+
     // Menu callbacks
     void SetStartGameCallback(std::function<void()> callback) { onStartGame = callback; }
     void SetQuitCallback(std::function<void()> callback) { onQuit = callback; }
@@ -39,14 +42,26 @@ private:
     void RenderMainMenu() const;
     void RenderBikeSelect() const;
     void RenderLevelSelect() const;
-    void RenderInGameHUD(const Player& player1, const Player& player2) const;
+    void RenderInGameHUD() const;
     void RenderPauseMenu() const;
     void RenderGameOver() const;
+    void RenderConfetti() const;
+    void RenderChampionBlink() const;
 
     // Helper rendering functions
-    void DrawButton(Rectangle bounds, const std::string& text, Color color, bool highlighted) const;
-    void DrawTitle(const std::string& title, int yPos) const;
+    void DrawButton(Rectangle bounds, const char* text, Color color, bool highlighted) const;
+    void DrawTitle(const char* title, int yPos) const;
     void DrawPlayerHUD(int playerID, Rectangle hudArea) const;
+    void DrawUIText(const char* text, int x, int y, int fontSize, Color color) const;
+    int MeasureUIText(const char* text, int fontSize) const;
+
+    // Retained rendering: static screens and the HUD are drawn into cached
+    // textures and only redrawn when what they show changes
+    void LoadResources();
+    void BeginCache(RenderTexture2D& target) const;
+    void EndCache() const;
+    void DrawCache(const RenderTexture2D& target) const;
+    int GetMenuCacheKey() const;
 
     UIState currentState;
     int selectedMenuOption;
@@ -61,9 +76,24 @@ private:
         float lapTime;
         int position;
     };
-    
+
+    // Values as displayed; text is reformatted only when one of them changes
+    struct HUDDisplay {
+        int speed;
+        int currentLap;
+        int totalLaps;
+        int seconds;
+        int position;
+        char speedText[16];
+        char lapText[16];
+        char positionText[8];
+        char timeText[16];
+    };
+
     HUDData player1HUD;
     HUDData player2HUD;
+    HUDDisplay player1Display;
+    HUDDisplay player2Display;
 
     // Callbacks
     std::function<void()> onStartGame;
@@ -71,8 +101,15 @@ private:
     std::function<void()> onResume;
 
     // Visual settings
-    Font titleFont;
-    bool fontLoaded;
+    Font titleFont;     // Glyph atlas built once at startup, used for all UI text
+    bool fontLoaded;    // True when titleFont is our own atlas (not raylib's default)
+
+    // Cached screens
+    RenderTexture2D menuCache;
+    RenderTexture2D hudCache;
+    bool resourcesLoaded;
+    int menuCacheKey;
+    bool hudDirty;
 };
 
 #endif // UIMANAGER_H
@@ -0,0 +1,12 @@
+#ifndef ALLOCATIONCOUNTER_H
+#define ALLOCATIONCOUNTER_H
+
+#include <cstdint>
+
+// Counts calls to the global operator new (replaced in AllocationCounter.cpp)
+// so per-frame heap allocations can be shown in the performance overlay
+namespace AllocationCounter {
+    uint64_t GetCount();
+}
+
+#endif // ALLOCATIONCOUNTER_H
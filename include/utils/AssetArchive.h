@@ -0,0 +1,104 @@
+#ifndef ASSETARCHIVE_H
+#define ASSETARCHIVE_H
+
+#include "MappedFile.h"
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class ThreadPool;
+
+// On-disk layout of an asset archive: this header, entryCount entries
+// sorted by name, the names (NUL-terminated, nameOffset counted from the
+// end of the entries), then every entry's data at dataOffset from the
+// start of the file.
+struct AssetArchiveHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t entryCount;
+    uint32_t namesSize;
+};
+
+enum class AssetCodec : uint32_t {
+    STORED,     // Not worth compressing
+    DEFLATE
+};
+
+struct AssetArchiveEntry {
+    uint64_t dataOffset;
+    uint32_t nameOffset;
+    uint32_t storedSize;   // Bytes in the archive
+    uint32_t size;         // Bytes once decompressed
+    uint32_t crc;          // Of the decompressed bytes
+    AssetCodec codec;
+    uint32_t reserved;
+};
+
+// Every asset in one memory-mapped file. Opening reads only the table of
+// contents; an entry is decompressed when it is first loaded and kept, up
+// to CACHE_BUDGET bytes in all, so loading it again is a copy. Assets are
+// named by their path under the assets directory ("data/ai_params.cfg").
+class AssetArchive {
+public:
+    // The archive the game loads its assets through
+    static AssetArchive& GetInstance() {
+        static AssetArchive instance;
+        return instance;
+    }
+
+    static constexpr size_t CACHE_BUDGET = 16 * 1024 * 1024;
+
+    AssetArchive();
+
+    bool Open(const std::string& path);
+    void Close();
+    bool IsOpen() const { return file.IsOpen(); }
+    int GetEntryCount() const { return (int)entryCount; }
+    const char* GetEntryName(int index) const;
+
+    // A file at the same name under this directory overrides the archive,
+    // so tools (BikeRaceTuner) can drop in an asset without repacking. The
+    // directory is listed once, here; loads only go to the disk for names
+    // found then. None by default; empty turns the override off again.
+    void SetLooseRoot(const std::string& root);
+    int GetLooseCount() const { return (int)looseNames.size(); }
+
+    bool Contains(const std::string& name) const;
+    // Fails if the asset is in neither place, or fails its checksum
+    bool Load(const std::string& name, std::vector<unsigned char>& data) const;
+    // Several assets at once, decompressed in parallel on the pool (on
+    // the calling thread without one); returns how many loaded
+    int LoadMany(const std::vector<std::string>& names, std::vector<std::vector<unsigned char>>& data,
+                 ThreadPool* pool) const;
+
+    // Build step: writes every file under directory into an archive,
+    // compressing the ones that shrink. The old archive is only replaced
+    // once the new one is complete.
+    static bool Pack(const std::string& directory, const std::string& path);
+
+private:
+    AssetArchive(const AssetArchive&) = delete;
+    AssetArchive& operator=(const AssetArchive&) = delete;
+
+    const AssetArchiveEntry* Find(const std::string& name) const;
+    bool Extract(const AssetArchiveEntry& entry, std::vector<unsigned char>& data) const;
+    bool LoadLoose(const std::string& name, std::vector<unsigned char>& data) const;
+    bool LoadEntry(const AssetArchiveEntry& entry, std::vector<unsigned char>& data) const;
+
+    MappedFile file;
+    const AssetArchiveEntry* entries;   // In the mapping
+    const char* names;
+    uint32_t entryCount;
+    std::string path;
+    std::string looseRoot;
+    std::vector<std::string> looseNames;   // Sorted; listed by SetLooseRoot
+
+    // Decompressed entries, by index; loads on the pool share them
+    mutable std::mutex cacheMutex;
+    mutable std::vector<std::shared_ptr<const std::vector<unsigned char>>> cache;
+    mutable size_t cacheBytes;
+};
+
+#endif // ASSETARCHIVE_H
@@ -10,10 +10,19 @@ namespace Config {
     constexpr int TARGET_FPS = 60;
     constexpr const char* WINDOW_TITLE = "Bike Race Game";
 
+    // Dynamic Resolution (3D scene only, UI is always drawn at native resolution)
+    constexpr bool DYNAMIC_RESOLUTION = true;
+    constexpr float FRAME_TIME_BUDGET_MS = 14.0f;     // Leaves headroom inside a 60 FPS frame
+    constexpr float MIN_RENDER_SCALE = 0.5f;
+    constexpr float MAX_RENDER_SCALE = 1.0f;
+
     // Game Settings
-    constexpr int MAX_PLAYERS = 2;
+    constexpr int MAX_HUMAN_PLAYERS = 2;              // Local keyboard players, or the two online peers
+    constexpr int DEFAULT_RACERS = 5;                 // Humans plus AI on the grid
+    constexpr int MAX_RACERS = 10000;
     constexpr int DEFAULT_LAPS = 3;
     constexpr float FIXED_TIMESTEP = 1.0f / 60.0f;
+    constexpr int MAX_STEPS_PER_FRAME = 5;            // Drops time after long stalls instead of spiralling
 
     // Physics Constants
     constexpr float GRAVITY = 9.8f;
@@ -37,7 +46,13 @@ namespace Config {
     const std::string TEXTURES_PATH = ASSETS_PATH + "textures/";
     const std::string AUDIO_PATH = ASSETS_PATH + "audio/";
     const std::string DATA_PATH = ASSETS_PATH + "data/";
-    const std::string SAVE_FILE = "playerdata.json";
+    const std::string FONTS_PATH = ASSETS_PATH + "fonts/";
+    const std::string AI_PARAMS_ASSET = "data/ai_params.cfg";   // Name inside the asset archive
+    const std::string AI_PARAMS_FILE = ASSETS_PATH + AI_PARAMS_ASSET;
+    const std::string ASSET_ARCHIVE = "assets.pak";   // Packed from assets/ at build time
+    const std::string REPLAYS_PATH = "replays/";
+    const std::string GHOSTS_PATH = "ghosts/";
+    const std::string SAVE_FILE = "playerdata.sav";   // Player 1's progress (SaveGame)
 
     // Colors
     constexpr unsigned char COLOR_PRIMARY_R = 0;
@@ -0,0 +1,13 @@
+#ifndef CRC32_H
+#define CRC32_H
+
+#include <cstddef>
+#include <cstdint>
+
+// CRC-32 (the zlib/PNG polynomial), for catching corrupt or torn files
+namespace Crc32 {
+    // Pass the previous result as crc to continue over more data
+    uint32_t Compute(const void* data, size_t size, uint32_t crc = 0);
+}
+
+#endif // CRC32_H
@@ -1,12 +1,38 @@
 #ifndef LOGGER_H
 #define LOGGER_H
 
-#include <string>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <fstream>
-#include <iostream>
-#include <ctime>
-#include <sstream>
-
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+
+// Build-time threshold: LOG_* calls below it compile to nothing, arguments
+// included. Override with -DLOG_MIN_LEVEL=<n> (CMake: -DLOG_MIN_LEVEL=<n>).
+#define LOG_LEVEL_DEBUG 0
+#define LOG_LEVEL_INFO 1
+#define LOG_LEVEL_WARNING 2
+#define LOG_LEVEL_ERROR 3
+#define LOG_LEVEL_NONE 4
+
+#ifndef LOG_MIN_LEVEL
+#ifdef NDEBUG
+#define LOG_MIN_LEVEL LOG_LEVEL_INFO
+#else
+#define LOG_MIN_LEVEL LOG_LEVEL_DEBUG
+#endif
+#endif
+
+// Asynchronous logger. Callers only copy the format pointer and arguments
+// into a slot of a lock-free ring buffer; a background thread formats the
+// lines and writes them to the console and log file. When the ring is full
+// the message is dropped and counted, so logging never blocks the caller.
 class Logger {
 public:
     enum class Level {
@@ -21,78 +47,186 @@ public:
         return instance;
     }
 
-    void Init(const std::string& filename = "game.log") {
-        logFile.open(filename, std::ios::app);
-        if (!logFile.is_open()) {
-            std::cerr << "Failed to open log file: " << filename << std::endl;
-        }
-    }
+    void Init(const std::string& filename = "game.log");
 
-    void Log(Level level, const std::string& message) {
-        std::string levelStr = LevelToString(level);
-        std::string timestamp = GetTimestamp();
-        std::string logMessage = "[" + timestamp + "] [" + levelStr + "] " + message;
+    // Tools that print machine-readable output on stdout turn the console copy off
+    void SetConsoleOutput(bool enabled) { consoleOutput.store(enabled, std::memory_order_relaxed); }
 
-        // Console output with colors
-        std::cout << GetColorCode(level) << logMessage << "\033[0m" << std::endl;
+    // Writes everything still queued and stops the writer thread. Messages
+    // logged afterwards are written synchronously.
+    void Shutdown();
 
-        // File output
-        if (logFile.is_open()) {
-            logFile << logMessage << std::endl;
-            logFile.flush();
-        }
-    }
+    // Printf-style message. The format must be a string literal; arguments
+    // are captured by value and only formatted on the writer thread.
+    template <typename... Args>
+    void Log(Level level, const char* format, const Args&... args);
+
+    void Log(Level level, const std::string& message) { Log(level, "%s", message); }
 
     void Debug(const std::string& message) { Log(Level::DEBUG, message); }
     void Info(const std::string& message) { Log(Level::INFO, message); }
     void Warning(const std::string& message) { Log(Level::WARNING, message); }
     void Error(const std::string& message) { Log(Level::ERROR, message); }
 
-    ~Logger() {
-        if (logFile.is_open()) {
-            logFile.close();
-        }
-    }
+    uint64_t GetDroppedCount() const { return droppedCount.load(std::memory_order_relaxed); }
+
+    ~Logger();
 
 private:
-    Logger() = default;
+    Logger();
     Logger(const Logger&) = delete;
     Logger& operator=(const Logger&) = delete;
 
-    std::ofstream logFile;
+    static constexpr int MAX_ARGS = 8;
+    static constexpr size_t TEXT_CAPACITY = 192;     // Copied string arguments
+    static constexpr size_t QUEUE_CAPACITY = 4096;   // Must be a power of two
 
-    std::string LevelToString(Level level) {
-        switch (level) {
-            case Level::DEBUG: return "DEBUG";
-            case Level::INFO: return "INFO";
-            case Level::WARNING: return "WARNING";
-            case Level::ERROR: return "ERROR";
-            default: return "UNKNOWN";
-        }
-    }
+    enum class ArgType : uint8_t {
+        INT,
+        UINT,
+        DOUBLE,
+        STRING,
+        POINTER
+    };
 
-    std::string GetColorCode(Level level) {
-        switch (level) {
-            case Level::DEBUG: return "\033[36m";    // Cyan
-            case Level::INFO: return "\033[32m";     // Green
-            case Level::WARNING: return "\033[33m";  // Yellow
-            case Level::ERROR: return "\033[31m";    // Red
-            default: return "\033[0m";               // Reset
-        }
-    }
+    struct Arg {
+        ArgType type;
+        union {
+            long long i;
+            unsigned long long u;
+            double d;
+            size_t textOffset;
+            const void* p;
+        };
+    };
+
+    struct Record {
+        int64_t timestamp;    // steady_clock nanoseconds
+        const char* format;
+        Level level;
+        uint8_t argCount;
+        uint16_t textUsed;
+        Arg args[MAX_ARGS];
+        char text[TEXT_CAPACITY];
+    };
+
+    // Bounded MPSC queue cell (Vyukov): the sequence number tells producers
+    // and the consumer whose turn it is to touch the record
+    struct alignas(64) Cell {
+        std::atomic<size_t> sequence;
+        Record record;
+    };
+
+    template <typename T>
+    static void CaptureArg(Record& record, const T& value);
+    static void CaptureText(Record& record, Arg& arg, const char* text, size_t length);
 
-    std::string GetTimestamp() {
-        std::time_t now = std::time(nullptr);
-        char buf[100];
-        std::strftime(buf, sizeof(buf), "%Y-%m-%d %H:%M:%S", std::localtime(&now));
-        return std::string(buf);
+    Cell* ClaimCell();
+    void PublishCell(Cell* cell);
+
+    void WriterLoop();
+    size_t Drain();
+    void FormatLine(const Record& record, std::string& line);
+    void FormatMessage(const Record& record, std::string& line) const;
+    void FormatTimestamp(int64_t timestamp, std::string& line);
+    void WriteLine(Level level, const std::string& line);
+
+    static int64_t Now() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
     }
+
+    std::unique_ptr<Cell[]> cells;
+    alignas(64) std::atomic<size_t> enqueuePos;
+    alignas(64) size_t dequeuePos;              // Writer thread, then under drainMutex
+    alignas(64) std::atomic<uint64_t> droppedCount;
+
+    std::thread writer;
+    std::atomic<bool> running;
+    std::atomic<bool> writerGone;               // Set once Shutdown has joined the writer
+    std::mutex drainMutex;                      // Serializes the drains after that
+    std::atomic<bool> consoleOutput;
+    std::mutex fileMutex;                       // Init vs. writer, never taken by producers
+    std::ofstream logFile;
+
+    // Writer-side state
+    std::string line;
+    uint64_t reportedDrops;
+    int64_t steadyBase;                         // Maps steady timestamps to wall time
+    std::chrono::system_clock::time_point wallBase;
+    int64_t cachedSecond;
+    char cachedSecondText[32];
 };
 
+template <typename T>
+void Logger::CaptureArg(Record& record, const T& value) {
+    if (record.argCount >= MAX_ARGS) return;
+    Arg& arg = record.args[record.argCount++];
+
+    if constexpr (std::is_same_v<T, std::string>) {
+        CaptureText(record, arg, value.data(), value.size());
+    } else if constexpr (std::is_convertible_v<T, const char*>) {
+        const char* text = value;
+        CaptureText(record, arg, text, text ? std::strlen(text) : 0);
+    } else if constexpr (std::is_floating_point_v<T>) {
+        arg.type = ArgType::DOUBLE;
+        arg.d = (double)value;
+    } else if constexpr (std::is_enum_v<T>) {
+        arg.type = ArgType::INT;
+        arg.i = (long long)value;
+    } else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+        arg.type = ArgType::INT;
+        arg.i = value;
+    } else if constexpr (std::is_integral_v<T>) {
+        arg.type = ArgType::UINT;
+        arg.u = value;
+    } else if constexpr (std::is_pointer_v<T>) {
+        arg.type = ArgType::POINTER;
+        arg.p = (const void*)value;
+    } else {
+        static_assert(std::is_pointer_v<T>, "Unsupported log argument type");
+    }
+}
+
+template <typename... Args>
+void Logger::Log(Level level, const char* format, const Args&... args) {
+    Cell* cell = ClaimCell();
+    if (!cell) return;
+
+    Record& record = cell->record;
+    record.timestamp = Now();
+    record.format = format;
+    record.level = level;
+    record.argCount = 0;
+    record.textUsed = 0;
+    (CaptureArg(record, args), ...);
+
+    PublishCell(cell);
+}
+
 // Convenient macros
-#define LOG_DEBUG(msg) Logger::GetInstance().Debug(msg)
-#define LOG_INFO(msg) Logger::GetInstance().Info(msg)
-#define LOG_WARNING(msg) Logger::GetInstance().Warning(msg)
-#define LOG_ERROR(msg) Logger::GetInstance().Error(msg)
+#if LOG_MIN_LEVEL <= LOG_LEVEL_DEBUG
+#define LOG_DEBUG(...) Logger::GetInstance().Log(Logger::Level::DEBUG, __VA_ARGS__)
+#else
+#define LOG_DEBUG(...) ((void)0)
+#endif
+
+#if LOG_MIN_LEVEL <= LOG_LEVEL_INFO
+#define LOG_INFO(...) Logger::GetInstance().Log(Logger::Level::INFO, __VA_ARGS__)
+#else
+#define LOG_INFO(...) ((void)0)
+#endif
+
+#if LOG_MIN_LEVEL <= LOG_LEVEL_WARNING
+#define LOG_WARNING(...) Logger::GetInstance().Log(Logger::Level::WARNING, __VA_ARGS__)
+#else
+#define LOG_WARNING(...) ((void)0)
+#endif
+
+#if LOG_MIN_LEVEL <= LOG_LEVEL_ERROR
+#define LOG_ERROR(...) Logger::GetInstance().Log(Logger::Level::ERROR, __VA_ARGS__)
+#else
+#define LOG_ERROR(...) ((void)0)
+#endif
 
 #endif // LOGGER_H
@@ -0,0 +1,95 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Scoped timing zones, compiled in only when ENABLE_PROFILER is defined
+// (CMake option ENABLE_PROFILER). Each thread records into its own ring
+// buffer without locking; WriteChromeTrace dumps the most recent zones as a
+// Chrome trace_event file (open in chrome://tracing or Perfetto).
+//
+//     void LevelManager::Update(float deltaTime) {
+//         PROFILE_SCOPE("LevelManager::Update");
+//         ...
+//     }
+#ifdef ENABLE_PROFILER
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_SCOPE(name) ProfileZone PROFILE_CONCAT(profileZone_, __LINE__)(name)
+#define PROFILE_THREAD_NAME(name) Profiler::GetInstance().SetThreadName(name)
+#else
+#define PROFILE_SCOPE(name) ((void)0)
+#define PROFILE_THREAD_NAME(name) ((void)0)
+#endif
+
+class Profiler {
+public:
+    static Profiler& GetInstance() {
+        static Profiler instance;
+        return instance;
+    }
+
+    // Zone names must outlive the profiler (string literals)
+    void Record(const char* name, int64_t startNs, int64_t endNs);
+    void SetThreadName(const char* name);
+
+    // Writes the buffered zones of every thread. Returns false if the file
+    // could not be written.
+    bool WriteChromeTrace(const std::string& filename);
+
+    static int64_t Now() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+private:
+    Profiler();
+    ~Profiler() = default;
+    Profiler(const Profiler&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+
+    static constexpr size_t EVENTS_PER_THREAD = 1 << 16;   // Must be a power of two
+
+    struct ZoneEvent {
+        const char* name;
+        int64_t startNs;
+        int64_t endNs;
+    };
+
+    // Written only by its owning thread; the dump reads it without stopping
+    // the owner, so zones overwritten mid-dump are skipped
+    struct ThreadBuffer {
+        std::unique_ptr<ZoneEvent[]> events;
+        std::atomic<uint64_t> writeIndex;
+        const char* threadName;
+        int threadID;
+    };
+
+    ThreadBuffer& GetThreadBuffer();
+
+    std::mutex registryMutex;   // Taken once per thread and by the dump
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+    int64_t startNs;
+};
+
+// Records the lifetime of a scope as one zone
+class ProfileZone {
+public:
+    explicit ProfileZone(const char* zoneName) : name(zoneName), startNs(Profiler::Now()) {}
+    ~ProfileZone() { Profiler::GetInstance().Record(name, startNs, Profiler::Now()); }
+
+    ProfileZone(const ProfileZone&) = delete;
+    ProfileZone& operator=(const ProfileZone&) = delete;
+
+private:
+    const char* name;
+    int64_t startNs;
+};
+
+#endif // PROFILER_H
@@ -0,0 +1,69 @@
+#ifndef STARTUPTIMELINE_H
+#define STARTUPTIMELINE_H
+
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// What startup spent its time on, from process start to the first frame the
+// player can interact with, and on which thread. Phases are timed with
+// StartupPhase scopes; marks are single points in time. Always compiled in:
+// it records a few dozen events, once.
+class StartupTimeline {
+public:
+    static StartupTimeline& GetInstance() {
+        static StartupTimeline instance;
+        return instance;
+    }
+
+    // Milliseconds since static initialization, which stands in for
+    // process start (the loader's time before it isn't counted)
+    static double Now();
+
+    // Names must outlive the timeline (string literals). Thread-safe.
+    void Record(const char* name, double startMs, double endMs);
+    void Mark(const char* name);
+    // Time of the first mark with this name, or a negative value
+    double GetMark(const char* name) const;
+
+    // One log line per event in start order, with its thread and a bar
+    // placing it on the timeline
+    void LogReport() const;
+    // The same as one JSON line on stdout
+    void PrintReport() const;
+
+private:
+    StartupTimeline() = default;
+    StartupTimeline(const StartupTimeline&) = delete;
+    StartupTimeline& operator=(const StartupTimeline&) = delete;
+
+    struct Event {
+        const char* name;
+        double startMs;
+        double endMs;     // Equal to startMs for marks
+        int thread;       // 0 for the first thread seen (main), then in order
+        bool mark;
+    };
+
+    std::vector<Event> SortedEvents() const;
+
+    mutable std::mutex mutex;
+    std::vector<Event> events;
+    std::vector<std::thread::id> threads;
+};
+
+// Records the enclosing scope as a startup phase
+class StartupPhase {
+public:
+    explicit StartupPhase(const char* name) : name(name), startMs(StartupTimeline::Now()) {}
+    ~StartupPhase() { StartupTimeline::GetInstance().Record(name, startMs, StartupTimeline::Now()); }
+
+private:
+    StartupPhase(const StartupPhase&) = delete;
+    StartupPhase& operator=(const StartupPhase&) = delete;
+
+    const char* name;
+    double startMs;
+};
+
+#endif // STARTUPTIMELINE_H
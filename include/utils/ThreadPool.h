@@ -0,0 +1,46 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of worker threads for data-parallel loops. ParallelFor hands
+// out indices from a shared counter, so uneven tasks balance themselves,
+// and the calling thread works too: N workers means N + 1 threads busy.
+class ThreadPool {
+public:
+    explicit ThreadPool(int workerCount);
+    ~ThreadPool();
+
+    int GetThreadCount() const { return (int)workers.size() + 1; }
+
+    // Runs task(i) for every i in [0, count) and returns once all are done.
+    // Not reentrant: call from one thread at a time.
+    void ParallelFor(int count, const std::function<void(int)>& task);
+
+private:
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    void WorkerLoop();
+    void RunTasks();
+
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+
+    const std::function<void(int)>* currentTask;
+    int taskCount;
+    std::atomic<int> nextIndex;
+    int busyWorkers;          // Workers still inside the current loop
+    uint64_t generation;      // Bumped per ParallelFor so workers see new work
+    bool stopping;
+};
+
+#endif // THREADPOOL_H
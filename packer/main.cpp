@@ -0,0 +1,186 @@
+// BikeRaceAssetPack: packs the assets directory into the single archive the
+// game mounts at startup (run by the build), and measures loading from it
+// against loading the loose files. Bench results are printed as one JSON
+// line per case.
+//
+//     ./bin/BikeRaceAssetPack <assets-dir> <archive>
+//     ./bin/BikeRaceAssetPack --bench <assets-dir> <archive> [--runs n] [--threads n]
+//
+// Cold runs ask the OS to drop the files from the page cache first (Linux
+// only; elsewhere every run is warm). The "archive" case mounts the archive
+// afresh every run, so every entry is inflated; "archive_cached" keeps one
+// mount, so after the first run entries come from its decompressed cache.
+
+#include "utils/AssetArchive.h"
+#include "utils/Logger.h"
+#include "utils/ThreadPool.h"
+#include "raylib.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    struct BenchSettings {
+        std::string directory;
+        std::string archivePath;
+        int runs;
+        int threads;
+    };
+
+    double MillisecondsSince(Clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    // Best effort: clean pages are dropped, anything else stays cached
+    bool EvictFromPageCache(const std::string& path) {
+#ifdef __linux__
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        bool evicted = posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED) == 0;
+        close(fd);
+        return evicted;
+#else
+        (void)path;
+        return false;
+#endif
+    }
+
+    std::vector<std::string> ListAssets(const std::string& directory) {
+        namespace fs = std::filesystem;
+        std::vector<std::string> names;
+        std::error_code error;
+        for (fs::recursive_directory_iterator it(directory, error), end; !error && it != end; it.increment(error)) {
+            if (it->is_regular_file(error)) {
+                names.push_back(fs::relative(it->path(), directory, error).generic_string());
+            }
+        }
+        std::sort(names.begin(), names.end());
+        return names;
+    }
+
+    // Median of the runs, in milliseconds
+    template <typename LoadAll>
+    double TimeRuns(int runs, bool cold, const std::vector<std::string>& evict, LoadAll loadAll) {
+        std::vector<double> times;
+        for (int run = 0; run < runs; run++) {
+            if (cold) {
+                for (const std::string& path : evict) EvictFromPageCache(path);
+            }
+            Clock::time_point start = Clock::now();
+            loadAll();
+            times.push_back(MillisecondsSince(start));
+        }
+        std::sort(times.begin(), times.end());
+        return times[times.size() / 2];
+    }
+
+    int RunBench(const BenchSettings& settings) {
+        std::vector<std::string> names = ListAssets(settings.directory);
+        if (names.empty()) {
+            std::fprintf(stderr, "No assets under %s\n", settings.directory.c_str());
+            return 1;
+        }
+
+        std::vector<std::string> loosePaths;
+        size_t looseBytes = 0;
+        for (const std::string& name : names) {
+            loosePaths.push_back(settings.directory + "/" + name);
+            looseBytes += std::filesystem::file_size(loosePaths.back());
+        }
+        size_t archiveBytes = std::filesystem::file_size(settings.archivePath);
+
+        ThreadPool pool(settings.threads);
+        std::vector<std::vector<unsigned char>> data;
+        int loaded = 0;
+
+        // What startup did before: every file opened and read on one thread
+        AssetArchive loose;
+        loose.SetLooseRoot(settings.directory + "/");
+        auto loadLoose = [&]() { loaded = loose.LoadMany(names, data, nullptr); };
+
+        // Mounting is part of the cost, so each run opens the archive afresh
+        auto loadArchive = [&]() {
+            AssetArchive archive;
+            loaded = archive.Open(settings.archivePath) ? archive.LoadMany(names, data, &pool) : 0;
+        };
+
+        // Loading again through the same mount, as a level reload would
+        AssetArchive mounted;
+        mounted.Open(settings.archivePath);
+        auto loadCached = [&]() { loaded = mounted.LoadMany(names, data, &pool); };
+
+        struct Case {
+            const char* source;
+            bool cold;
+        };
+        const Case CASES[] = {{"loose", false}, {"archive", false}, {"archive_cached", false},
+                              {"loose", true}, {"archive", true}};
+        for (const Case& c : CASES) {
+            bool isLoose = std::strcmp(c.source, "loose") == 0;
+            bool isCached = std::strcmp(c.source, "archive_cached") == 0;
+            bool isArchive = !isLoose;
+            std::vector<std::string> evict = isArchive ? std::vector<std::string>{settings.archivePath} : loosePaths;
+            double ms = isLoose ? TimeRuns(settings.runs, c.cold, evict, loadLoose)
+                      : isCached ? TimeRuns(settings.runs, c.cold, evict, loadCached)
+                                 : TimeRuns(settings.runs, c.cold, evict, loadArchive);
+            std::printf("{\"case\":\"%s\",\"cache\":\"%s\",\"assets\":%d,\"loaded\":%d,\"bytes_on_disk\":%zu,"
+                        "\"median_ms\":%.3f,\"runs\":%d,\"threads\":%d}\n",
+                        c.source, c.cold ? "cold" : "warm", (int)names.size(), loaded,
+                        isArchive ? archiveBytes : looseBytes, ms, settings.runs, isArchive ? settings.threads : 1);
+            std::fflush(stdout);
+            if (loaded != (int)names.size()) {
+                std::fprintf(stderr, "Only %d of %zu assets loaded from %s\n", loaded, names.size(), c.source);
+                return 1;
+            }
+        }
+        return 0;
+    }
+
+    void PrintUsage() {
+        std::fprintf(stderr,
+            "usage: BikeRaceAssetPack <assets-dir> <archive>\n"
+            "       BikeRaceAssetPack --bench <assets-dir> <archive> [--runs n] [--threads n]\n");
+    }
+}
+
+int main(int argc, char** argv) {
+    SetTraceLogLevel(LOG_WARNING);
+    if (argc >= 4 && std::strcmp(argv[1], "--bench") == 0) {
+        BenchSettings settings;
+        settings.directory = argv[2];
+        settings.archivePath = argv[3];
+        settings.runs = 9;
+        settings.threads = std::max((int)std::thread::hardware_concurrency() - 1, 1);
+        for (int i = 4; i + 1 < argc; i += 2) {
+            if (std::strcmp(argv[i], "--runs") == 0) settings.runs = std::max(std::atoi(argv[i + 1]), 1);
+            else if (std::strcmp(argv[i], "--threads") == 0) settings.threads = std::max(std::atoi(argv[i + 1]), 1);
+        }
+        Logger::GetInstance().SetConsoleOutput(false);
+        int result = RunBench(settings);
+        Logger::GetInstance().Shutdown();
+        return result;
+    }
+
+    if (argc != 3 || argv[1][0] == '-') {
+        PrintUsage();
+        return 1;
+    }
+    bool packed = AssetArchive::Pack(argv[1], argv[2]);
+    Logger::GetInstance().Shutdown();
+    return packed ? 0 : 1;
+}
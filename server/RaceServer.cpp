@@ -0,0 +1,253 @@
+#include "RaceServer.h"
+#include "net/PacketIO.h"
+#include "net/RaceProtocol.h"
+#include "utils/AssetArchive.h"
+#include "utils/Config.h"
+#include "utils/Logger.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <thread>
+
+namespace {
+    constexpr int BROADCAST_INTERVAL_TICKS = 3;   // State goes out at 20 Hz
+    constexpr double CLIENT_TIMEOUT = 5.0;
+    constexpr int MAX_CATCH_UP_TICKS = 5;         // Further behind than this, time is dropped
+    constexpr int TRACK_COUNT = 3;
+
+    // Nearest-rank percentile; reorders the samples
+    int64_t Percentile(std::vector<int64_t>& samples, int percent) {
+        if (samples.empty()) return 0;
+        size_t rank = std::max<size_t>((samples.size() * percent + 99) / 100, 1) - 1;
+        std::nth_element(samples.begin(), samples.begin() + rank, samples.end());
+        return samples[rank];
+    }
+}
+
+RaceServer::RaceServer(const ServerSettings& serverSettings) :
+    settings(serverSettings),
+    stopRequested(false),
+    windowTicks(0),
+    windowLateTicks(0)
+{
+}
+
+RaceServer::~RaceServer() = default;
+
+bool RaceServer::Start() {
+    if (!socket.Open(settings.port)) {
+        LOG_ERROR("Failed to open UDP port %d", (int)settings.port);
+        return false;
+    }
+
+    pool = std::make_unique<ThreadPool>(std::max(settings.threads - 1, 0));
+
+    AIParamsTable aiParams = AIParamsFile::Defaults();
+    AssetArchive::GetInstance().Open(Config::ASSET_ARCHIVE);
+    AssetArchive::GetInstance().SetLooseRoot(Config::ASSETS_PATH);   // Tuner output
+    AIParamsFile::LoadAsset(aiParams);
+
+    // Each race gets its own seed; tracks rotate
+    std::random_device seeds;
+    for (int i = 0; i < settings.raceCount; i++) {
+        races.push_back(std::make_unique<ServerRace>(i, settings.racersPerRace, settings.humanSlots,
+                                                     seeds(), 1 + i % TRACK_COUNT, aiParams));
+    }
+
+    LOG_INFO("Server listening on port %d: %d races of %d racers, %d threads",
+             (int)socket.GetLocalPort(), settings.raceCount, settings.racersPerRace, pool->GetThreadCount());
+    return true;
+}
+
+void RaceServer::Run() {
+    using Clock = std::chrono::steady_clock;
+    const auto interval = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(Config::FIXED_TIMESTEP));
+
+    auto start = Clock::now();
+    auto nextTick = start;
+    auto windowStart = start;
+    uint64_t tick = 0;
+
+    while (!stopRequested.load(std::memory_order_relaxed)) {
+        if (!settings.unpaced) {
+            std::this_thread::sleep_until(nextTick);
+        }
+        auto tickStart = Clock::now();
+        double now = std::chrono::duration<double>(tickStart - start).count();
+
+        ReceivePackets(now);
+        if (tick % 60 == 0) {
+            DropIdleClients(now);
+        }
+
+        bool broadcast = tick % BROADCAST_INTERVAL_TICKS == 0;
+        pool->ParallelFor((int)races.size(), [&](int i) {
+            races[i]->Tick(socket, broadcast);
+        });
+        tick++;
+        windowTicks++;
+
+        auto tickEnd = Clock::now();
+        serverTickTimes.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(tickEnd - tickStart).count());
+
+        nextTick += interval;
+        if (!settings.unpaced && tickEnd > nextTick) {
+            windowLateTicks++;
+            if (tickEnd - nextTick > MAX_CATCH_UP_TICKS * interval) {
+                nextTick = tickEnd;
+            }
+        }
+
+        double windowSeconds = std::chrono::duration<double>(tickEnd - windowStart).count();
+        if (windowSeconds >= settings.reportSeconds) {
+            Report(std::chrono::duration<double>(tickEnd - start).count(), windowSeconds, false);
+            windowStart = tickEnd;
+        }
+        if (settings.durationSeconds > 0.0 && now >= settings.durationSeconds) {
+            break;
+        }
+    }
+
+    auto end = Clock::now();
+    Report(std::chrono::duration<double>(end - start).count(),
+           std::chrono::duration<double>(end - windowStart).count(), true);
+}
+
+void RaceServer::ReceivePackets(double now) {
+    uint8_t buffer[UdpSocket::MAX_PACKET_SIZE];
+    NetAddress from;
+    int size;
+    while ((size = socket.Receive(from, buffer, sizeof(buffer))) >= 0) {
+        if (size < 2 || buffer[0] != RaceProtocol::MAGIC) continue;
+
+        switch (buffer[1]) {
+            case RaceProtocol::JOIN:
+                HandleJoin(from, now);
+                break;
+
+            case RaceProtocol::INPUT: {
+                if (size < (int)RaceProtocol::INPUT_SIZE) break;
+                int raceIndex = PacketIO::ReadU16(buffer + 2);
+                int playerID = PacketIO::ReadU16(buffer + 4);
+                // Only the slot's owner may drive it
+                if (raceIndex < (int)races.size() && races[raceIndex]->IsClient(playerID, from)) {
+                    races[raceIndex]->SetInput(playerID, PacketIO::ReadInput(buffer + 6),
+                                               PacketIO::ReadU16(buffer + 10), now);
+                }
+                break;
+            }
+
+            case RaceProtocol::LEAVE:
+                HandleLeave(from);
+                break;
+
+            default:
+                break;
+        }
+    }
+}
+
+void RaceServer::HandleJoin(const NetAddress& from, double now) {
+    // A repeated JOIN means our WELCOME was lost
+    auto existing = clients.find(ClientKey(from));
+    if (existing != clients.end()) {
+        SendWelcome(from, existing->second);
+        return;
+    }
+
+    for (size_t i = 0; i < races.size(); i++) {
+        int playerID = races[i]->AddClient(from, now);
+        if (playerID >= 0) {
+            ClientRef client = {(int)i, playerID};
+            clients[ClientKey(from)] = client;
+            LOG_INFO("%s joined race %d as player %d", from.ToString(), (int)i, playerID);
+            SendWelcome(from, client);
+            return;
+        }
+    }
+
+    uint8_t full[2] = {RaceProtocol::MAGIC, RaceProtocol::FULL};
+    socket.Send(from, full, sizeof(full));
+}
+
+void RaceServer::HandleLeave(const NetAddress& from) {
+    auto it = clients.find(ClientKey(from));
+    if (it == clients.end()) return;
+
+    races[it->second.raceIndex]->RemoveClient(it->second.playerID);
+    LOG_INFO("%s left race %d", from.ToString(), it->second.raceIndex);
+    clients.erase(it);
+}
+
+void RaceServer::SendWelcome(const NetAddress& to, const ClientRef& client) {
+    const ServerRace& race = *races[client.raceIndex];
+    uint8_t welcome[RaceProtocol::WELCOME_SIZE] = {RaceProtocol::MAGIC, RaceProtocol::WELCOME};
+    PacketIO::WriteU16(welcome + 2, (uint16_t)client.raceIndex);
+    PacketIO::WriteU16(welcome + 4, (uint16_t)client.playerID);
+    PacketIO::WriteU32(welcome + 6, race.GetSeed());
+    welcome[10] = (uint8_t)race.GetTrackID();
+    PacketIO::WriteU16(welcome + 11, (uint16_t)race.GetRacerCount());
+    socket.Send(to, welcome, sizeof(welcome));
+}
+
+void RaceServer::DropIdleClients(double now) {
+    for (auto it = clients.begin(); it != clients.end();) {
+        ServerRace& race = *races[it->second.raceIndex];
+        if (now - race.GetLastHeard(it->second.playerID) > CLIENT_TIMEOUT) {
+            LOG_INFO("Client in race %d (player %d) timed out", race.GetID(), it->second.playerID);
+            race.RemoveClient(it->second.playerID);
+            it = clients.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void RaceServer::Report(double elapsed, double windowSeconds, bool final) {
+    raceTickScratch.clear();
+    uint64_t packets = 0;
+    uint64_t bytes = 0;
+    for (auto& race : races) {
+        const std::vector<int64_t>& times = race->GetTickTimes();
+        raceTickScratch.insert(raceTickScratch.end(), times.begin(), times.end());
+        packets += race->GetPacketsSent();
+        bytes += race->GetBytesSent();
+        race->ClearStats();
+    }
+
+    double raceNsTotal = 0.0;
+    for (int64_t ns : raceTickScratch) {
+        raceNsTotal += (double)ns;
+    }
+    double raceNsAvg = raceTickScratch.empty() ? 0.0 : raceNsTotal / raceTickScratch.size();
+    int64_t raceP50 = Percentile(raceTickScratch, 50);
+    int64_t raceP99 = Percentile(raceTickScratch, 99);
+    int64_t raceMax = Percentile(raceTickScratch, 100);
+    int64_t serverP50 = Percentile(serverTickTimes, 50);
+    int64_t serverP99 = Percentile(serverTickTimes, 99);
+    int64_t serverMax = Percentile(serverTickTimes, 100);
+
+    // Sizing: share of the pool's time spent inside race ticks, and how
+    // many races one core could tick at 60 Hz at the measured average
+    double window = std::max(windowSeconds, 1e-9);
+    double busyPct = 100.0 * raceNsTotal / (window * 1e9 * pool->GetThreadCount());
+    double racesPerCore = raceNsAvg > 0.0 ? 1e9 / (raceNsAvg * (1.0 / Config::FIXED_TIMESTEP)) : 0.0;
+
+    std::printf("{\"server\":\"%s\",\"elapsed_s\":%.1f,\"races\":%d,\"racers_per_race\":%d,\"threads\":%d,"
+                "\"clients\":%zu,\"ticks_per_s\":%.1f,\"race_tick_us_avg\":%.1f,\"race_tick_us_p50\":%.1f,"
+                "\"race_tick_us_p99\":%.1f,\"race_tick_us_max\":%.1f,\"server_tick_ms_p50\":%.3f,"
+                "\"server_tick_ms_p99\":%.3f,\"server_tick_ms_max\":%.3f,\"late_ticks\":%d,"
+                "\"busy_pct\":%.1f,\"races_per_core\":%.1f,\"packets_out_per_s\":%.0f,\"kbytes_out_per_s\":%.1f}\n",
+                final ? "final" : "report", elapsed, (int)races.size(), settings.racersPerRace,
+                pool->GetThreadCount(), clients.size(), windowTicks / window, raceNsAvg / 1e3,
+                raceP50 / 1e3, raceP99 / 1e3, raceMax / 1e3, serverP50 / 1e6, serverP99 / 1e6,
+                serverMax / 1e6, windowLateTicks, busyPct, racesPerCore, packets / window,
+                bytes / window / 1024.0);
+    std::fflush(stdout);
+
+    serverTickTimes.clear();
+    windowTicks = 0;
+    windowLateTicks = 0;
+}
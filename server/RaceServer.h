@@ -0,0 +1,69 @@
+#ifndef RACESERVER_H
+#define RACESERVER_H
+
+#include "ServerRace.h"
+#include "net/UdpSocket.h"
+#include "utils/ThreadPool.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+struct ServerSettings {
+    uint16_t port;
+    int raceCount;
+    int racersPerRace;
+    int humanSlots;           // Per race; the rest are AI
+    int threads;              // Including the network thread
+    double durationSeconds;   // 0 = until stopped
+    double reportSeconds;
+    bool unpaced;             // Tick back to back instead of at 60 Hz (sizing runs)
+};
+
+// Headless server running many independent races. The network thread reads
+// every packet between ticks, then all races are ticked across a thread
+// pool; each race sends its own state packets from its worker. Periodic
+// JSON reports give tick-time percentiles and races per core for sizing.
+class RaceServer {
+public:
+    explicit RaceServer(const ServerSettings& settings);
+    ~RaceServer();
+
+    bool Start();
+    void Run();
+    // Safe to call from a signal handler
+    void RequestStop() { stopRequested.store(true, std::memory_order_relaxed); }
+
+private:
+    struct ClientRef {
+        int raceIndex;
+        int playerID;
+    };
+
+    static uint64_t ClientKey(const NetAddress& address) {
+        return ((uint64_t)address.ip << 16) | address.port;
+    }
+
+    void ReceivePackets(double now);
+    void HandleJoin(const NetAddress& from, double now);
+    void HandleLeave(const NetAddress& from);
+    void SendWelcome(const NetAddress& to, const ClientRef& client);
+    void DropIdleClients(double now);
+    void Report(double elapsed, double windowSeconds, bool final);
+
+    ServerSettings settings;
+    UdpSocket socket;
+    std::unique_ptr<ThreadPool> pool;
+    std::vector<std::unique_ptr<ServerRace>> races;
+    std::unordered_map<uint64_t, ClientRef> clients;
+    std::atomic<bool> stopRequested;
+
+    // Report window
+    uint64_t windowTicks;
+    int windowLateTicks;
+    std::vector<int64_t> serverTickTimes;   // Whole tick, network thread included
+    std::vector<int64_t> raceTickScratch;
+};
+
+#endif // RACESERVER_H
@@ -0,0 +1,134 @@
+#include "ServerRace.h"
+#include "utils/Config.h"
+#include "utils/Logger.h"
+#include <algorithm>
+#include <chrono>
+
+namespace {
+    constexpr int RESTART_DELAY_TICKS = 5 * 60;   // Results stay up this long
+    constexpr size_t TICK_TIMES_RESERVE = 60 * 60;
+}
+
+ServerRace::ServerRace(int raceID, int racerCount, int humanSlots, uint32_t raceSeed, int track,
+                       const AIParamsTable& aiParams) :
+    id(raceID),
+    trackID(track),
+    seed(raceSeed),
+    clientCount(0),
+    tick(0),
+    finishedTicks(0),
+    packetsSent(0),
+    bytesSent(0)
+{
+    // No devices on a server: every human slot is fed from the network
+    level.Initialize(&physics, nullptr);
+    level.SetRacerCount(racerCount);
+    level.SetHumanPlayerCount(0);
+    level.SetExternalHumanInput(true);
+    level.SetSeed(seed);
+    level.SetAIParams(aiParams);
+    level.LoadLevel(trackID);
+    level.StartRace();
+
+    slots.resize(std::min(humanSlots, level.GetPlayerCount()));
+    float trackLength = level.GetCurrentTrack()->GetRacingLine().GetLength();
+    for (Slot& slot : slots) {
+        slot.connected = false;
+        slot.lastHeard = 0.0;
+        slot.encoder.SetTrackLength(trackLength);
+    }
+    tickTimes.reserve(TICK_TIMES_RESERVE);
+}
+
+int ServerRace::AddClient(const NetAddress& address, double now) {
+    for (size_t i = 0; i < slots.size(); i++) {
+        Slot& slot = slots[i];
+        if (!slot.connected) {
+            slot.connected = true;
+            slot.address = address;
+            slot.lastHeard = now;
+            slot.encoder.Reset();
+            clientCount++;
+            level.SetHumanInput((int)i, RacerInput{});
+            ApplySlotControl();
+            return (int)i;
+        }
+    }
+    return -1;
+}
+
+void ServerRace::RemoveClient(int playerID) {
+    if (playerID < 0 || playerID >= (int)slots.size() || !slots[playerID].connected) return;
+    slots[playerID].connected = false;
+    clientCount--;
+    ApplySlotControl();
+}
+
+bool ServerRace::IsClient(int playerID, const NetAddress& address) const {
+    return playerID >= 0 && playerID < (int)slots.size() &&
+           slots[playerID].connected && slots[playerID].address == address;
+}
+
+void ServerRace::SetInput(int playerID, const RacerInput& input, uint16_t ackSequence, double now) {
+    level.SetHumanInput(playerID, input);
+    slots[playerID].lastHeard = now;
+    slots[playerID].encoder.Acknowledge(ackSequence);
+}
+
+void ServerRace::ApplySlotControl() {
+    // Empty slots are raced by the AI
+    for (size_t i = 0; i < slots.size(); i++) {
+        level.GetPlayer((int)i)->SetAI(!slots[i].connected);
+    }
+}
+
+void ServerRace::Tick(UdpSocket& socket, bool broadcast) {
+    auto start = std::chrono::steady_clock::now();
+
+    if (level.IsRaceFinished() && ++finishedTicks >= RESTART_DELAY_TICKS) {
+        level.RestartRace();
+        ApplySlotControl();
+        finishedTicks = 0;
+    }
+    level.Update(Config::FIXED_TIMESTEP);
+    tick++;
+
+    if (broadcast && clientCount > 0) {
+        BroadcastState(socket);
+    }
+
+    tickTimes.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start).count());
+}
+
+void ServerRace::BroadcastState(UdpSocket& socket) {
+    int racerCount = level.GetPlayerCount();
+    quantized.resize(racerCount);
+    for (int i = 0; i < racerCount; i++) {
+        const Player* player = level.GetPlayer(i);
+        const Bike* bike = player->GetBike();
+        quantized[i] = RaceProtocol::Quantize({bike->GetPosition(), bike->GetRotation(), bike->GetSpeed(),
+                                               player->GetCurrentLap(), player->HasFinishedRace()});
+    }
+
+    SnapshotInfo info = {(uint16_t)id, tick, (uint8_t)level.GetRaceState()};
+    for (size_t i = 0; i < slots.size(); i++) {
+        Slot& slot = slots[i];
+        if (!slot.connected) continue;
+
+        int fragments = slot.encoder.Encode(info, quantized.data(), racerCount, (int)i);
+        for (int f = 0; f < fragments; f++) {
+            size_t size = slot.encoder.GetPacketSize(f);
+            if (socket.Send(slot.address, slot.encoder.GetPacket(f), size)) {
+                packetsSent++;
+                bytesSent += size;
+            }
+        }
+    }
+}
+
+void ServerRace::ClearStats() {
+    tickTimes.clear();
+    packetsSent = 0;
+    bytesSent = 0;
+}
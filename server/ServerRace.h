@@ -0,0 +1,71 @@
+#ifndef SERVERRACE_H
+#define SERVERRACE_H
+
+#include "net/SnapshotCodec.h"
+#include "net/UdpSocket.h"
+#include "physics/PhysicsEngine.h"
+#include "systems/LevelManager.h"
+#include <cstdint>
+#include <vector>
+
+// One race on the server: its own simulation, the clients driving its human
+// slots, and the tick timings the server reports. Only one thread touches a
+// race at a time: a pool worker during Tick(), the network thread between
+// ticks.
+class ServerRace {
+public:
+    ServerRace(int raceID, int racerCount, int humanSlots, uint32_t seed, int trackID, const AIParamsTable& aiParams);
+
+    int GetID() const { return id; }
+    int GetTrackID() const { return trackID; }
+    uint32_t GetSeed() const { return seed; }
+    int GetRacerCount() const { return level.GetPlayerCount(); }
+    int GetClientCount() const { return clientCount; }
+
+    // Claims a free human slot for a client. Returns its player ID, or -1.
+    int AddClient(const NetAddress& address, double now);
+    void RemoveClient(int playerID);
+    bool IsClient(int playerID, const NetAddress& address) const;
+    // Controls plus the newest snapshot the client has rebuilt
+    void SetInput(int playerID, const RacerInput& input, uint16_t ackSequence, double now);
+    double GetLastHeard(int playerID) const { return slots[playerID].lastHeard; }
+
+    // Advances one fixed tick and, when asked, sends every client a delta
+    // snapshot. Called on a pool worker.
+    void Tick(UdpSocket& socket, bool broadcast);
+
+    // Tick() durations in nanoseconds since the last ClearStats()
+    const std::vector<int64_t>& GetTickTimes() const { return tickTimes; }
+    uint64_t GetPacketsSent() const { return packetsSent; }
+    uint64_t GetBytesSent() const { return bytesSent; }
+    void ClearStats();
+
+private:
+    struct Slot {
+        bool connected;
+        NetAddress address;
+        double lastHeard;
+        SnapshotEncoder encoder;   // Baselines and interest for this client
+    };
+
+    void BroadcastState(UdpSocket& socket);
+    void ApplySlotControl();
+
+    int id;
+    int trackID;
+    uint32_t seed;
+    PhysicsEngine physics;
+    LevelManager level;
+
+    std::vector<Slot> slots;
+    std::vector<RaceProtocol::QuantizedRacer> quantized;   // Scratch for broadcasts
+    int clientCount;
+    uint32_t tick;
+    int finishedTicks;   // Ticks since the race ended; restarts after a pause
+
+    std::vector<int64_t> tickTimes;
+    uint64_t packetsSent;
+    uint64_t bytesSent;
+};
+
+#endif // SERVERRACE_H
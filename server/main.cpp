@@ -0,0 +1,82 @@
+// BikeRaceServer: headless dedicated server hosting many independent races.
+// Clients join over UDP and send their controls; the server simulates every
+// race and sends back authoritative state. Reports are JSON lines on stdout.
+//
+//     ./bin/BikeRaceServer [--port p] [--races n] [--racers n] [--humans n]
+//                          [--threads n] [--duration s] [--report s] [--unpaced]
+
+#include "RaceServer.h"
+#include "utils/Logger.h"
+#include <algorithm>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+
+namespace {
+    RaceServer* activeServer = nullptr;
+
+    void HandleSignal(int) {
+        if (activeServer) {
+            activeServer->RequestStop();
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    ServerSettings settings = {};
+    settings.port = 7788;
+    settings.raceCount = 16;
+    settings.racersPerRace = 5;
+    settings.humanSlots = 2;
+    settings.threads = std::max((int)std::thread::hardware_concurrency(), 1);
+    settings.durationSeconds = 0.0;
+    settings.reportSeconds = 5.0;
+    settings.unpaced = false;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--port" && hasValue) {
+            settings.port = (uint16_t)std::atoi(argv[++i]);
+        } else if (arg == "--races" && hasValue) {
+            settings.raceCount = std::max(std::atoi(argv[++i]), 1);
+        } else if (arg == "--racers" && hasValue) {
+            settings.racersPerRace = std::max(std::atoi(argv[++i]), 1);
+        } else if (arg == "--humans" && hasValue) {
+            settings.humanSlots = std::max(std::atoi(argv[++i]), 0);
+        } else if (arg == "--threads" && hasValue) {
+            settings.threads = std::max(std::atoi(argv[++i]), 1);
+        } else if (arg == "--duration" && hasValue) {
+            settings.durationSeconds = std::atof(argv[++i]);
+        } else if (arg == "--report" && hasValue) {
+            settings.reportSeconds = std::max(std::atof(argv[++i]), 0.1);
+        } else if (arg == "--unpaced") {
+            settings.unpaced = true;
+        } else {
+            std::fprintf(stderr, "Usage: %s [--port p] [--races n] [--racers n] [--humans n] "
+                                 "[--threads n] [--duration s] [--report s] [--unpaced]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    // Reports go to stdout; keep log lines in the file
+    Logger::GetInstance().Init("server.log");
+    Logger::GetInstance().SetConsoleOutput(false);
+
+    RaceServer server(settings);
+    if (!server.Start()) {
+        Logger::GetInstance().Shutdown();
+        return 1;
+    }
+
+    activeServer = &server;
+    std::signal(SIGINT, HandleSignal);
+    std::signal(SIGTERM, HandleSignal);
+    server.Run();
+    activeServer = nullptr;
+
+    Logger::GetInstance().Shutdown();
+    return 0;
+}
@@ -0,0 +1,201 @@
+// BikeRaceTestClient: simulated players for exercising BikeRaceServer.
+// Each client joins, sends scripted controls at 60 Hz and checks the state
+// coming back. Prints one JSON summary line.
+//
+//     ./bin/BikeRaceTestClient [--server ip:port] [--clients n] [--duration s]
+
+#include "entities/Player.h"
+#include "net/PacketIO.h"
+#include "net/RaceProtocol.h"
+#include "net/SnapshotCodec.h"
+#include "net/UdpSocket.h"
+#include "utils/Config.h"
+#include "utils/Logger.h"
+#include "raymath.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    constexpr double JOIN_RETRY_INTERVAL = 0.5;
+
+    struct TestClient {
+        UdpSocket socket;
+        bool joined = false;
+        bool full = false;
+        double lastJoinTime = -JOIN_RETRY_INTERVAL;
+        int raceID = 0;
+        int playerID = 0;
+        int racerCount = 0;
+
+        SnapshotDecoder snapshots;
+        uint64_t statePackets = 0;
+        uint64_t stateBytes = 0;
+        uint64_t completeSnapshots = 0;
+        bool haveOwnState = false;
+        Vector3 firstPosition = {};
+        Vector3 lastPosition = {};
+    };
+
+    void HandlePacket(TestClient& client, const uint8_t* data, int size) {
+        if (size < 2 || data[0] != RaceProtocol::MAGIC) return;
+
+        switch (data[1]) {
+            case RaceProtocol::WELCOME:
+                if (size < (int)RaceProtocol::WELCOME_SIZE || client.joined) return;
+                client.joined = true;
+                client.raceID = PacketIO::ReadU16(data + 2);
+                client.playerID = PacketIO::ReadU16(data + 4);
+                client.racerCount = PacketIO::ReadU16(data + 11);
+                break;
+
+            case RaceProtocol::FULL:
+                client.full = true;
+                break;
+
+            case RaceProtocol::STATE: {
+                client.statePackets++;
+                client.stateBytes += size;
+                if (!client.snapshots.Decode(data, size)) return;
+
+                client.completeSnapshots++;
+                const auto& racers = client.snapshots.GetRacers();
+                if (client.playerID < (int)racers.size()) {
+                    Vector3 position = RaceProtocol::Dequantize(racers[client.playerID]).position;
+                    if (!client.haveOwnState) {
+                        client.firstPosition = position;
+                        client.haveOwnState = true;
+                    }
+                    client.lastPosition = position;
+                }
+                break;
+            }
+
+            default:
+                break;
+        }
+    }
+
+    // Full throttle with a slow weave, different per client
+    RacerInput ScriptedInput(int clientIndex, double now) {
+        float turn = std::sin((float)now * 0.7f + clientIndex) * 0.5f;
+        return RacerInput::FromAxes(1.0f, 0.0f, turn, false);
+    }
+}
+
+int main(int argc, char** argv) {
+    std::string serverText = "127.0.0.1:7788";
+    int clientCount = 8;
+    double duration = 10.0;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--server" && hasValue) {
+            serverText = argv[++i];
+        } else if (arg == "--clients" && hasValue) {
+            clientCount = std::max(std::atoi(argv[++i]), 1);
+        } else if (arg == "--duration" && hasValue) {
+            duration = std::atof(argv[++i]);
+        } else {
+            std::fprintf(stderr, "Usage: %s [--server ip:port] [--clients n] [--duration s]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    NetAddress server;
+    if (!NetAddress::Parse(serverText, server)) {
+        std::fprintf(stderr, "Invalid server address '%s'\n", serverText.c_str());
+        return 2;
+    }
+
+    Logger::GetInstance().SetConsoleOutput(false);
+
+    std::vector<std::unique_ptr<TestClient>> clients;
+    for (int i = 0; i < clientCount; i++) {
+        clients.push_back(std::make_unique<TestClient>());
+        if (!clients.back()->socket.Open(0)) {
+            std::fprintf(stderr, "Failed to open a UDP socket\n");
+            return 1;
+        }
+    }
+
+    using Clock = std::chrono::steady_clock;
+    const auto interval = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(Config::FIXED_TIMESTEP));
+    auto start = Clock::now();
+    auto nextTick = start;
+
+    uint8_t buffer[UdpSocket::MAX_PACKET_SIZE];
+    uint8_t packet[RaceProtocol::INPUT_SIZE];
+    double now = 0.0;
+    while (now < duration) {
+        std::this_thread::sleep_until(nextTick);
+        nextTick += interval;
+        now = std::chrono::duration<double>(Clock::now() - start).count();
+
+        for (int i = 0; i < clientCount; i++) {
+            TestClient& client = *clients[i];
+            NetAddress from;
+            int size;
+            while ((size = client.socket.Receive(from, buffer, sizeof(buffer))) >= 0) {
+                if (from == server) {
+                    HandlePacket(client, buffer, size);
+                }
+            }
+
+            if (!client.joined) {
+                if (!client.full && now - client.lastJoinTime >= JOIN_RETRY_INTERVAL) {
+                    uint8_t join[2] = {RaceProtocol::MAGIC, RaceProtocol::JOIN};
+                    client.socket.Send(server, join, sizeof(join));
+                    client.lastJoinTime = now;
+                }
+                continue;
+            }
+
+            packet[0] = RaceProtocol::MAGIC;
+            packet[1] = RaceProtocol::INPUT;
+            PacketIO::WriteU16(packet + 2, (uint16_t)client.raceID);
+            PacketIO::WriteU16(packet + 4, (uint16_t)client.playerID);
+            PacketIO::WriteInput(packet + 6, ScriptedInput(i, now));
+            PacketIO::WriteU16(packet + 10, client.snapshots.GetAckSequence());
+            client.socket.Send(server, packet, sizeof(packet));
+        }
+    }
+
+    int joined = 0;
+    int full = 0;
+    int moved = 0;
+    uint64_t packets = 0;
+    uint64_t bytes = 0;
+    uint64_t snapshots = 0;
+    uint64_t undecodable = 0;
+    for (auto& client : clients) {
+        uint8_t leave[2] = {RaceProtocol::MAGIC, RaceProtocol::LEAVE};
+        client->socket.Send(server, leave, sizeof(leave));
+
+        joined += client->joined ? 1 : 0;
+        full += client->full ? 1 : 0;
+        moved += (client->haveOwnState && Vector3Distance(client->firstPosition, client->lastPosition) > 1.0f) ? 1 : 0;
+        packets += client->statePackets;
+        bytes += client->stateBytes;
+        snapshots += client->completeSnapshots;
+        undecodable += client->snapshots.GetUndecodable();
+    }
+
+    double perClient = 1.0 / (std::max(duration, 1e-9) * std::max(joined, 1));
+    std::printf("{\"test_client\":\"%s\",\"clients\":%d,\"joined\":%d,\"full\":%d,\"moved\":%d,"
+                "\"state_packets_per_s\":%.1f,\"snapshots_per_s\":%.1f,\"kbytes_per_s\":%.2f,"
+                "\"undecodable_packets\":%llu}\n",
+                serverText.c_str(), clientCount, joined, full, moved, packets * perClient,
+                snapshots * perClient, bytes * perClient / 1024.0, (unsigned long long)undecodable);
+    std::fflush(stdout);
+
+    return (joined > 0 && moved == joined) ? 0 : 1;
+}
@@ -1,37 +1,88 @@
 #include "core/GameEngine.h"
 #include "core/InputManager.h"
+#include "core/InputLatency.h"
 #include "core/CameraManager.h"
+#include "core/ResolutionScaler.h"
 #include "ui/UIManager.h"
+#include "ui/PerfOverlay.h"
 #include "systems/LevelManager.h"
 #include "systems/AudioManager.h"
+#include "systems/Replay.h"
+#include "systems/SaveGame.h"
 #include "physics/PhysicsEngine.h"
+#include "render/AssetCache.h"
+#include "render/RenderQueue.h"
+#include "render/RenderBackend.h"
+#include "net/RollbackSession.h"
+#include "utils/AssetArchive.h"
 #include "utils/Config.h"
 #include "utils/Logger.h"
+#include "utils/Profiler.h"
+#include "utils/StartupTimeline.h"
+#include "utils/ThreadPool.h"
+#include "raymath.h"
+#include "rlgl.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <ctime>
+#include <filesystem>
+#include <random>
+#include <thread>
+
+namespace {
+    // Impact sounds share one priority, so when the voice pool is full
+    // the harder hits (louder, or closer to the listener) keep playing
+    constexpr int IMPACT_SOUND_PRIORITY = 1;
+    constexpr float IMPACT_FULL_VOLUME_SPEED = 15.0f;   // m/s closing speed
+}
 
-GameEngine::GameEngine() : isRunning(false), currentState(GameState::MAIN_MENU), deltaTime(0.0f), accumulator(0.0f) {
+GameEngine::GameEngine() : isRunning(false), headless(false), currentState(GameState::MAIN_MENU), deltaTime(0.0f), accumulator(0.0f),
+    audioReady(false), impactSound(INVALID_SOUND), pendingMusic(nullptr), sceneTarget{}, sceneTargetLoaded(false), framesPresented(0) {
     // Constructor body
 }
 
 void GameEngine::Initialize() {
     LOG_INFO("Initializing window and subsystems...");
+    PROFILE_THREAD_NAME("Main");
+    StartupPhase phase("GameEngine::Initialize");
 
     // Initialize window
-    InitWindow(Config::SCREEN_WIDTH, Config::SCREEN_HEIGHT, Config::WINDOW_TITLE);
-    SetTargetFPS(Config::TARGET_FPS);
-
-    // Initialize audio device
-    InitAudioDevice();
-
-    // Initialize subsystems
-    inputManager = std::make_unique<InputManager>();
-    uiManager = std::make_unique<UIManager>();
-    levelManager = std::make_unique<LevelManager>();
-    audioManager = std::make_unique<AudioManager>();
-    physicsEngine = std::make_unique<PhysicsEngine>();
+    {
+        StartupPhase windowPhase("InitWindow");
+        InitWindow(Config::SCREEN_WIDTH, Config::SCREEN_HEIGHT, Config::WINDOW_TITLE);
+    }
+    // Frame pacing is done in Run() rather than with SetTargetFPS, so the
+    // cap wait can be kept out of the frame time used for resolution scaling
+
+    // Only what the main menu needs is set up here. The audio device and
+    // sound banks start on a worker thread, the scene target is created
+    // after the first menu frame, and the track and racers with the first
+    // level loaded.
+    CreateSubsystems();
+    renderBackend = std::make_unique<RaylibRenderBackend>();
+    {
+        // Progress from the last session; saved in the background from here on
+        StartupPhase savePhase("SaveGame::Load");
+        saveGame = std::make_unique<SaveGame>(Config::SAVE_FILE);
+        PlayerProgress progress = levelManager->GetProgress();
+        if (saveGame->Load(progress)) {
+            levelManager->SetProgress(progress);
+        }
+    }
+    audioStartup = std::async(std::launch::async, [this]() {
+        {
+            StartupPhase devicePhase("InitAudioDevice");
+            InitAudioDevice();
+        }
+        StartupPhase banksPhase("AudioManager::Initialize");
+        audioManager->Initialize(loadPool.get());
+    });
 
     // Initialize subsystem dependencies
-    levelManager->Initialize();
-    audioManager->Initialize();
+    levelManager->SetReplayRecording(true);
+    levelManager->SetGhostsEnabled(true);
 
     // Set up UI callbacks
     uiManager->SetStartGameCallback([this]() {
@@ -56,35 +107,325 @@ void GameEngine::Initialize() {
     LOG_INFO("Game engine initialized successfully");
 }
 
+void GameEngine::InitializeHeadless() {
+    LOG_INFO("Initializing headless subsystems...");
+    PROFILE_THREAD_NAME("Main");
+
+    headless = true;
+    CreateSubsystems();
+    renderBackend = std::make_unique<NullRenderBackend>();
+
+    isRunning = true;
+    currentState = GameState::MAIN_MENU;
+    deltaTime = Config::FIXED_TIMESTEP;
+    accumulator = 0.0f;
+}
+
+void GameEngine::CreateSubsystems() {
+    StartupPhase phase("CreateSubsystems");
+    inputManager = std::make_unique<InputManager>();
+    uiManager = std::make_unique<UIManager>();
+    levelManager = std::make_unique<LevelManager>();
+    audioManager = std::make_unique<AudioManager>();
+    physicsEngine = std::make_unique<PhysicsEngine>();
+    resolutionScaler = std::make_unique<ResolutionScaler>();
+    renderQueue = std::make_unique<RenderQueue>();
+    perfOverlay = std::make_unique<PerfOverlay>();
+
+    levelManager->Initialize(physicsEngine.get(), inputManager.get());
+
+    // Assets come from the packed archive; loose files under assets/ (listed
+    // once, here) override it
+    AssetArchive& archive = AssetArchive::GetInstance();
+    if (!archive.Open(Config::ASSET_ARCHIVE)) {
+        LOG_INFO("No asset archive (%s), reading loose files from %s", Config::ASSET_ARCHIVE, Config::ASSETS_PATH);
+    }
+    archive.SetLooseRoot(Config::ASSETS_PATH);
+    loadPool = std::make_unique<ThreadPool>(std::max((int)std::thread::hardware_concurrency() - 1, 1));
+
+    AIParamsTable aiParams = AIParamsFile::Defaults();
+    AIParamsFile::LoadAsset(aiParams);
+    levelManager->SetAIParams(aiParams);
+}
+
 GameEngine::~GameEngine() {
     // Destructor defined here so unique_ptr members with incomplete types can be destroyed
 }
 
 void GameEngine::Run() {
     while (isRunning && !WindowShouldClose()) {
-        deltaTime = GetFrameTime();
+        RunFrame();
+    }
+}
+
+void GameEngine::RunFrame() {
+    const double targetFrameTime = 1.0 / Config::TARGET_FPS;
+
+    double frameStart = GetTime();
+    deltaTime = GetFrameTime();
+    perfOverlay->BeginFrame();
+
+    ProcessInput();
+    Update();
+    bool sceneRendered = Render();
+    if (framesPresented++ == 0) {
+        StartupTimeline::GetInstance().Mark("first_interactive_frame");
+        StartupTimeline::GetInstance().LogReport();
+    } else if (!sceneTargetLoaded) {
+        // Off the critical path, but before the first race needs it
+        CreateSceneTarget();
+    }
+
+    // Work time covers update, draw submission and the buffer swap (which
+    // blocks when the GPU falls behind), but not the frame cap wait below
+    double workTime = GetTime() - frameStart;
+    resolutionScaler->AddFrameSample((float)(workTime * 1000.0));
+
+    const RenderStats& stats = renderQueue->GetLastStats();
+    perfOverlay->EndFrame((float)(workTime * 1000.0),
+                          sceneRendered ? stats.drawCalls : 0,
+                          sceneRendered ? stats.triangles : 0,
+                          resolutionScaler->GetScale());
+
+    if (workTime < targetFrameTime) {
+        WaitTime(targetFrameTime - workTime);
+    }
+}
+
+void GameEngine::EnableLatencyMonitor() {
+    if (!latencyMonitor) {
+        latencyMonitor = std::make_unique<InputLatencyMonitor>();
+        inputManager->SetLatencyMonitor(latencyMonitor.get());
+    }
+}
+
+int GameEngine::RunLatencyTest(int frames) {
+    EnableLatencyMonitor();
+    inputManager->EnableSyntheticInput(1);
+    levelManager->SetReplayRecording(false);
+    levelManager->SetGhostsEnabled(false);
+    levelManager->LoadLevel(1);
+    levelManager->StartRace();
+    SetState(GameState::PLAYING);
+
+    const double targetFrameTime = 1.0 / Config::TARGET_FPS;
+    double previousStart = InputLatencyMonitor::Now();
+    for (int frame = 0; frame < frames && isRunning; frame++) {
+        if (currentState != GameState::PLAYING) {
+            // Race over; go again
+            levelManager->RestartRace();
+            SetState(GameState::PLAYING);
+        }
+
+        if (!headless) {
+            if (WindowShouldClose()) break;
+            RunFrame();
+            continue;
+        }
+
+        // Headless: the same steps at the same pace, with the flush into
+        // the null backend standing in for the frame being shown
+        double frameStart = InputLatencyMonitor::Now();
+        deltaTime = (float)(frameStart - previousStart);
+        previousStart = frameStart;
 
         ProcessInput();
         Update();
-        Render();
+        levelManager->Render(*renderQueue);
+        renderQueue->Flush(*renderBackend);
+        latencyMonitor->OnPresented(InputLatencyMonitor::Now());
+
+        double workTime = InputLatencyMonitor::Now() - frameStart;
+        if (workTime < targetFrameTime) {
+            std::this_thread::sleep_for(std::chrono::duration<double>(targetFrameTime - workTime));
+        }
+    }
+
+    return latencyMonitor->GetSampleCount() > 0 ? 0 : 1;
+}
+
+int GameEngine::RunStartupReport(int maxFrames) {
+    int frames = 0;
+    while (frames < maxFrames && isRunning && !IsStartupComplete()) {
+        RunFrame();
+        frames++;
+    }
+    bool complete = IsStartupComplete();
+    StartupTimeline& timeline = StartupTimeline::GetInstance();
+    if (complete) {
+        timeline.Mark("startup_complete");
+    }
+
+    timeline.PrintReport();
+    std::printf("{\"first_interactive_frame_ms\":%.2f,\"startup_complete_ms\":%.2f,\"frames\":%d,"
+                "\"window\":%s,\"audio\":%s}\n",
+                timeline.GetMark("first_interactive_frame"), timeline.GetMark("startup_complete"), frames,
+                IsWindowReady() ? "true" : "false", IsAudioDeviceReady() ? "true" : "false");
+    std::fflush(stdout);
+    return complete ? 0 : 1;
+}
+
+void GameEngine::SaveRaceReplay() {
+    std::error_code error;
+    std::filesystem::create_directories(Config::REPLAYS_PATH, error);
+
+    char filename[64];
+    std::time_t now = std::time(nullptr);
+    std::strftime(filename, sizeof(filename), "race_%Y%m%d_%H%M%S.replay", std::localtime(&now));
+    levelManager->SaveReplay(Config::REPLAYS_PATH + filename);
+}
+
+int GameEngine::RunReplay(const std::string& path) {
+    ReplayReader reader;
+    if (!reader.LoadFromFile(path)) {
+        return 1;
+    }
+
+    const ReplayHeader& header = reader.GetHeader();
+    int tickRate = (int)lroundf(1.0f / Config::FIXED_TIMESTEP);
+    if (header.tickRate != tickRate) {
+        LOG_ERROR("Replay was recorded at %d Hz, this build runs at %d Hz", header.tickRate, tickRate);
+        return 1;
+    }
+
+    levelManager->SetRacerCount(header.racerCount);
+    levelManager->SetSeed(header.seed);
+    levelManager->LoadLevel(header.trackID, header.bikeIndex);
+    levelManager->SetReplaySource(&reader);
+    levelManager->StartRace();
+
+    // Countdown, the recorded ticks, then the tick that ends the race
+    long long maxTicks = (long long)std::ceil(3.0f / Config::FIXED_TIMESTEP) + header.tickCount + 2;
+    long long ticks = 0;
+    auto start = std::chrono::steady_clock::now();
+    while (!levelManager->IsRaceFinished() && ticks < maxTicks) {
+        levelManager->Update(Config::FIXED_TIMESTEP);
+        ticks++;
+    }
+    double wallMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    levelManager->SetReplaySource(nullptr);
+
+    bool finished = levelManager->IsRaceFinished();
+    bool match = finished && levelManager->GetFinalChecksum() == header.finalChecksum;
+    double simSeconds = ticks * (double)Config::FIXED_TIMESTEP;
+    std::printf("{\"replay\":\"%s\",\"track\":%d,\"racers\":%d,\"ticks\":%lld,"
+                "\"sim_s\":%.1f,\"wall_ms\":%.1f,\"speedup\":%.0f,"
+                "\"finished\":%s,\"checksum_match\":%s,\"winner\":%d}\n",
+                path.c_str(), header.trackID, header.racerCount, ticks, simSeconds, wallMs,
+                wallMs > 0.0 ? simSeconds * 1000.0 / wallMs : 0.0,
+                finished ? "true" : "false", match ? "true" : "false",
+                finished ? levelManager->GetWinner() + 1 : 0);
+    std::fflush(stdout);
+
+    return match ? 0 : 1;
+}
+
+bool GameEngine::HostOnlineRace(uint16_t port, int trackID) {
+    auto session = std::make_unique<RollbackSession>(*levelManager);
+    if (!session->Host(port, {std::random_device{}(), trackID, 0})) {
+        return false;
+    }
+    BeginOnlineRace(std::move(session));
+    return true;
+}
+
+bool GameEngine::JoinOnlineRace(const std::string& hostAddress) {
+    NetAddress address;
+    if (!NetAddress::Parse(hostAddress, address)) {
+        LOG_ERROR("Invalid host address '%s', expected ip:port", hostAddress);
+        return false;
+    }
+    auto session = std::make_unique<RollbackSession>(*levelManager);
+    if (!session->Join(address)) {
+        return false;
     }
+    BeginOnlineRace(std::move(session));
+    return true;
+}
+
+void GameEngine::BeginOnlineRace(std::unique_ptr<RollbackSession> session) {
+    // Replays and ghosts assume a single local human
+    levelManager->SetReplayRecording(false);
+    levelManager->SetGhostsEnabled(false);
+    netSession = std::move(session);
+    accumulator = 0.0f;
+    SetState(GameState::PLAYING);
+}
+
+void GameEngine::UpdateOnlineRace() {
+    double now = GetTime();
+    netSession->BeginFrame();
+    netSession->Poll(now);
+
+    // The session loads the race once the peers have met
+    if (!netSession->IsConnected()) {
+        accumulator = 0.0f;
+        return;
+    }
+
+    int steps = 0;
+    while (accumulator >= Config::FIXED_TIMESTEP && steps < Config::MAX_STEPS_PER_FRAME) {
+        // Local keys always drive our own racer, whichever slot it is
+        if (!netSession->AdvanceTick(levelManager->ReadDeviceInput(0), now)) {
+            break;   // Waiting for the peer; the accumulator catches up later
+        }
+        accumulator -= Config::FIXED_TIMESTEP;
+        steps++;
+    }
+    accumulator = std::min(accumulator, Config::MAX_STEPS_PER_FRAME * Config::FIXED_TIMESTEP);
+
+    const RollbackStats& stats = netSession->GetFrameStats();
+    perfOverlay->SetNetStats(stats.rollbackDepth, stats.resimMs, stats.ticksAhead);
+}
+
+void GameEngine::EndOnlineRace() {
+    netSession.reset();
+    levelManager->SetReplayRecording(!headless);
+    levelManager->SetGhostsEnabled(!headless);
+}
+
+void GameEngine::SetFrameTimeBudget(float budgetMs) {
+    resolutionScaler->Configure(budgetMs, Config::MIN_RENDER_SCALE, Config::MAX_RENDER_SCALE);
+    LOG_INFO("Frame time budget set to %.1fms", budgetMs);
 }
 
 void GameEngine::Update() {
+    PROFILE_SCOPE("GameEngine::Update");
     // Update subsystems based on current state
     switch (currentState) {
         case GameState::MAIN_MENU:
         case GameState::BIKE_SELECT:
         case GameState::LEVEL_SELECT:
         case GameState::PAUSED:
-        case GameState::GAME_OVER:
+        case GameState::GAME_OVER: {
+            SectionTimer timer(PerfSection::UI);
             uiManager->Update(deltaTime);
             break;
+        }
 
-        case GameState::PLAYING:
-            // Update game systems
-            levelManager->Update(deltaTime);
-            physicsEngine->Update(deltaTime);
+        case GameState::PLAYING: {
+            // The race advances in fixed ticks so a recorded race replays exactly
+            accumulator += deltaTime;
+            if (netSession) {
+                UpdateOnlineRace();
+                if (!netSession->IsConnected()) {
+                    break;
+                }
+            } else {
+                int steps = 0;
+                while (accumulator >= Config::FIXED_TIMESTEP && steps < Config::MAX_STEPS_PER_FRAME) {
+                    levelManager->Update(Config::FIXED_TIMESTEP);
+                    {
+                        SectionTimer timer(PerfSection::PHYSICS);
+                        physicsEngine->Update(Config::FIXED_TIMESTEP);
+                    }
+                    accumulator -= Config::FIXED_TIMESTEP;
+                    steps++;
+                }
+                accumulator = std::min(accumulator, Config::FIXED_TIMESTEP);
+            }
+
+            SectionTimer uiTimer(PerfSection::UI);
             uiManager->Update(deltaTime);
             
             // Update HUD data for both players
@@ -109,50 +450,321 @@ void GameEngine::Update() {
                     player2->GetRacePosition());
             }
 
-            // Check if race is finished
-            if (levelManager->IsRaceFinished()) {
+            // Check if race is finished (online, only once both inputs confirm it)
+            if (netSession ? netSession->IsRaceOver() : levelManager->IsRaceFinished()) {
+                SaveRaceReplay();
+                // Online races don't change career progress
+                if (saveGame && !netSession) {
+                    saveGame->Save(levelManager->GetProgress());
+                }
                 SetState(GameState::GAME_OVER);
             }
             break;
+        }
+    }
+
+    // Keep feeding the peer after an online race ends, so it can confirm
+    // the finish too even if our last packets were lost
+    if (netSession && currentState == GameState::GAME_OVER) {
+        accumulator += deltaTime;
+        UpdateOnlineRace();
     }
 
     // Always update audio
-    audioManager->Update(deltaTime);
+    UpdateAudio();
 }
 
-void GameEngine::Render() {
-    BeginDrawing();
-    ClearBackground(RAYWHITE);
+bool GameEngine::IsStartupComplete() const {
+    return headless || (audioReady && sceneTargetLoaded);
+}
+
+void GameEngine::FinishAudioStartup() {
+    if (audioReady || !audioStartup.valid() ||
+        audioStartup.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+        return;
+    }
+    audioStartup.get();
+    impactSound = audioManager->FindSound("collision");
+    audioReady = true;
+    StartupTimeline::GetInstance().Mark("audio_ready");
+    if (pendingMusic) {
+        PlayMusic(pendingMusic);
+        pendingMusic = nullptr;
+    }
+}
 
+void GameEngine::PlayMusic(const char* musicName) {
+    if (audioReady) {
+        audioManager->PlayMusic(musicName);
+    } else {
+        pendingMusic = musicName;
+    }
+}
+
+void GameEngine::CreateSceneTarget() {
+    StartupPhase phase("CreateSceneTarget");
+    sceneTarget = LoadRenderTexture(Config::SCREEN_WIDTH, Config::SCREEN_HEIGHT);
+    SetTextureFilter(sceneTarget.texture, TEXTURE_FILTER_BILINEAR);
+    sceneTargetLoaded = true;
+}
+
+void GameEngine::UpdateAudio() {
+    // Until the worker has the device up, race sounds are dropped
+    FinishAudioStartup();
+    if (!audioReady) {
+        levelManager->ClearImpacts();
+        return;
+    }
+
+    bool racing = (currentState == GameState::PLAYING);
+    if (racing) {
+        Camera3D camera = levelManager->GetCamera();
+        Vector3 forward = Vector3Subtract(camera.target, camera.position);
+        audioManager->SetListener(camera.target, Vector3Normalize(Vector3CrossProduct(forward, camera.up)));
+
+        // One effect per impact; harder hits are louder and so win voices
+        for (const ImpactEvent& impact : levelManager->GetImpacts()) {
+            audioManager->PlaySound(impactSound, impact.position, IMPACT_SOUND_PRIORITY,
+                                    impact.speed / IMPACT_FULL_VOLUME_SPEED);
+        }
+    }
+    levelManager->ClearImpacts();
+
+    // Engine sound follows the race; silent in menus and while paused
+    EngineSynth& engines = audioManager->GetEngineSynth();
+    if (engines.IsRunning()) {
+        if (racing) {
+            levelManager->PublishEngineAudio(engines);
+        } else {
+            engines.SilenceFrom(0);
+        }
+    }
+
+    audioManager->Update(deltaTime);
+    const SoundFrameStats& sounds = audioManager->GetFrameStats();
+    perfOverlay->SetSoundStats(sounds.active, sounds.started, sounds.stolen, sounds.culled);
+}
+
+bool GameEngine::Render() {
+    PROFILE_SCOPE("GameEngine::Render");
     // Render based on state
+    bool sceneRendered = false;
     switch (currentState) {
-        case GameState::PLAYING:
-            // 3D rendering
-            levelManager->Render();
+        case GameState::PLAYING: {
+            if (netSession && !netSession->IsConnected()) {
+                break;   // Nothing is loaded until the opponent joins
+            }
+            // 3D rendering into the offscreen target
+            SectionTimer timer(PerfSection::RENDER);
+            RenderScene();
+            sceneRendered = true;
             break;
+        }
 
         default:
             // 2D UI only
             break;
     }
 
-    // Always render UI on top
-    uiManager->Render();
+    BeginDrawing();
+    ClearBackground(RAYWHITE);
+
+    if (sceneRendered) {
+        // Upscale the scene region to the window (negative height flips the render texture)
+        float sceneWidth = (float)resolutionScaler->GetScaledWidth(sceneTarget.texture.width);
+        float sceneHeight = (float)resolutionScaler->GetScaledHeight(sceneTarget.texture.height);
+        Rectangle source = {0.0f, 0.0f, sceneWidth, -sceneHeight};
+        Rectangle dest = {0.0f, 0.0f, (float)GetScreenWidth(), (float)GetScreenHeight()};
+        DrawTexturePro(sceneTarget.texture, source, dest, {0.0f, 0.0f}, 0.0f, WHITE);
+    }
+
+    // Always render UI on top, at native resolution
+    if (netSession && !netSession->IsConnected()) {
+        const char* text = "Waiting for opponent...  (Esc to cancel)";
+        DrawText(text, (GetScreenWidth() - MeasureText(text, 30)) / 2, GetScreenHeight() / 2 - 15, 30, DARKGRAY);
+    } else {
+        SectionTimer timer(PerfSection::UI);
+        uiManager->Render();
+    }
+
+    // Frame timing overlay (F3)
+    perfOverlay->Render();
+
+    {
+        SectionTimer timer(PerfSection::RENDER);
+        EndDrawing();
+    }
+    if (latencyMonitor && sceneRendered) {
+        latencyMonitor->OnPresented(InputLatencyMonitor::Now());
+    }
+
+    return sceneRendered;
+}
+
+void GameEngine::RenderScene() {
+    if (!sceneTargetLoaded) {
+        CreateSceneTarget();   // A race started on the first frames
+    }
+    int sceneWidth = resolutionScaler->GetScaledWidth(sceneTarget.texture.width);
+    int sceneHeight = resolutionScaler->GetScaledHeight(sceneTarget.texture.height);
+
+    BeginTextureMode(sceneTarget);
+    ClearBackground(RAYWHITE);
 
-    // FPS counter (debug)
-    DrawFPS(10, 10);
+    // Restrict drawing to the scaled region; aspect ratio is unchanged so the
+    // camera projection set up by BeginMode3D still matches
+    rlViewport(0, 0, sceneWidth, sceneHeight);
+    levelManager->Render(*renderQueue);
+    renderQueue->Flush(*renderBackend);
 
-    EndDrawing();
+    EndTextureMode();
+}
+
+int GameEngine::RunRenderBenchmark(int framesPerTrack) {
+    auto& nullBackend = static_cast<NullRenderBackend&>(*renderBackend);
+    int totalInvalid = 0;
+
+    for (int levelID = 1; levelID <= 3; levelID++) {
+        levelManager->LoadLevel(levelID);
+        levelManager->StartRace();
+        nullBackend.ResetCounters();
+
+        double drawCalls = 0.0, stateChanges = 0.0, triangles = 0.0, submitMicros = 0.0;
+        float submitMicrosMax = 0.0f;
+
+        for (int frame = 0; frame < framesPerTrack; frame++) {
+            if (levelManager->IsRaceFinished()) {
+                levelManager->RestartRace();
+            }
+            levelManager->Update(Config::FIXED_TIMESTEP);
+            levelManager->Render(*renderQueue);
+            renderQueue->Flush(nullBackend);
+
+            const RenderStats& stats = renderQueue->GetLastStats();
+            drawCalls += stats.drawCalls;
+            stateChanges += stats.stateChanges;
+            triangles += stats.triangles;
+            submitMicros += stats.submitMicros;
+            submitMicrosMax = std::max(submitMicrosMax, stats.submitMicros);
+        }
+
+        int frames = std::max(framesPerTrack, 1);
+        std::printf("{\"bench\":\"render_submission\",\"track\":%d,\"frames\":%d,"
+                    "\"draw_calls\":%.1f,\"state_changes\":%.1f,\"triangles\":%.0f,"
+                    "\"submit_us_avg\":%.2f,\"submit_us_max\":%.2f,\"invalid_draws\":%d}\n",
+                    levelID, framesPerTrack, drawCalls / frames, stateChanges / frames,
+                    triangles / frames, submitMicros / frames, submitMicrosMax,
+                    nullBackend.GetInvalidCount());
+        std::fflush(stdout);
+
+        totalInvalid += nullBackend.GetInvalidCount();
+    }
+
+#ifdef ENABLE_PROFILER
+    Profiler::GetInstance().WriteChromeTrace("render_bench_trace.json");
+#endif
+
+    return totalInvalid > 0 ? 1 : 0;
+}
+
+int GameEngine::RunStressTest(const std::vector<int>& racerCounts, int ticks) {
+    auto& nullBackend = static_cast<NullRenderBackend&>(*renderBackend);
+    constexpr int SECTIONS[] = {(int)PerfSection::AI, (int)PerfSection::PHYSICS, (int)PerfSection::CHECKPOINTS,
+                                (int)PerfSection::COLLISIONS, (int)PerfSection::RANKING};
+    constexpr const char* SECTION_KEYS[] = {"ai", "physics", "checkpoints", "collisions", "ranking"};
+    constexpr int SECTION_COUNT = sizeof(SECTIONS) / sizeof(SECTIONS[0]);
+
+    levelManager->SetHumanPlayerCount(0);
+    levelManager->SetSeed(1);
+
+    for (int racers : racerCounts) {
+        levelManager->SetRacerCount(racers);
+        levelManager->LoadLevel(1);
+        levelManager->StartRace();
+        while (levelManager->GetRaceState() == RaceState::COUNTDOWN) {
+            levelManager->Update(Config::FIXED_TIMESTEP);
+        }
+
+        double tickSum = 0.0, renderSum = 0.0, drawCalls = 0.0;
+        float tickMax = 0.0f, renderMax = 0.0f;
+        double sectionSum[SECTION_COUNT] = {};
+        float sectionMax[SECTION_COUNT] = {};
+
+        for (int tick = 0; tick < ticks; tick++) {
+            if (levelManager->IsRaceFinished()) {
+                levelManager->RestartRace();
+                while (levelManager->GetRaceState() == RaceState::COUNTDOWN) {
+                    levelManager->Update(Config::FIXED_TIMESTEP);
+                }
+            }
+
+            perfOverlay->BeginFrame();
+            auto start = std::chrono::steady_clock::now();
+            levelManager->Update(Config::FIXED_TIMESTEP);
+            auto simulated = std::chrono::steady_clock::now();
+            levelManager->Render(*renderQueue);
+            renderQueue->Flush(nullBackend);
+            auto rendered = std::chrono::steady_clock::now();
+
+            float tickMs = std::chrono::duration<float, std::milli>(simulated - start).count();
+            float renderMs = std::chrono::duration<float, std::milli>(rendered - simulated).count();
+            tickSum += tickMs;
+            tickMax = std::max(tickMax, tickMs);
+            renderSum += renderMs;
+            renderMax = std::max(renderMax, renderMs);
+            drawCalls += renderQueue->GetLastStats().drawCalls;
+            for (int i = 0; i < SECTION_COUNT; i++) {
+                float ms = PerfOverlay::GetSectionTime((PerfSection)SECTIONS[i]);
+                sectionSum[i] += ms;
+                sectionMax[i] = std::max(sectionMax[i], ms);
+            }
+        }
+
+        int frames = std::max(ticks, 1);
+        std::printf("{\"bench\":\"stress\",\"racers\":%d,\"ticks\":%d,\"tick_ms_avg\":%.3f,\"tick_ms_max\":%.3f",
+                    levelManager->GetPlayerCount(), ticks, tickSum / frames, tickMax);
+        for (int i = 0; i < SECTION_COUNT; i++) {
+            std::printf(",\"%s_ms_avg\":%.3f,\"%s_ms_max\":%.3f",
+                        SECTION_KEYS[i], sectionSum[i] / frames, SECTION_KEYS[i], sectionMax[i]);
+        }
+        std::printf(",\"render_ms_avg\":%.3f,\"render_ms_max\":%.3f,\"draw_calls\":%.0f}\n",
+                    renderSum / frames, renderMax, drawCalls / frames);
+        std::fflush(stdout);
+    }
+
+    return nullBackend.GetInvalidCount() > 0 ? 1 : 0;
 }
 
 void GameEngine::ProcessInput() {
+    SectionTimer timer(PerfSection::INPUT);
     inputManager->Update();
 
+    if (IsKeyPressed(KEY_F3)) {
+        perfOverlay->Toggle();
+    }
+
+#ifdef ENABLE_PROFILER
+    // Dump the zones recorded so far
+    if (IsKeyPressed(KEY_F9)) {
+        std::string filename = TextFormat("trace_%d.json", (int)GetTime());
+        if (Profiler::GetInstance().WriteChromeTrace(filename)) {
+            LOG_INFO("Profiler trace written to %s", filename);
+        } else {
+            LOG_WARNING("Failed to write profiler trace %s", filename);
+        }
+    }
+#endif
+
     // Handle global inputs
     if (currentState == GameState::PLAYING) {
         if (inputManager->IsPausePressed()) {
-            SetState(GameState::PAUSED);
-            levelManager->PauseRace();
+            if (netSession) {
+                // An online race can't be paused; leaving it is the only option
+                SetState(GameState::MAIN_MENU);
+            } else {
+                SetState(GameState::PAUSED);
+                levelManager->PauseRace();
+            }
         }
     }
 
@@ -163,15 +775,19 @@ void GameEngine::ProcessInput() {
 }
 
 void GameEngine::SetState(GameState newState) {
-    LOG_INFO("State transition: " + std::to_string((int)currentState) + " -> " + std::to_string((int)newState));
+    LOG_INFO("State transition: %d -> %d", (int)currentState, (int)newState);
     
     currentState = newState;
 
+    if (netSession && newState != GameState::PLAYING && newState != GameState::GAME_OVER) {
+        EndOnlineRace();
+    }
+
     // Update UI state to match
     switch (newState) {
         case GameState::MAIN_MENU:
             uiManager->SetState(UIState::MAIN_MENU);
-            audioManager->PlayMusic("menu");
+            PlayMusic("menu");
             break;
 
         case GameState::BIKE_SELECT:
@@ -184,7 +800,7 @@ void GameEngine::SetState(GameState newState) {
 
         case GameState::PLAYING:
             uiManager->SetState(UIState::IN_GAME);
-            audioManager->PlayMusic("race");
+            PlayMusic("race");
             break;
 
         case GameState::PAUSED:
@@ -193,7 +809,7 @@ void GameEngine::SetState(GameState newState) {
 
         case GameState::GAME_OVER:
             uiManager->SetState(UIState::GAME_OVER);
-            audioManager->PlayMusic("victory");
+            PlayMusic("victory");
             break;
     }
 }
@@ -201,9 +817,42 @@ void GameEngine::SetState(GameState newState) {
 void GameEngine::Shutdown() {
     LOG_INFO("Cleaning up resources...");
 
+    if (latencyMonitor) {
+        latencyMonitor->PrintReport(headless ? "input_to_flush" : "input_to_display");
+        LOG_INFO("Input latency: %d samples, p50 %.2fms, p99 %.2fms", latencyMonitor->GetSampleCount(),
+                 latencyMonitor->GetPercentileMs(50.0f), latencyMonitor->GetPercentileMs(99.0f));
+    }
+
+    // Waits for the write, which only happens if something changed
+    if (saveGame) {
+        saveGame->Save(levelManager->GetProgress());
+        saveGame.reset();
+    }
+
+    if (headless) {
+        // No window or audio device was opened
+        LOG_INFO("Shutdown complete");
+        return;
+    }
+
     // Subsystems will be automatically destroyed via unique_ptr
     
-    // Close audio device
+    uiManager->UnloadResources();
+
+    AssetCache::GetInstance().LogReport();
+    AssetCache::GetInstance().UnloadAll();
+
+    if (sceneTargetLoaded) {
+        UnloadRenderTexture(sceneTarget);
+        sceneTargetLoaded = false;
+    }
+
+    // Close audio device (sounds and streams first), once it is up
+    if (audioStartup.valid()) {
+        audioStartup.wait();
+        audioStartup.get();
+    }
+    audioManager->Shutdown();
     CloseAudioDevice();
 
     // Close window
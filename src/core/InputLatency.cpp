@@ -0,0 +1,105 @@
+#include "core/InputLatency.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+
+namespace {
+    constexpr double FINE_BUCKET_MS = 0.05;
+    constexpr double COARSE_BUCKET_MS = 1.0;
+    constexpr double FINE_LIMIT_MS = InputLatencyMonitor::FINE_BUCKET_COUNT * FINE_BUCKET_MS;
+}
+
+InputLatencyMonitor::InputLatencyMonitor() :
+    pending{},
+    pendingCount(0),
+    droppedCount(0),
+    histogram{},
+    sampleCount(0),
+    maxMs(0.0),
+    sampleToTickMs(0.0),
+    tickToPresentMs(0.0)
+{
+}
+
+double InputLatencyMonitor::Now() {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void InputLatencyMonitor::OnConsumed(double sampleTime, double tickTime) {
+    if (pendingCount == PENDING_CAPACITY) {
+        droppedCount++;
+        return;
+    }
+    pending[pendingCount++] = {sampleTime, tickTime};
+}
+
+void InputLatencyMonitor::OnPresented(double presentTime) {
+    for (int i = 0; i < pendingCount; i++) {
+        double totalMs = (presentTime - pending[i].sampleTime) * 1000.0;
+        histogram[BucketFor(totalMs)]++;
+        sampleCount++;
+        maxMs = std::max(maxMs, totalMs);
+        sampleToTickMs += (pending[i].tickTime - pending[i].sampleTime) * 1000.0;
+        tickToPresentMs += (presentTime - pending[i].tickTime) * 1000.0;
+    }
+    pendingCount = 0;
+}
+
+void InputLatencyMonitor::Reset() {
+    pendingCount = 0;
+    droppedCount = 0;
+    histogram.fill(0);
+    sampleCount = 0;
+    maxMs = 0.0;
+    sampleToTickMs = 0.0;
+    tickToPresentMs = 0.0;
+}
+
+int InputLatencyMonitor::BucketFor(double ms) {
+    if (ms < FINE_LIMIT_MS) {
+        return std::max((int)(ms / FINE_BUCKET_MS), 0);
+    }
+    return std::min(FINE_BUCKET_COUNT + (int)((ms - FINE_LIMIT_MS) / COARSE_BUCKET_MS), BUCKET_COUNT - 1);
+}
+
+double InputLatencyMonitor::BucketStartMs(int bucket) {
+    if (bucket < FINE_BUCKET_COUNT) return bucket * FINE_BUCKET_MS;
+    return FINE_LIMIT_MS + (bucket - FINE_BUCKET_COUNT) * COARSE_BUCKET_MS;
+}
+
+float InputLatencyMonitor::GetPercentileMs(float percentile) const {
+    if (sampleCount == 0) return 0.0f;
+
+    // Samples are taken as spread evenly across the bucket holding the percentile
+    double target = std::max(1.0, percentile / 100.0 * sampleCount);
+    uint32_t seen = 0;
+    for (int bucket = 0; bucket < BUCKET_COUNT; bucket++) {
+        if (histogram[bucket] == 0) continue;
+        if (seen + histogram[bucket] >= target) {
+            double start = BucketStartMs(bucket);
+            double end = bucket == BUCKET_COUNT - 1 ? maxMs : BucketStartMs(bucket + 1);
+            double ms = start + (end - start) * (target - seen) / histogram[bucket];
+            return (float)std::min(ms, maxMs);
+        }
+        seen += histogram[bucket];
+    }
+    return (float)maxMs;
+}
+
+void InputLatencyMonitor::PrintReport(const char* label) const {
+    int samples = std::max(sampleCount, 1);
+    std::printf("{\"latency\":\"%s\",\"samples\":%d,\"dropped\":%d,\"p50_ms\":%.2f,\"p95_ms\":%.2f,"
+                "\"p99_ms\":%.2f,\"max_ms\":%.2f,\"to_tick_ms_avg\":%.2f,\"tick_to_display_ms_avg\":%.2f,"
+                "\"histogram_ms\":{",
+                label, sampleCount, droppedCount, GetPercentileMs(50.0f), GetPercentileMs(95.0f),
+                GetPercentileMs(99.0f), maxMs, sampleToTickMs / samples, tickToPresentMs / samples);
+    bool first = true;
+    for (int bucket = 0; bucket < BUCKET_COUNT; bucket++) {
+        if (histogram[bucket] == 0) continue;
+        // Keyed by the bucket's lower edge
+        std::printf("%s\"%g\":%u", first ? "" : ",", BucketStartMs(bucket), histogram[bucket]);
+        first = false;
+    }
+    std::printf("}}\n");
+    std::fflush(stdout);
+}
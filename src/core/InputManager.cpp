@@ -1,55 +1,196 @@
 #include "core/InputManager.h"
+#include "core/InputLatency.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    constexpr int SHARED = InputSnapshot::SHARED_SLOT;
+
+    // Gamepad thresholds, in quantized axis units (1/127)
+    constexpr int TRIGGER_THRESHOLD = 13;   // 0.1
+    constexpr int STEER_DEADZONE = 25;      // 0.2
+
+    // Presses older than this belong to whatever ran before the ticks
+    // resumed (menus, pause), not to a tap between two ticks
+    constexpr double TAP_WINDOW = 0.1;
+
+    // Synthetic steering holds each direction for this long (seconds)
+    constexpr double SYNTHETIC_HOLD_MIN = 0.08;
+    constexpr double SYNTHETIC_HOLD_MAX = 0.35;
+
+    int8_t QuantizeAxis(float value) {
+        return (int8_t)lroundf(std::clamp(value, -1.0f, 1.0f) * 127.0f);
+    }
+
+    bool IsDrivingAction(InputAction action) {
+        return action <= InputAction::NITRO;
+    }
+}
+
+// Player 0 (human) uses the arrow keys, player 1 WASD; menus take either
+const InputManager::KeyBinding InputManager::KEY_BINDINGS[] = {
+    {0, InputAction::ACCELERATE, KEY_UP},
+    {0, InputAction::BRAKE, KEY_DOWN},
+    {0, InputAction::TURN_LEFT, KEY_LEFT},
+    {0, InputAction::TURN_RIGHT, KEY_RIGHT},
+    {0, InputAction::NITRO, KEY_LEFT_SHIFT},
+
+    {1, InputAction::ACCELERATE, KEY_W},
+    {1, InputAction::BRAKE, KEY_S},
+    {1, InputAction::TURN_LEFT, KEY_A},
+    {1, InputAction::TURN_RIGHT, KEY_D},
+    {1, InputAction::NITRO, KEY_RIGHT_SHIFT},
+
+    {SHARED, InputAction::PAUSE, KEY_ESCAPE},
+    {SHARED, InputAction::CONFIRM, KEY_ENTER},
+    {SHARED, InputAction::CONFIRM, KEY_SPACE},
+    {SHARED, InputAction::CANCEL, KEY_ESCAPE},
+    {SHARED, InputAction::CANCEL, KEY_BACKSPACE},
+    {SHARED, InputAction::MENU_UP, KEY_W},
+    {SHARED, InputAction::MENU_UP, KEY_UP},
+    {SHARED, InputAction::MENU_DOWN, KEY_S},
+    {SHARED, InputAction::MENU_DOWN, KEY_DOWN},
+    {SHARED, InputAction::MENU_LEFT, KEY_A},
+    {SHARED, InputAction::MENU_LEFT, KEY_LEFT},
+    {SHARED, InputAction::MENU_RIGHT, KEY_D},
+    {SHARED, InputAction::MENU_RIGHT, KEY_RIGHT},
+};
+
+InputManager::InputManager() :
+    snapshot{},
+    edges{},
+    edgeCount(0),
+    tickEdgeMark{},
+    latencyMonitor(nullptr),
+    synthetic(false),
+    syntheticNextChange(0.0),
+    syntheticSteer(0)
+{
+}
+
+void InputManager::EnableSyntheticInput(uint32_t seed) {
+    synthetic = true;
+    syntheticRng.seed(seed);
+    syntheticNextChange = 0.0;
+    syntheticSteer = 0;
+}
 
 void InputManager::Update() {
-    // Input is polled per-frame by Raylib automatically
-    // This method can be used for any input state processing if needed
+    InputSnapshot next = {};
+    next.time = InputLatencyMonitor::Now();
+
+    for (const KeyBinding& binding : KEY_BINDINGS) {
+        if (IsKeyDown(binding.key)) {
+            next.down[binding.slot].set((size_t)binding.action);
+        }
+    }
+    for (int playerID = 0; playerID < Config::MAX_HUMAN_PLAYERS; playerID++) {
+        PollGamepad(playerID, next);
+    }
+    if (synthetic) {
+        PollSynthetic(next);
+    }
+
+    for (int slot = 0; slot < InputSnapshot::SLOT_COUNT; slot++) {
+        next.pressed[slot] = next.down[slot] & ~snapshot.down[slot];
+        next.released[slot] = ~next.down[slot] & snapshot.down[slot];
+        if (slot == SHARED) continue;
+
+        for (size_t action = 0; action < (size_t)InputAction::COUNT; action++) {
+            if (next.pressed[slot].test(action) || next.released[slot].test(action)) {
+                PushEdge(next.time, slot, (InputAction)action, next.pressed[slot].test(action));
+            }
+        }
+    }
+
+    snapshot = next;
+}
+
+void InputManager::PollGamepad(int playerID, InputSnapshot& next) const {
+    int gamepadID = playerID; // Gamepad 0 for player 1, Gamepad 1 for player 2
+    if (!IsGamepadAvailable(gamepadID)) {
+        return;
+    }
+
+    int8_t steer = QuantizeAxis(GetGamepadAxisMovement(gamepadID, GAMEPAD_AXIS_LEFT_X));
+    int8_t throttle = QuantizeAxis(GetGamepadAxisMovement(gamepadID, GAMEPAD_AXIS_RIGHT_TRIGGER));
+    int8_t brake = QuantizeAxis(GetGamepadAxisMovement(gamepadID, GAMEPAD_AXIS_LEFT_TRIGGER));
+    next.steer[playerID] = steer;
+    next.throttle[playerID] = throttle;
+    next.brake[playerID] = brake;
+
+    ActionBits& down = next.down[playerID];
+    if (IsGamepadButtonDown(gamepadID, GAMEPAD_BUTTON_RIGHT_TRIGGER_2) || throttle > TRIGGER_THRESHOLD) {
+        down.set((size_t)InputAction::ACCELERATE);
+    }
+    if (IsGamepadButtonDown(gamepadID, GAMEPAD_BUTTON_LEFT_TRIGGER_2) || brake > TRIGGER_THRESHOLD) {
+        down.set((size_t)InputAction::BRAKE);
+    }
+    if (steer < -STEER_DEADZONE) {
+        down.set((size_t)InputAction::TURN_LEFT);
+    }
+    if (steer > STEER_DEADZONE) {
+        down.set((size_t)InputAction::TURN_RIGHT);
+    }
+    if (IsGamepadButtonDown(gamepadID, GAMEPAD_BUTTON_RIGHT_FACE_DOWN)) {
+        down.set((size_t)InputAction::NITRO);
+    }
+}
+
+void InputManager::PollSynthetic(InputSnapshot& next) {
+    if (next.time >= syntheticNextChange) {
+        // Always a change, so every switch is an edge
+        int choice = std::uniform_int_distribution<int>(0, 1)(syntheticRng);
+        syntheticSteer = (syntheticSteer == 0) ? (choice ? 1 : -1) : (choice ? 0 : -syntheticSteer);
+        syntheticNextChange = next.time + std::uniform_real_distribution<double>(SYNTHETIC_HOLD_MIN, SYNTHETIC_HOLD_MAX)(syntheticRng);
+    }
+
+    ActionBits& down = next.down[0];
+    down.reset();
+    down.set((size_t)InputAction::ACCELERATE);
+    if (syntheticSteer < 0) down.set((size_t)InputAction::TURN_LEFT);
+    if (syntheticSteer > 0) down.set((size_t)InputAction::TURN_RIGHT);
+}
+
+int InputManager::GetSlot(int playerID, InputAction action) const {
+    if (!IsDrivingAction(action)) {
+        return SHARED;
+    }
+    return (playerID == 0) ? 0 : 1;
+}
+
+void InputManager::PushEdge(double time, int slot, InputAction action, bool pressed) {
+    edges[edgeCount % EDGE_CAPACITY] = {time, (uint8_t)slot, action, pressed};
+    edgeCount++;
 }
 
 bool InputManager::IsActionPressed(int playerID, InputAction action) const {
-    return CheckKeyboardInput(playerID, action, true) || 
-           CheckGamepadInput(playerID, action, true);
+    return snapshot.pressed[GetSlot(playerID, action)].test((size_t)action);
 }
 
 bool InputManager::IsActionDown(int playerID, InputAction action) const {
-    return CheckKeyboardInput(playerID, action, false) || 
-           CheckGamepadInput(playerID, action, false);
+    return snapshot.down[GetSlot(playerID, action)].test((size_t)action);
 }
 
 bool InputManager::IsActionReleased(int playerID, InputAction action) const {
-    // For released state (not implemented for gamepad yet)
-    const KeyMapping& keys = (playerID == 0) ? player1Keys : player2Keys;
-    
-    switch (action) {
-        case InputAction::ACCELERATE:
-            return IsKeyReleased(keys.accelerate);
-        case InputAction::BRAKE:
-            return IsKeyReleased(keys.brake);
-        case InputAction::TURN_LEFT:
-            return IsKeyReleased(keys.turnLeft);
-        case InputAction::TURN_RIGHT:
-            return IsKeyReleased(keys.turnRight);
-        case InputAction::NITRO:
-            return IsKeyReleased(keys.nitro);
-        default:
-            return false;
-    }
+    return snapshot.released[GetSlot(playerID, action)].test((size_t)action);
 }
 
 float InputManager::GetAxisValue(int playerID, InputAction action) const {
     // For turn input, return -1.0 to 1.0
     if (action == InputAction::TURN_LEFT || action == InputAction::TURN_RIGHT) {
         float value = 0.0f;
-        
+
         if (IsActionDown(playerID, InputAction::TURN_LEFT)) {
             value -= 1.0f;
         }
         if (IsActionDown(playerID, InputAction::TURN_RIGHT)) {
             value += 1.0f;
         }
-        
+
         return value;
     }
-    
+
     // For accelerate/brake, return 0.0 to 1.0
     if (action == InputAction::ACCELERATE) {
         return IsActionDown(playerID, InputAction::ACCELERATE) ? 1.0f : 0.0f;
@@ -57,87 +198,70 @@ float InputManager::GetAxisValue(int playerID, InputAction action) const {
     if (action == InputAction::BRAKE) {
         return IsActionDown(playerID, InputAction::BRAKE) ? 1.0f : 0.0f;
     }
-    
+
     return 0.0f;
 }
 
+float InputManager::GetActionAmount(int playerID, InputAction action) const {
+    if (playerID < 0 || playerID >= Config::MAX_HUMAN_PLAYERS) return 1.0f;
+
+    int axis;
+    int threshold;
+    switch (action) {
+        case InputAction::ACCELERATE: axis = snapshot.throttle[playerID]; threshold = TRIGGER_THRESHOLD; break;
+        case InputAction::BRAKE: axis = snapshot.brake[playerID]; threshold = TRIGGER_THRESHOLD; break;
+        case InputAction::TURN_LEFT: axis = -snapshot.steer[playerID]; threshold = STEER_DEADZONE; break;
+        case InputAction::TURN_RIGHT: axis = snapshot.steer[playerID]; threshold = STEER_DEADZONE; break;
+        default: return 1.0f;
+    }
+    return axis > threshold ? axis / 127.0f : 1.0f;
+}
+
+ActionBits InputManager::TakeTickActions(int playerID) {
+    int slot = GetSlot(playerID, InputAction::ACCELERATE);
+    ActionBits actions = snapshot.down[slot];
+    double tickTime = latencyMonitor ? InputLatencyMonitor::Now() : 0.0;
+
+    // Edges that fell out of the ring are lost; only the newest matter
+    uint64_t& mark = tickEdgeMark[slot];
+    mark = std::max(mark, edgeCount > EDGE_CAPACITY ? edgeCount - EDGE_CAPACITY : 0);
+    for (; mark < edgeCount; mark++) {
+        const InputEdge& edge = edges[mark % EDGE_CAPACITY];
+        if (edge.slot != slot || snapshot.time - edge.time > TAP_WINDOW) continue;
+        if (edge.pressed) {
+            actions.set((size_t)edge.action);
+        }
+        if (latencyMonitor) {
+            latencyMonitor->OnConsumed(edge.time, tickTime);
+        }
+    }
+    return actions;
+}
+
 bool InputManager::IsPausePressed() const {
-    return IsKeyPressed(KEY_ESCAPE);
+    return IsActionPressed(0, InputAction::PAUSE);
 }
 
 bool InputManager::IsConfirmPressed() const {
-    return IsKeyPressed(KEY_ENTER) || IsKeyPressed(KEY_SPACE);
+    return IsActionPressed(0, InputAction::CONFIRM);
 }
 
 bool InputManager::IsCancelPressed() const {
-    return IsKeyPressed(KEY_ESCAPE) || IsKeyPressed(KEY_BACKSPACE);
+    return IsActionPressed(0, InputAction::CANCEL);
 }
 
 bool InputManager::IsMenuUpPressed() const {
-    return IsKeyPressed(KEY_W) || IsKeyPressed(KEY_UP);
+    return IsActionPressed(0, InputAction::MENU_UP);
 }
 
 bool InputManager::IsMenuDownPressed() const {
-    return IsKeyPressed(KEY_S) || IsKeyPressed(KEY_DOWN);
+    return IsActionPressed(0, InputAction::MENU_DOWN);
 }
 
 bool InputManager::IsMenuLeftPressed() const {
-    return IsKeyPressed(KEY_A) || IsKeyPressed(KEY_LEFT);
+    return IsActionPressed(0, InputAction::MENU_LEFT);
 }
 
 bool InputManager::IsMenuRightPressed() const {
-    return IsKeyPressed(KEY_D) || IsKeyPressed(KEY_RIGHT);
-}
-
-bool InputManager::CheckKeyboardInput(int playerID, InputAction action, bool checkPressed) const {
-    const KeyMapping& keys = (playerID == 0) ? player1Keys : player2Keys;
-    
-    switch (action) {
-        case InputAction::ACCELERATE:
-            return checkPressed ? IsKeyPressed(keys.accelerate) : IsKeyDown(keys.accelerate);
-        case InputAction::BRAKE:
-            return checkPressed ? IsKeyPressed(keys.brake) : IsKeyDown(keys.brake);
-        case InputAction::TURN_LEFT:
-            return checkPressed ? IsKeyPressed(keys.turnLeft) : IsKeyDown(keys.turnLeft);
-        case InputAction::TURN_RIGHT:
-            return checkPressed ? IsKeyPressed(keys.turnRight) : IsKeyDown(keys.turnRight);
-        case InputAction::NITRO:
-            return checkPressed ? IsKeyPressed(keys.nitro) : IsKeyDown(keys.nitro);
-        case InputAction::PAUSE:
-            return IsKeyPressed(KEY_ESCAPE);
-        default:
-            return false;
-    }
-}
-
-bool InputManager::CheckGamepadInput(int playerID, InputAction action, bool checkPressed) const {
-    int gamepadID = playerID; // Gamepad 0 for player 1, Gamepad 1 for player 2
-    
-    if (!IsGamepadAvailable(gamepadID)) {
-        return false;
-    }
-    
-    switch (action) {
-        case InputAction::ACCELERATE:
-            return IsGamepadButtonDown(gamepadID, GAMEPAD_BUTTON_RIGHT_TRIGGER_2) ||
-                   GetGamepadAxisMovement(gamepadID, GAMEPAD_AXIS_RIGHT_TRIGGER) > 0.1f;
-        
-        case InputAction::BRAKE:
-            return IsGamepadButtonDown(gamepadID, GAMEPAD_BUTTON_LEFT_TRIGGER_2) ||
-                   GetGamepadAxisMovement(gamepadID, GAMEPAD_AXIS_LEFT_TRIGGER) > 0.1f;
-        
-        case InputAction::TURN_LEFT:
-            return GetGamepadAxisMovement(gamepadID, GAMEPAD_AXIS_LEFT_X) < -0.2f;
-        
-        case InputAction::TURN_RIGHT:
-            return GetGamepadAxisMovement(gamepadID, GAMEPAD_AXIS_LEFT_X) > 0.2f;
-        
-        case InputAction::NITRO:
-            return checkPressed ? 
-                IsGamepadButtonPressed(gamepadID, GAMEPAD_BUTTON_RIGHT_FACE_DOWN) :
-                IsGamepadButtonDown(gamepadID, GAMEPAD_BUTTON_RIGHT_FACE_DOWN);
-        
-        default:
-            return false;
-    }
+    return IsActionPressed(0, InputAction::MENU_RIGHT);
 }
@@ -0,0 +1,105 @@
+#include "core/ResolutionScaler.h"
+#include "utils/Config.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    constexpr float SMOOTHING = 0.1f;            // EMA weight of the newest sample
+    constexpr float DOWNSCALE_THRESHOLD = 1.05f; // Fraction of budget that counts as "over"
+    constexpr float UPSCALE_THRESHOLD = 0.80f;   // Fraction of budget that counts as "comfortably under"
+    constexpr int FRAMES_TO_DOWNSCALE = 10;      // React quickly to sustained overload
+    constexpr int FRAMES_TO_UPSCALE = 90;        // Recover slowly so we don't oscillate
+    constexpr int COOLDOWN_FRAMES = 30;          // Let the average settle after a change
+    constexpr float SCALE_STEP = 0.05f;          // Scales are quantized to 5% steps
+    constexpr float MAX_STEP = 0.15f;            // Largest change applied in one go
+}
+
+ResolutionScaler::ResolutionScaler() :
+    enabled(Config::DYNAMIC_RESOLUTION),
+    budgetMs(Config::FRAME_TIME_BUDGET_MS),
+    minScale(Config::MIN_RENDER_SCALE),
+    maxScale(Config::MAX_RENDER_SCALE),
+    scale(Config::MAX_RENDER_SCALE),
+    smoothedMs(0.0f),
+    hasSample(false),
+    framesOverBudget(0),
+    framesUnderBudget(0),
+    cooldownFrames(0)
+{
+}
+
+void ResolutionScaler::Configure(float newBudgetMs, float newMinScale, float newMaxScale) {
+    budgetMs = std::max(newBudgetMs, 1.0f);
+    minScale = std::clamp(newMinScale, SCALE_STEP, 1.0f);
+    maxScale = std::clamp(newMaxScale, minScale, 1.0f);
+    scale = std::clamp(scale, minScale, maxScale);
+    framesOverBudget = 0;
+    framesUnderBudget = 0;
+}
+
+void ResolutionScaler::SetEnabled(bool enable) {
+    enabled = enable;
+    if (!enabled) {
+        scale = maxScale;
+    }
+    framesOverBudget = 0;
+    framesUnderBudget = 0;
+}
+
+bool ResolutionScaler::AddFrameSample(float frameTimeMs) {
+    if (!hasSample) {
+        smoothedMs = frameTimeMs;
+        hasSample = true;
+    } else {
+        smoothedMs += (frameTimeMs - smoothedMs) * SMOOTHING;
+    }
+
+    if (!enabled) return false;
+
+    if (cooldownFrames > 0) {
+        cooldownFrames--;
+        return false;
+    }
+
+    // Count consecutive frames outside the hysteresis band
+    if (smoothedMs > budgetMs * DOWNSCALE_THRESHOLD) {
+        framesOverBudget++;
+        framesUnderBudget = 0;
+    } else if (smoothedMs < budgetMs * UPSCALE_THRESHOLD) {
+        framesUnderBudget++;
+        framesOverBudget = 0;
+    } else {
+        framesOverBudget = 0;
+        framesUnderBudget = 0;
+    }
+
+    bool shouldDown = framesOverBudget >= FRAMES_TO_DOWNSCALE && scale > minScale;
+    bool shouldUp = framesUnderBudget >= FRAMES_TO_UPSCALE && scale < maxScale;
+    if (!shouldDown && !shouldUp) return false;
+
+    // Fill cost goes with pixel count (scale squared), so take the square root
+    // of the budget ratio to estimate the scale that would just fit.
+    float target = scale * std::sqrt(budgetMs / std::max(smoothedMs, 0.1f));
+    float step = std::clamp(target - scale, -MAX_STEP, MAX_STEP);
+    if (shouldDown) step = std::min(step, -SCALE_STEP);
+    if (shouldUp) step = std::clamp(step, SCALE_STEP, MAX_STEP);
+
+    float newScale = std::round((scale + step) / SCALE_STEP) * SCALE_STEP;
+    newScale = std::clamp(newScale, minScale, maxScale);
+
+    framesOverBudget = 0;
+    framesUnderBudget = 0;
+    cooldownFrames = COOLDOWN_FRAMES;
+
+    if (std::fabs(newScale - scale) < 0.001f) return false;
+    scale = newScale;
+    return true;
+}
+
+int ResolutionScaler::GetScaledWidth(int nativeWidth) const {
+    return std::max(1, (int)std::lround(nativeWidth * scale));
+}
+
+int ResolutionScaler::GetScaledHeight(int nativeHeight) const {
+    return std::max(1, (int)std::lround(nativeHeight * scale));
+}
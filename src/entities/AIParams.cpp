@@ -0,0 +1,152 @@
+#include "entities/AIParams.h"
+#include "utils/AssetArchive.h"
+#include "utils/Config.h"
+#include "utils/Logger.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+namespace {
+    const char* const SECTION_NAMES[AIParams::DIFFICULTY_COUNT] = {"easy", "medium", "hard"};
+
+    // Per difficulty (easy, medium, hard)
+    constexpr float DEFAULT_CORNER_SPEED[] = {0.85f, 0.93f, 1.0f};
+    constexpr float DEFAULT_NITRO_STRAIGHT[] = {60.0f, 40.0f, 25.0f};
+
+    std::string Trim(const std::string& text) {
+        size_t first = text.find_first_not_of(" \t\r");
+        if (first == std::string::npos) return "";
+        size_t last = text.find_last_not_of(" \t\r");
+        return text.substr(first, last - first + 1);
+    }
+}
+
+const AIParams::Field AIParams::FIELDS[AIParams::FIELD_COUNT] = {
+    {"lookahead_base", &AIParams::lookaheadBase, 1.0f, 12.0f},
+    {"lookahead_time", &AIParams::lookaheadTime, 0.0f, 2.0f},
+    {"steer_gain", &AIParams::steerGain, 0.5f, 6.0f},
+    {"corner_speed", &AIParams::cornerSpeed, 0.6f, 1.15f},
+    {"nitro_straight", &AIParams::nitroStraight, 5.0f, 100.0f},
+    {"side_avoid", &AIParams::sideAvoid, 0.0f, 2.0f},
+    {"ahead_avoid", &AIParams::aheadAvoid, 0.0f, 2.5f},
+    {"lift_time", &AIParams::liftTime, 0.0f, 3.0f},
+    {"brake_time", &AIParams::brakeTime, 0.0f, 2.0f},
+};
+
+AIParams AIParams::Defaults(int difficulty) {
+    int level = std::clamp(difficulty, 1, DIFFICULTY_COUNT) - 1;
+    AIParams params;
+    params.lookaheadBase = 4.0f;
+    params.lookaheadTime = 0.8f;
+    params.steerGain = 2.5f;   // Full lock at ~23 degrees off
+    params.cornerSpeed = DEFAULT_CORNER_SPEED[level];
+    params.nitroStraight = DEFAULT_NITRO_STRAIGHT[level];
+    params.sideAvoid = 0.8f;
+    params.aheadAvoid = 1.2f;
+    params.liftTime = 1.0f;
+    params.brakeTime = 0.5f;
+    return params;
+}
+
+AIParamsTable AIParamsFile::Defaults() {
+    AIParamsTable table;
+    for (int i = 0; i < AIParams::DIFFICULTY_COUNT; i++) {
+        table[i] = AIParams::Defaults(i + 1);
+    }
+    return table;
+}
+
+const char* AIParamsFile::GetSectionName(int difficulty) {
+    return SECTION_NAMES[std::clamp(difficulty, 1, AIParams::DIFFICULTY_COUNT) - 1];
+}
+
+bool AIParamsFile::Load(const std::string& path, AIParamsTable& table) {
+    std::ifstream file(path);
+    if (!file) {
+        LOG_WARNING("No AI parameters at %s, using built-in defaults", path);
+        return false;
+    }
+    std::ostringstream text;
+    text << file.rdbuf();
+    return Parse(text.str(), path, table);
+}
+
+bool AIParamsFile::LoadAsset(AIParamsTable& table) {
+    std::vector<unsigned char> text;
+    if (!AssetArchive::GetInstance().Load(Config::AI_PARAMS_ASSET, text)) {
+        LOG_WARNING("No AI parameters (%s), using built-in defaults", Config::AI_PARAMS_ASSET);
+        return false;
+    }
+    return Parse(std::string(text.begin(), text.end()), Config::AI_PARAMS_ASSET, table);
+}
+
+bool AIParamsFile::Parse(const std::string& text, const std::string& source, AIParamsTable& table) {
+    std::istringstream file(text);
+    int section = -1;
+    int lineNumber = 0;
+    std::string line;
+    while (std::getline(file, line)) {
+        lineNumber++;
+        line = Trim(line.substr(0, line.find('#')));
+        if (line.empty()) continue;
+
+        if (line.front() == '[' && line.back() == ']') {
+            std::string name = Trim(line.substr(1, line.size() - 2));
+            const char* const* found = std::find(std::begin(SECTION_NAMES), std::end(SECTION_NAMES), name);
+            section = (found != std::end(SECTION_NAMES)) ? (int)(found - std::begin(SECTION_NAMES)) : -1;
+            if (section < 0) {
+                LOG_WARNING("%s:%d: unknown difficulty [%s]", source, lineNumber, name);
+            }
+            continue;
+        }
+
+        size_t equals = line.find('=');
+        if (section < 0 || equals == std::string::npos) {
+            LOG_WARNING("%s:%d: ignored", source, lineNumber);
+            continue;
+        }
+        std::string key = Trim(line.substr(0, equals));
+        std::string value = Trim(line.substr(equals + 1));
+        const AIParams::Field* field = std::find_if(std::begin(AIParams::FIELDS), std::end(AIParams::FIELDS),
+                                                    [&](const AIParams::Field& f) { return key == f.name; });
+        char* end = nullptr;
+        float number = std::strtof(value.c_str(), &end);
+        if (field == std::end(AIParams::FIELDS) || value.empty() || *end != '\0') {
+            LOG_WARNING("%s:%d: bad setting '%s'", source, lineNumber, line);
+            continue;
+        }
+        table[section].*(field->member) = std::clamp(number, field->min, field->max);
+    }
+
+    LOG_INFO("Loaded AI parameters from %s", source);
+    return true;
+}
+
+bool AIParamsFile::Save(const std::string& path, const AIParamsTable& table, const std::string& comment) {
+    std::ostringstream text;
+    std::istringstream commentLines(comment);
+    std::string line;
+    while (std::getline(commentLines, line)) {
+        text << "# " << line << "\n";
+    }
+
+    char value[32];
+    for (int i = 0; i < AIParams::DIFFICULTY_COUNT; i++) {
+        text << "\n[" << SECTION_NAMES[i] << "]\n";
+        for (const AIParams::Field& field : AIParams::FIELDS) {
+            std::snprintf(value, sizeof(value), "%.4g", table[i].*(field.member));
+            text << field.name << " = " << value << "\n";
+        }
+    }
+
+    std::ofstream file(path);
+    file << text.str();
+    if (!file) {
+        LOG_ERROR("Failed to write AI parameters: %s", path);
+        return false;
+    }
+    return true;
+}
@@ -1,7 +1,7 @@
 #include "entities/Bike.h"
 #include "utils/Config.h"
 #include "utils/Logger.h"
-#include "rlgl.h" // For transformation functions
+#include "render/RenderQueue.h"
 #include "raymath.h"
 #include <cmath>
 
@@ -12,32 +12,32 @@ Bike::Bike() :
     rotation(0.0f),
     onGround(true),
     acceleration({0, 0, 0}),
+    turnInput(0.0f),
     isBoosted(false),
     boostMultiplier(1.0f),
     boostTimer(0.0f),
-    color(WHITE),
-    modelLoaded(false)
+    color(WHITE)
 {
-    // Initialize base stats
-    baseStats.maxSpeed = Config::BIKE_BASE_SPEED;
-    baseStats.acceleration = Config::BIKE_BASE_ACCELERATION;
-    baseStats.turnRate = Config::BIKE_BASE_TURN_RATE;
-    baseStats.brakeForce = Config::BIKE_BASE_BRAKE_FORCE;
-    baseStats.handling = 1.0f;
-    baseStats.weight = 1.0f;
-    
+    baseStats = GetBaseStats();
     stats = baseStats;
 }
 
+BikeStats Bike::GetBaseStats() {
+    BikeStats base;
+    base.maxSpeed = Config::BIKE_BASE_SPEED;
+    base.acceleration = Config::BIKE_BASE_ACCELERATION;
+    base.turnRate = Config::BIKE_BASE_TURN_RATE;
+    base.brakeForce = Config::BIKE_BASE_BRAKE_FORCE;
+    base.handling = 1.0f;
+    base.weight = 1.0f;
+    return base;
+}
+
 float Bike::GetSpeed() const {
     return Vector3Length(velocity);
 }
 
-Bike::~Bike() {
-    if (modelLoaded) {
-        UnloadModel(model);
-    }
-}
+Bike::~Bike() = default;
 
 void Bike::Initialize(Vector3 startPosition, Color bikeColor) {
     position = startPosition;
@@ -50,19 +50,45 @@ void Bike::Initialize(Vector3 startPosition, Color bikeColor) {
 }
 
 void Bike::LoadModel() {
-    // Create a simple bike model using basic shapes
-    // For now, we'll use a cube as a placeholder
-    Mesh cubeMesh = GenMeshCube(2.0f, 1.0f, 3.5f);
-    model = LoadModelFromMesh(cubeMesh);
-    model.materials[0].maps[MATERIAL_MAP_DIFFUSE].color = color;
-    modelLoaded = true;
+    // A cube as a placeholder, the same for every bike (tint with the
+    // bike's colour when drawing); empty in headless runs
+    model = AssetCache::GetInstance().GetCube({2.0f, 1.0f, 3.5f});
 }
 
 void Bike::SetDirection(Vector3 dir) {
     direction = Vector3Normalize(dir);
 }
 
+void Bike::SaveState(State& state) const {
+    state.position = position;
+    state.velocity = velocity;
+    state.direction = direction;
+    state.rotation = rotation;
+    state.onGround = onGround;
+    state.acceleration = acceleration;
+    state.turnInput = turnInput;
+    state.stats = stats;
+    state.isBoosted = isBoosted;
+    state.boostMultiplier = boostMultiplier;
+    state.boostTimer = boostTimer;
+}
+
+void Bike::LoadState(const State& state) {
+    position = state.position;
+    velocity = state.velocity;
+    direction = state.direction;
+    rotation = state.rotation;
+    onGround = state.onGround;
+    acceleration = state.acceleration;
+    turnInput = state.turnInput;
+    stats = state.stats;
+    isBoosted = state.isBoosted;
+    boostMultiplier = state.boostMultiplier;
+    boostTimer = state.boostTimer;
+}
+
 void Bike::Update(float deltaTime) {
+    ApplyTurn(deltaTime);
     UpdatePhysics(deltaTime);
     UpdateRotation(deltaTime);
     
@@ -106,54 +132,64 @@ void Bike::UpdateRotation(float deltaTime) {
     }
 }
 
-void Bike::Render() const {
-    // Save current matrix state
-    rlPushMatrix();
-    
-    // Translate to bike's position
-    rlTranslatef(position.x, position.y, position.z);
-    
-    // Rotate around Y-axis based on bike's direction
-    rlRotatef(rotation, 0.0f, 1.0f, 0.0f);
+void Bike::RenderShape(RenderQueue& queue, Vector3 position, float rotation,
+                       Color color, unsigned char alpha) {
+    auto tint = [alpha](Color c) {
+        c.a = (unsigned char)(c.a * alpha / 255);
+        return c;
+    };
+
+    // Parts are placed in the bike's local frame (position + rotation around Y)
+    queue.SetTransform(position, rotation);
     
     // Draw bike with wheels and body
     Vector3 bodyOffset = {0, 0.5f, 0}; // Body is slightly above ground
     
     // Main bike body (elongated box)
-    DrawCube(bodyOffset, 0.6f, 0.8f, 2.0f, color);
-    DrawCubeWires(bodyOffset, 0.6f, 0.8f, 2.0f, BLACK);
+    queue.DrawCube(bodyOffset, 0.6f, 0.8f, 2.0f, tint(color));
+    queue.DrawCubeWires(bodyOffset, 0.6f, 0.8f, 2.0f, tint(BLACK));
     
     // Seat
     Vector3 seatOffset = {0, 0.5f + 0.5f, -0.3f};
-    DrawCube(seatOffset, 0.5f, 0.3f, 0.6f, ColorBrightness(color, -0.3f));
+    queue.DrawCube(seatOffset, 0.5f, 0.3f, 0.6f, tint(ColorBrightness(color, -0.3f)));
     
     // Handlebars
     Vector3 handleOffset = {0, 0.5f + 0.3f, 0.8f};
-    DrawCube(handleOffset, 1.0f, 0.2f, 0.2f, DARKGRAY);
+    queue.DrawCube(handleOffset, 1.0f, 0.2f, 0.2f, tint(DARKGRAY));
     
     // Front wheel
     Vector3 frontWheelOffset = {0, 0, 1.2f};
-    DrawCylinder(frontWheelOffset, 0.6f, 0.6f, 0.3f, 16, DARKGRAY);
-    DrawCylinderWires(frontWheelOffset, 0.6f, 0.6f, 0.3f, 16, BLACK);
+    queue.DrawCylinder(frontWheelOffset, 0.6f, 0.6f, 0.3f, 16, tint(DARKGRAY));
+    queue.DrawCylinderWires(frontWheelOffset, 0.6f, 0.6f, 0.3f, 16, tint(BLACK));
     
     // Back wheel  
     Vector3 backWheelOffset = {0, 0, -1.2f};
-    DrawCylinder(backWheelOffset, 0.6f, 0.6f, 0.3f, 16, DARKGRAY);
-    DrawCylinderWires(backWheelOffset, 0.6f, 0.6f, 0.3f, 16, BLACK);
+    queue.DrawCylinder(backWheelOffset, 0.6f, 0.6f, 0.3f, 16, tint(DARKGRAY));
+    queue.DrawCylinderWires(backWheelOffset, 0.6f, 0.6f, 0.3f, 16, tint(BLACK));
     
-    // Restore matrix state
-    rlPopMatrix();
+    queue.ResetTransform();
+}
+
+void Bike::RenderLowDetail(RenderQueue& queue, Vector3 position, float rotation, Color color) {
+    // Body and both wheels in one box
+    queue.SetTransform(position, rotation);
+    queue.DrawCube({0, 0.5f, 0}, 0.6f, 1.2f, 3.6f, color);
+    queue.ResetTransform();
+}
+
+void Bike::Render(RenderQueue& queue) const {
+    RenderShape(queue, position, rotation, color);
     
     // Draw debug info (velocity vector)
     #ifdef DEBUG
     Vector3 arrowStart = position;
     arrowStart.y += 2.5f;
     Vector3 arrowEnd = Vector3Add(arrowStart, Vector3Scale(direction, 1.5f));
-    DrawLine3D(arrowStart, arrowEnd, color);
-    DrawSphere(arrowEnd, 0.15f, color);
+    queue.DrawLine(arrowStart, arrowEnd, color);
+    queue.DrawSphere(arrowEnd, 0.15f, color);
     
     Vector3 velEndPoint = Vector3Add(position, Vector3Scale(velocity, 0.3f));
-    DrawLine3D(position, velEndPoint, GREEN);
+    queue.DrawLine(position, velEndPoint, GREEN);
     #endif
 }
 
@@ -176,7 +212,14 @@ void Bike::Brake(float amount) {
 }
 
 void Bike::Turn(float direction) {
-    // direction: -1.0 (left) to 1.0 (right)
+    // direction: -1.0 (left) to 1.0 (right). Applied in Update() so the turn
+    // uses the simulation step rather than the render frame time.
+    turnInput = direction;
+}
+
+void Bike::ApplyTurn(float deltaTime) {
+    float direction = turnInput;
+    turnInput = 0.0f;
     if (fabsf(direction) < 0.01f) return;
     
     float currentSpeed = Vector3Length(velocity);
@@ -185,7 +228,7 @@ void Bike::Turn(float direction) {
     // Consistent turn rate regardless of speed for predictable handling
     // Small speed influence keeps it realistic but doesn't cause randomness
     float speedInfluence = fminf(currentSpeed / 10.0f, 1.0f); // Gentle speed influence
-    float turnAmount = direction * stats.turnRate * speedInfluence * stats.handling * GetFrameTime();
+    float turnAmount = direction * stats.turnRate * speedInfluence * stats.handling * deltaTime;
     
     // Rotate direction vector smoothly
     float angleRad = turnAmount * DEG2RAD;
@@ -214,7 +257,7 @@ void Bike::ApplyUpgrade(const std::string& upgradeType, int level) {
         stats.turnRate = baseStats.turnRate * multiplier;
     }
     
-    LOG_INFO("Applied upgrade: " + upgradeType + " level " + std::to_string(level));
+    LOG_INFO("Applied upgrade: %s level %d", upgradeType, level);
 }
 
 void Bike::ApplySpeedBoost(float multiplier, float duration) {
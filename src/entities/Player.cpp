@@ -1,12 +1,25 @@
+#include <algorithm>
 #include <string>
 #include <vector>
 #include <memory>
 #include <cmath>
 #include "entities/Player.h"
 #include "core/GameEngine.h"
+#include "level/RacingLine.h"
 #include "utils/Logger.h"
 #include "raymath.h"
 
+namespace {
+    // Tunable numbers are in AIParams; these are structural
+    constexpr int AI_BRAKE_LOOKAHEAD = 2;        // Samples; covers a tick of reaction
+    constexpr float AI_BRAKE_MARGIN = 0.5f;      // Over target by this much before braking
+    constexpr float AI_BRAKE_RANGE = 4.0f;       // Full brake this far over target
+    constexpr float AI_JOIN_DISTANCE = 6.0f;     // Further off the line: head for the next checkpoint
+    constexpr int AI_MISSED_SAMPLES = 30;        // Past a checkpoint's spot without it counting
+    constexpr float AI_AHEAD_DEGREES = 30.0f;    // Rays this close to the heading can brake
+    constexpr float AI_THREAT_CLOSING = 1.0f;    // m/s closing for full threat; slower is a nudge
+}
+
 Player::Player(int id, const std::string& name) :
     playerID(id),
     playerName(name),
@@ -16,16 +29,10 @@ Player::Player(int id, const std::string& name) :
     currentLapTime(0.0f),
     totalRaceTime(0.0f),
     racePosition(1),
-    raceFinished(false)
+    raceFinished(false),
+    lineSample(-1)
 {
     bike = std::make_unique<Bike>();
-    
-    // Initialize stats
-    stats.totalRacesWon = 0;
-    stats.totalRacesPlayed = 0;
-    stats.bestLapTime = 999999.0f;
-    stats.upgradesUnlocked = 0;
-    stats.currentPoints = 0;
 }
 
 void Player::Initialize(Vector3 startPosition, Color bikeColor) {
@@ -46,20 +53,19 @@ void Player::Update(float deltaTime) {
     }
 }
 
-void Player::Render() const {
+void Player::Render(RenderQueue& queue) const {
     if (bike) {
-        bike->Render();
+        bike->Render(queue);
     }
 }
 
 void Player::StartRace() {
+    // Logged once for the whole field by LevelManager::StartRace
     ResetRace();
-    LOG_INFO("Player " + std::to_string(playerID) + " (" + playerName + ") started race");
 }
 
 void Player::FinishLap(float lapTime) {
-    LOG_INFO("Player " + std::to_string(playerID) + " finished lap " + 
-             std::to_string(currentLap) + " in " + std::to_string(lapTime) + "s");
+    LOG_INFO("Player %d finished lap %d in %.2fs", playerID, currentLap, lapTime);
     
     // Update best lap time
     if (lapTime < stats.bestLapTime) {
@@ -84,8 +90,7 @@ void Player::FinishRace(int position) {
         stats.currentPoints += 50; // Second place gets 50 points
     }
     
-    LOG_INFO("Player " + std::to_string(playerID) + " finished race in position " + 
-             std::to_string(position) + " with time " + std::to_string(totalRaceTime) + "s");
+    LOG_INFO("Player %d finished race in position %d with time %.2fs", playerID, position, totalRaceTime);
 }
 
 void Player::ResetRace() {
@@ -95,6 +100,7 @@ void Player::ResetRace() {
     totalRaceTime = 0.0f;
     racePosition = 1;
     raceFinished = false;
+    lineSample = -1;
     
     // Reset bike velocity
     if (bike) {
@@ -102,6 +108,41 @@ void Player::ResetRace() {
     }
 }
 
+void Player::SaveState(State& state) const {
+    bike->SaveState(state.bike);
+    state.currentLap = currentLap;
+    state.checkpointsPassed = checkpointsPassed;
+    state.currentLapTime = currentLapTime;
+    state.totalRaceTime = totalRaceTime;
+    state.racePosition = racePosition;
+    state.raceFinished = raceFinished;
+    state.stats = stats;
+    state.lineSample = lineSample;
+}
+
+void Player::LoadState(const State& state) {
+    bike->LoadState(state.bike);
+    currentLap = state.currentLap;
+    checkpointsPassed = state.checkpointsPassed;
+    currentLapTime = state.currentLapTime;
+    totalRaceTime = state.totalRaceTime;
+    racePosition = state.racePosition;
+    raceFinished = state.raceFinished;
+    stats = state.stats;
+    lineSample = state.lineSample;
+}
+
+RacerInput RacerInput::FromAxes(float accel, float brake, float turn, bool nitro) {
+    auto quantize = [](float value) {
+        return (int8_t)lroundf(Clamp(value, -1.0f, 1.0f) * 127.0f);
+    };
+    return {quantize(accel), quantize(brake), quantize(turn), nitro};
+}
+
+void Player::ProcessInput(const RacerInput& input) {
+    ProcessInput(input.accelerate / 127.0f, input.brake / 127.0f, input.turn / 127.0f, input.nitro);
+}
+
 void Player::ProcessInput(float accelerateInput, float brakeInput, float turnInput, bool nitroPressed) {
     if (!bike || raceFinished) return;
     
@@ -126,37 +167,96 @@ void Player::ProcessInput(float accelerateInput, float brakeInput, float turnInp
     }
 }
 
-void Player::UpdateAI(float deltaTime, const Vector3& nextCheckpointPos, int difficulty) {
-    if (!bike) return;
-    
-    Vector3 bikePos = bike->GetPosition();
-    Vector3 bikeDir = bike->GetDirection();
-    
-    // Calculate direction to target
-    Vector3 targetDir = Vector3Subtract(nextCheckpointPos, bikePos);
-    targetDir.y = 0;
-    targetDir = Vector3Normalize(targetDir);
-    
-    // Calculate alignment with target
-    float dot = Vector3DotProduct(bikeDir, targetDir);
-    Vector3 cross = Vector3CrossProduct(bikeDir, targetDir);
-    
-    // SIMPLIFIED AI: Just race forward!
-    float accel = 1.0f; // Always full throttle
+AISensors AISensors::Clear() {
+    AISensors sensors;
+    for (int ray = 0; ray < RAY_COUNT; ray++) {
+        sensors.clearance[ray] = 1.0f;
+        sensors.closingSpeed[ray] = 0.0f;
+    }
+    return sensors;
+}
+
+RacerInput Player::DriveAI(const RacingLine& line, const AIParams& params, const AISensors& sensors) {
+    if (!bike || line.IsEmpty()) return {};
+
+    Vector3 position = bike->GetPosition();
+    float speed = bike->GetSpeed();
+    lineSample = line.Follow(lineSample, position, checkpointsPassed);
+
+    // Steer at a point further along the line the faster we're going. Off
+    // the line (on the grid, after a crash) or past a checkpoint that didn't
+    // count, head for the checkpoint's spot on the line instead.
+    int checkpointSample = line.GetCheckpointSample(checkpointsPassed);
+    int pastCheckpoint = line.StepsBetween(checkpointSample, lineSample);
+    Vector3 offLine = Vector3Subtract(line.GetSample(lineSample).position, position);
+    bool recovering = (pastCheckpoint > 0 && pastCheckpoint < AI_MISSED_SAMPLES) ||
+                      Vector3LengthSqr({offLine.x, 0, offLine.z}) > AI_JOIN_DISTANCE * AI_JOIN_DISTANCE;
+    int lookahead = (int)((params.lookaheadBase + speed * params.lookaheadTime) / RacingLine::SAMPLE_SPACING);
+    int targetSample = recovering ? checkpointSample : line.Advance(lineSample, lookahead);
+
+    Vector3 toTarget = Vector3Subtract(line.GetSample(targetSample).position, position);
+    toTarget.y = 0;
+    Vector3 heading = bike->GetDirection();
+    float forward = Vector3DotProduct(heading, toTarget);
+    float side = Vector3CrossProduct(heading, toTarget).y;
+    float turn = Clamp(atan2f(side, forward) * params.steerGain, -1.0f, 1.0f);
+
+    // A target inside the turning circle would just be circled forever;
+    // run straight until it can be reached
+    float radius = line.GetTurnRadius();
+    float fromCentre = fabsf(side) - radius;
+    if (recovering && forward * forward + fromCentre * fromCentre < radius * radius) {
+        turn = 0.0f;
+    }
+
+    // Hold the line's target speed; it already starts slowing for a bend
+    // at the brake point
+    const RacingLineSample& upcoming = line.GetSample(line.Advance(lineSample, AI_BRAKE_LOOKAHEAD));
+    float targetSpeed = upcoming.targetSpeed * params.cornerSpeed;
+    float accel = speed < targetSpeed ? 1.0f : 0.0f;
     float brake = 0.0f;
-    float turn = 0.0f;
-    bool nitro = false;
-    
-    // Only turn if significantly off-course
-    if (fabsf(cross.y) > 0.15f) {
-        turn = (cross.y > 0) ? -0.3f : 0.3f; // Gentle correction
+    if (speed > targetSpeed + AI_BRAKE_MARGIN) {
+        brake = Clamp((speed - targetSpeed) / AI_BRAKE_RANGE, 0.0f, 1.0f);
     }
-    
-    // Use nitro frequently based on difficulty
-    int nitroChance = (difficulty == 1) ? 5 : (difficulty == 3) ? 20 : 10;
-    if ((rand() % 100) < nitroChance) {
-        nitro = true;
+
+    // Sensors: lean away from anything closing in on one side; with the
+    // way ahead blocked, go for whichever side is clearer. Lift, then
+    // brake, as contact ahead gets close.
+    float avoid = 0.0f;
+    float leftClearance = 0.0f;
+    float rightClearance = 0.0f;
+    float aheadThreat = 0.0f;
+    float timeToContact = INFINITY;
+    for (int ray = 0; ray < AISensors::RAY_COUNT; ray++) {
+        float angle = AISensors::RayAngle(ray);
+        float clearance = sensors.clearance[ray];
+        float closing = sensors.closingSpeed[ray];
+        float threat = (1.0f - clearance) * Clamp(closing / AI_THREAT_CLOSING, 0.0f, 1.0f);
+
+        if (angle < 0.0f) {
+            leftClearance += clearance;
+            avoid += threat * params.sideAvoid;
+        } else if (angle > 0.0f) {
+            rightClearance += clearance;
+            avoid -= threat * params.sideAvoid;
+        } else {
+            aheadThreat = threat;
+        }
+        if (fabsf(angle) <= AI_AHEAD_DEGREES && closing > AI_THREAT_CLOSING) {
+            timeToContact = std::min(timeToContact, clearance * AISensors::RANGE / closing);
+        }
     }
-    
-    ProcessInput(accel, brake, turn, nitro);
+    avoid += (rightClearance >= leftClearance ? 1.0f : -1.0f) * aheadThreat * params.aheadAvoid;
+    turn = Clamp(turn + avoid, -1.0f, 1.0f);
+    if (timeToContact < params.liftTime) {
+        accel = 0.0f;
+    }
+    if (timeToContact < params.brakeTime) {
+        brake = std::max(brake, 1.0f - timeToContact / params.brakeTime);
+    }
+
+    // Nitro only with a long enough straight ahead to use it
+    bool nitro = upcoming.straightAhead >= params.nitroStraight && accel > 0.0f;
+
+    return RacerInput::FromAxes(accel, brake, turn, nitro);
 }
@@ -1,4 +1,5 @@
 #include "level/Checkpoint.h"
+#include "render/RenderQueue.h"
 
 Checkpoint::Checkpoint(Vector3 position, float radius, int id) :
     position(position),
@@ -15,8 +16,8 @@ bool Checkpoint::CheckPassage(Vector3 bikePosition, float bikeRadius) const {
     return distance < (radius + bikeRadius);
 }
 
-void Checkpoint::Render() const {
+void Checkpoint::Render(RenderQueue& queue) const {
     // Debug visualization
-    DrawCircle3D(position, radius, {1, 0, 0}, 90.0f, isActive ? GREEN : RED);
-    DrawCylinder(position, radius, radius, 0.2f, 16, isActive ? ColorAlpha(GREEN, 0.3f) : ColorAlpha(RED, 0.3f));
+    queue.DrawRing(position, radius, isActive ? GREEN : RED);
+    queue.DrawCylinder(position, radius, radius, 0.2f, 16, isActive ? ColorAlpha(GREEN, 0.3f) : ColorAlpha(RED, 0.3f));
 }
@@ -1,5 +1,6 @@
 #include "level/Obstacle.h"
 #include "entities/Bike.h"
+#include "render/RenderQueue.h"
 #include "utils/Logger.h"
 
 Obstacle::Obstacle(Vector3 position, ObstacleType type, Vector3 size) :
@@ -8,9 +9,16 @@ Obstacle::Obstacle(Vector3 position, ObstacleType type, Vector3 size) :
     type(type),
     moveSpeed(2.0f),
     moveDistance(5.0f),
-    currentMoveOffset(0.0f),
-    modelLoaded(false)
+    currentMoveOffset(0.0f)
 {
+    // Set colors based on type
+    switch (type) {
+        case ObstacleType::STATIC_BARRIER: color = RED; break;
+        case ObstacleType::MOVING_PLATFORM: color = ORANGE; break;
+        case ObstacleType::RAMP: color = BROWN; break;
+        default: color = GRAY; break;
+    }
+    
     // Set bounding box
     boundingBox.min = Vector3Subtract(position, Vector3Scale(size, 0.5f));
     boundingBox.max = Vector3Add(position, Vector3Scale(size, 0.5f));
@@ -21,40 +29,9 @@ Obstacle::Obstacle(Vector3 position, ObstacleType type, Vector3 size) :
     LoadModel();
 }
 
-Obstacle::~Obstacle() {
-    if (modelLoaded) {
-        UnloadModel(model);
-    }
-}
-
 void Obstacle::LoadModel() {
-    // Create different shapes based on obstacle type
-    Mesh mesh;
-    
-    switch (type) {
-        case ObstacleType::STATIC_BARRIER:
-            mesh = GenMeshCube(size.x, size.y, size.z);
-            break;
-        case ObstacleType::MOVING_PLATFORM:
-            mesh = GenMeshCube(size.x, size.y, size.z);
-            break;
-        case ObstacleType::RAMP:
-            mesh = GenMeshCube(size.x, size.y, size.z);
-            break;
-    }
-    
-    model = LoadModelFromMesh(mesh);
-    
-    // Set colors based on type
-    Color color = GRAY;
-    switch (type) {
-        case ObstacleType::STATIC_BARRIER: color = RED; break;
-        case ObstacleType::MOVING_PLATFORM: color = ORANGE; break;
-        case ObstacleType::RAMP: color = BROWN; break;
-    }
-    
-    model.materials[0].maps[MATERIAL_MAP_DIFFUSE].color = color;
-    modelLoaded = true;
+    // Every type is a box for now; empty in headless runs
+    model = AssetCache::GetInstance().GetCube(size);
 }
 
 void Obstacle::Update(float deltaTime) {
@@ -63,6 +40,18 @@ void Obstacle::Update(float deltaTime) {
     }
 }
 
+void Obstacle::SaveState(State& state) const {
+    state.position = position;
+    state.currentMoveOffset = currentMoveOffset;
+}
+
+void Obstacle::LoadState(const State& state) {
+    position = state.position;
+    currentMoveOffset = state.currentMoveOffset;
+    boundingBox.min = Vector3Subtract(position, Vector3Scale(size, 0.5f));
+    boundingBox.max = Vector3Add(position, Vector3Scale(size, 0.5f));
+}
+
 void Obstacle::UpdateMoving(float deltaTime) {
     currentMoveOffset += moveSpeed * deltaTime;
     
@@ -76,14 +65,17 @@ void Obstacle::UpdateMoving(float deltaTime) {
     boundingBox.max = Vector3Add(position, Vector3Scale(size, 0.5f));
 }
 
-void Obstacle::Render() const {
-    if (!modelLoaded) return;
-    
-    DrawModel(model, position, 1.0f, WHITE);
+void Obstacle::Render(RenderQueue& queue) const {
+    if (model) {
+        queue.DrawModel(*model.Get(), position, 1.0f, color);
+    } else {
+        // Same shape without a GPU mesh (headless runs)
+        queue.DrawCube(position, size.x, size.y, size.z, color);
+    }
     
     // Debug: draw bounding box
     #ifdef DEBUG
-    DrawBoundingBox(boundingBox, PURPLE);
+    queue.DrawBoundingBox(boundingBox, PURPLE);
     #endif
 }
 
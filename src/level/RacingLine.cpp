@@ -0,0 +1,343 @@
+#include "level/RacingLine.h"
+#include "level/Track.h"
+#include "entities/Bike.h"
+#include "physics/PhysicsEngine.h"
+#include "utils/Config.h"
+#include "render/RenderQueue.h"
+#include "raymath.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    constexpr int SPLINE_STEPS = 16;             // Points per spline segment before resampling
+    constexpr float COARSE_SPACING = 4.0f;       // The line is relaxed at this spacing
+    constexpr int RELAX_ITERATIONS = 1500;
+    constexpr float RELAX_RATE = 0.1f;           // Above 1/8 the smoothing step is unstable
+    constexpr float CHECKPOINT_SLACK = 0.7f;     // Share of a checkpoint's reach the line may cut
+    constexpr float BIKE_RADIUS = 2.0f;          // As in LevelManager::CheckCollisions
+    constexpr float OBSTACLE_CLEARANCE = 1.0f;
+    constexpr float ARENA_RADIUS = 90.0f;        // Physics resets bikes 100 from the origin
+
+    constexpr int TURN_SETTLE_TICKS = 300;       // Full lock until the turn is steady...
+    constexpr int TURN_MEASURE_TICKS = 120;      // ...then measured over this many
+    constexpr float FULL_TURN_SPEED = 10.0f;     // Bike::ApplyTurn reaches its full rate here
+    constexpr float CORNER_MARGIN = 0.8f;        // Share of the turning circle a bend may need
+    constexpr float BRAKE_MARGIN = 0.7f;         // Share of the brake force a brake point assumes
+    constexpr float STRAIGHT_CURVATURE = 0.02f;  // 1/m; gentler bends count as straight
+
+    constexpr float RESYNC_DISTANCE = 8.0f;      // Further from the tracked sample: search again
+    constexpr int MAX_FOLLOW_STEPS = 8;
+
+    Vector2 XZ(Vector3 v) { return {v.x, v.z}; }
+
+    float DistanceSqXZ(Vector3 a, Vector3 b) {
+        float dx = a.x - b.x;
+        float dz = a.z - b.z;
+        return dx * dx + dz * dz;
+    }
+
+    int Wrap(int index, int count) {
+        index %= count;
+        return index < 0 ? index + count : index;
+    }
+
+    // Bike::UpdateRotation pulls the heading back towards the velocity and
+    // friction bleeds speed each tick, so the turning circle is much wider
+    // than turnRate alone suggests. Drive a bike at full lock and measure it.
+    float MeasureTurnRadius(const BikeStats& stats) {
+        PhysicsEngine physics;
+        Bike bike;
+        bike.SetStats(stats);
+        float dt = Config::FIXED_TIMESTEP;
+        auto tick = [&]() {
+            bike.Accelerate(1.0f);
+            bike.Turn(1.0f);
+            bike.Update(dt);
+            physics.ApplyPhysics(&bike, dt);
+        };
+
+        for (int i = 0; i < TURN_SETTLE_TICKS; i++) {
+            tick();
+        }
+        float distance = 0.0f;
+        float turned = 0.0f;
+        for (int i = 0; i < TURN_MEASURE_TICKS; i++) {
+            Vector3 position = bike.GetPosition();
+            float rotation = bike.GetRotation();
+            tick();
+            distance += sqrtf(DistanceSqXZ(position, bike.GetPosition()));
+            float delta = fmodf(bike.GetRotation() - rotation + 540.0f, 360.0f) - 180.0f;
+            turned += fabsf(delta) * DEG2RAD;
+        }
+        return turned > 0.0f ? distance / turned : 0.0f;
+    }
+
+    // A polyline plus the point index each checkpoint is pinned to
+    struct Path {
+        std::vector<Vector2> points;
+        std::vector<int> pins;
+    };
+
+    // Catmull-Rom through every point; pins move to the matching new point
+    Path Densify(const Path& path, bool closed) {
+        int count = (int)path.points.size();
+        auto point = [&](int i) {
+            return closed ? path.points[Wrap(i, count)] : path.points[std::clamp(i, 0, count - 1)];
+        };
+
+        Path dense;
+        int segments = closed ? count : count - 1;
+        for (int s = 0; s < segments; s++) {
+            for (int step = 0; step < SPLINE_STEPS; step++) {
+                dense.points.push_back(GetSplinePointCatmullRom(point(s - 1), point(s), point(s + 1), point(s + 2),
+                                                                step / (float)SPLINE_STEPS));
+            }
+        }
+        if (!closed) {
+            dense.points.push_back(path.points.back());
+        }
+        for (int pin : path.pins) {
+            dense.pins.push_back(pin * SPLINE_STEPS);
+        }
+        return dense;
+    }
+
+    // Evenly spaced points along the polyline, pins carried by arc length
+    Path Resample(const Path& path, bool closed, float spacing) {
+        int count = (int)path.points.size();
+        int edges = closed ? count : count - 1;
+        std::vector<float> distance(count + 1, 0.0f);
+        for (int i = 0; i < edges; i++) {
+            distance[i + 1] = distance[i] + Vector2Distance(path.points[i], path.points[(i + 1) % count]);
+        }
+        float length = distance[edges];
+        int segments = std::max((int)lroundf(length / spacing), closed ? 3 : 1);
+        float step = length / segments;
+
+        Path result;
+        int edge = 0;
+        int outputCount = closed ? segments : segments + 1;
+        for (int k = 0; k < outputCount; k++) {
+            float s = k * step;
+            while (edge < edges - 1 && distance[edge + 1] < s) {
+                edge++;
+            }
+            float edgeLength = distance[edge + 1] - distance[edge];
+            float t = edgeLength > 0.0f ? Clamp((s - distance[edge]) / edgeLength, 0.0f, 1.0f) : 0.0f;
+            result.points.push_back(Vector2Lerp(path.points[edge], path.points[(edge + 1) % count], t));
+        }
+        for (int pin : path.pins) {
+            int index = (int)lroundf(distance[pin] / step);
+            result.pins.push_back(closed ? index % segments : std::min(index, segments));
+        }
+        return result;
+    }
+
+    // Moves a point sideways (across the line) until it clears the circle
+    void PushOutOfCircle(Vector2& point, Vector2 tangent, Vector2 centre, float radius) {
+        Vector2 offset = Vector2Subtract(point, centre);
+        if (Vector2LengthSqr(offset) >= radius * radius) return;
+
+        Vector2 normal = {-tangent.y, tangent.x};
+        float along = Vector2DotProduct(offset, tangent);
+        float across = Vector2DotProduct(offset, normal);
+        float needed = sqrtf(std::max(radius * radius - along * along, 0.0f));
+        float target = across < 0.0f ? -needed : needed;
+        point = Vector2Add(point, Vector2Scale(normal, target - across));
+    }
+
+    // Smooths towards the least-curvature path (gradient steps on the fourth
+    // difference) while holding it inside the checkpoints and clear of the
+    // obstacles and the arena edge
+    void Relax(Path& path, bool closed, const Track& track) {
+        const auto& checkpoints = track.GetCheckpoints();
+        struct Circle {
+            Vector2 centre;
+            float radius;
+        };
+        std::vector<Circle> obstacles;
+        for (const auto& obstacle : track.GetObstacles()) {
+            BoundingBox box = obstacle->GetBoundingBox();
+            Vector2 halfSize = Vector2Scale(Vector2Subtract(XZ(box.max), XZ(box.min)), 0.5f);
+            obstacles.push_back({XZ(obstacle->GetPosition()), Vector2Length(halfSize) + BIKE_RADIUS + OBSTACLE_CLEARANCE});
+        }
+
+        std::vector<Vector2>& points = path.points;
+        int count = (int)points.size();
+        if (count < 5) return;
+        auto at = [&](int i) { return points[closed ? Wrap(i, count) : std::clamp(i, 0, count - 1)]; };
+
+        std::vector<Vector2> next(count);
+        for (int iteration = 0; iteration < RELAX_ITERATIONS; iteration++) {
+            for (int i = 0; i < count; i++) {
+                // Open lines keep their first and last two points
+                if (!closed && (i < 2 || i > count - 3)) {
+                    next[i] = points[i];
+                    continue;
+                }
+                Vector2 d4 = Vector2Add(Vector2Add(at(i - 2), at(i + 2)),
+                                        Vector2Subtract(Vector2Scale(points[i], 6.0f),
+                                                        Vector2Scale(Vector2Add(at(i - 1), at(i + 1)), 4.0f)));
+                next[i] = Vector2Subtract(points[i], Vector2Scale(d4, RELAX_RATE));
+            }
+            points.swap(next);
+
+            for (int i = 0; i < count; i++) {
+                Vector2 tangent = Vector2Normalize(Vector2Subtract(at(i + 1), at(i - 1)));
+                for (const Circle& obstacle : obstacles) {
+                    PushOutOfCircle(points[i], tangent, obstacle.centre, obstacle.radius);
+                }
+                if (Vector2Length(points[i]) > ARENA_RADIUS) {
+                    points[i] = Vector2Scale(Vector2Normalize(points[i]), ARENA_RADIUS);
+                }
+            }
+
+            for (size_t c = 0; c < path.pins.size(); c++) {
+                Vector2& point = points[path.pins[c]];
+                Vector2 centre = XZ(checkpoints[c]->GetPosition());
+                float slack = (checkpoints[c]->GetRadius() + BIKE_RADIUS) * CHECKPOINT_SLACK;
+                Vector2 offset = Vector2Subtract(point, centre);
+                if (Vector2Length(offset) > slack) {
+                    point = Vector2Add(centre, Vector2Scale(Vector2Normalize(offset), slack));
+                }
+            }
+        }
+    }
+}
+
+RacingLine::RacingLine() :
+    closed(false),
+    turnRadius(0.0f)
+{
+}
+
+void RacingLine::Clear() {
+    samples.clear();
+    checkpointSamples.clear();
+    closed = false;
+    turnRadius = 0.0f;
+}
+
+void RacingLine::Build(const Track& track, const BikeStats& stats) {
+    Clear();
+    const auto& checkpoints = track.GetCheckpoints();
+    if (checkpoints.empty()) return;
+
+    // Laps run the finish back into the first checkpoint; a single lap
+    // runs from the grid to the finish
+    closed = track.GetRequiredLaps() > 1 && checkpoints.size() >= 3;
+    Path controls;
+    if (!closed) {
+        controls.points.push_back(XZ(track.GetSpawnPoint(0)));
+    }
+    for (const auto& checkpoint : checkpoints) {
+        controls.pins.push_back((int)controls.points.size());
+        controls.points.push_back(XZ(checkpoint->GetPosition()));
+    }
+
+    Path coarse = Resample(Densify(controls, closed), closed, COARSE_SPACING);
+    Relax(coarse, closed, track);
+    Path line = Resample(Densify(coarse, closed), closed, SAMPLE_SPACING);
+
+    int count = (int)line.points.size();
+    float height = checkpoints[0]->GetPosition().y;
+    samples.resize(count);
+    for (int i = 0; i < count; i++) {
+        samples[i].position = {line.points[i].x, height, line.points[i].y};
+    }
+    checkpointSamples = line.pins;
+
+    // Corner speeds. Below FULL_TURN_SPEED the turn rate scales with speed,
+    // so the turning circle stays the measured one and slowing further
+    // doesn't help; above it the circle grows with speed.
+    turnRadius = MeasureTurnRadius(stats);
+    float usableRadius = turnRadius / CORNER_MARGIN;
+    std::vector<float> curvature(count, 0.0f);
+    for (int i = 0; i < count; i++) {
+        if (!closed && (i < 2 || i > count - 3)) continue;
+        Vector2 before = Vector2Subtract(line.points[i], line.points[Wrap(i - 2, count)]);
+        Vector2 after = Vector2Subtract(line.points[Wrap(i + 2, count)], line.points[i]);
+        float angle = atan2f(before.x * after.y - before.y * after.x, Vector2DotProduct(before, after));
+        curvature[i] = fabsf(angle) / (2.0f * SAMPLE_SPACING);
+    }
+    for (int i = 0; i < count; i++) {
+        float speed = stats.maxSpeed;
+        if (curvature[i] > 0.0f) {
+            speed = Clamp(FULL_TURN_SPEED / (curvature[i] * usableRadius), FULL_TURN_SPEED, stats.maxSpeed);
+        }
+        samples[i].targetSpeed = speed;
+    }
+
+    // Brake points and straights, worked backwards (twice round a loop so
+    // the finish sees the bends after it)
+    float brakeDecel = stats.brakeForce * BRAKE_MARGIN;
+    float nextSpeed = samples[count - 1].targetSpeed;
+    float nextStraight = 0.0f;
+    for (int pass = 0; pass < (closed ? 2 : 1); pass++) {
+        for (int i = count - 1; i >= 0; i--) {
+            RacingLineSample& sample = samples[i];
+            sample.targetSpeed = std::min(sample.targetSpeed,
+                                          sqrtf(nextSpeed * nextSpeed + 2.0f * brakeDecel * SAMPLE_SPACING));
+            sample.straightAhead = curvature[i] > STRAIGHT_CURVATURE ? 0.0f
+                                 : std::min(nextStraight + SAMPLE_SPACING, GetLength());
+            nextSpeed = sample.targetSpeed;
+            nextStraight = sample.straightAhead;
+        }
+    }
+}
+
+int RacingLine::Advance(int index, int steps) const {
+    int count = (int)samples.size();
+    return closed ? Wrap(index + steps, count) : std::clamp(index + steps, 0, count - 1);
+}
+
+int RacingLine::StepsBetween(int from, int to) const {
+    return closed ? Wrap(to - from, (int)samples.size()) : to - from;
+}
+
+int RacingLine::Follow(int index, Vector3 position, int nextCheckpoint) const {
+    if (samples.empty()) return 0;
+    if (index < 0 || DistanceSqXZ(position, GetSample(index).position) > RESYNC_DISTANCE * RESYNC_DISTANCE) {
+        return FindNearest(position, nextCheckpoint);
+    }
+
+    index = Advance(index, 0);
+    float distanceSq = DistanceSqXZ(position, samples[index].position);
+    for (int step = 0; step < MAX_FOLLOW_STEPS; step++) {
+        int next = Advance(index, 1);
+        float nextDistanceSq = DistanceSqXZ(position, samples[next].position);
+        if (next == index || nextDistanceSq >= distanceSq) break;
+        index = next;
+        distanceSq = nextDistanceSq;
+    }
+    return index;
+}
+
+int RacingLine::FindNearest(Vector3 position, int nextCheckpoint) const {
+    // Only the stretch between the last checkpoint and the next, so a line
+    // that crosses itself can't put the racer on the wrong branch
+    int checkpoint = std::clamp(nextCheckpoint, 0, (int)checkpointSamples.size() - 1);
+    int end = checkpointSamples[checkpoint];
+    int start = checkpoint > 0 ? checkpointSamples[checkpoint - 1] : (closed ? checkpointSamples.back() : 0);
+
+    int best = end;
+    float bestDistanceSq = DistanceSqXZ(position, samples[end].position);
+    for (int i = start; i != end; i = Advance(i, 1)) {
+        float distanceSq = DistanceSqXZ(position, samples[i].position);
+        if (distanceSq < bestDistanceSq) {
+            best = i;
+            bestDistanceSq = distanceSq;
+        }
+    }
+    return best;
+}
+
+void RacingLine::RenderDebug(RenderQueue& queue) const {
+    int count = (int)samples.size();
+    int segments = closed ? count : count - 1;
+    for (int i = 0; i < segments; i++) {
+        // Orange where the target speed drops: the brake zones
+        Color color = samples[i].targetSpeed < samples[Advance(i, 1)].targetSpeed ? ORANGE : SKYBLUE;
+        queue.DrawLine(samples[i].position, samples[Advance(i, 1)].position, color);
+    }
+}
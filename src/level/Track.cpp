@@ -1,8 +1,10 @@
 #include "level/Track.h"
+#include "entities/Bike.h"
+#include "render/RenderQueue.h"
 #include "utils/Logger.h"
 #include <cmath>
 
-Track::Track() : modelLoaded(false) {
+Track::Track() {
     trackData.name = "Unnamed Track";
     trackData.difficulty = 1;
     trackData.requiredLaps = 3;
@@ -12,7 +14,7 @@ Track::Track() : modelLoaded(false) {
 }
 
 bool Track::LoadTrack(const std::string& trackName) {
-    LOG_INFO("Loading track: " + trackName);
+    LOG_INFO("Loading track: %s", trackName);
     
     if (trackName == "Beginner Circuit" || trackName == "1") {
         CreateBeginnerTrack();
@@ -24,6 +26,9 @@ bool Track::LoadTrack(const std::string& trackName) {
         CreateBeginnerTrack(); // Default
     }
     
+    racingLine.Build(*this, Bike::GetBaseStats());
+    LOG_INFO("Racing line: %d samples, %.0fm", racingLine.GetSampleCount(), racingLine.GetLength());
+
     LoadTrackModel();
     return true;
 }
@@ -56,7 +61,7 @@ void Track::CreateBeginnerTrack() {
     obstacles.push_back(std::make_unique<Obstacle>(Vector3{0, 1, 20}, ObstacleType::RAMP, Vector3{6, 1, 3}));
     // Total: 3 obstacles
     
-    LOG_INFO("Beginner track created with " + std::to_string(checkpoints.size()) + " checkpoints and " + std::to_string(obstacles.size()) + " obstacles");
+    LOG_INFO("Beginner track created with %zu checkpoints and %zu obstacles", checkpoints.size(), obstacles.size());
 }
 
 void Track::CreateIntermediateTrack() {
@@ -86,7 +91,7 @@ void Track::CreateIntermediateTrack() {
     obstacles.push_back(std::make_unique<Obstacle>(Vector3{-8, 1, 12}, ObstacleType::RAMP, Vector3{5, 1, 3}));
     // Total: 6 obstacles
     
-    LOG_INFO("Intermediate track created with " + std::to_string(checkpoints.size()) + " checkpoints and " + std::to_string(obstacles.size()) + " obstacles");
+    LOG_INFO("Intermediate track created with %zu checkpoints and %zu obstacles", checkpoints.size(), obstacles.size());
 }
 
 void Track::CreateAdvancedTrack() {
@@ -123,18 +128,18 @@ void Track::CreateAdvancedTrack() {
     obstacles.push_back(std::make_unique<Obstacle>(Vector3{-10, 1, 15}, ObstacleType::RAMP, Vector3{5, 1, 3}));
     // Total: 12 obstacles
     
-    LOG_INFO("Advanced track created with " + std::to_string(checkpoints.size()) + " checkpoints and " + std::to_string(obstacles.size()) + " obstacles");
+    LOG_INFO("Advanced track created with %zu checkpoints and %zu obstacles", checkpoints.size(), obstacles.size());
 }
 
 void Track::LoadTrackModel() {
-    // Create a larger ground plane for the track (200x200 instead of 100x100)
-    Mesh planeMesh = GenMeshPlane(200.0f, 200.0f, 10, 10);
-    trackModel = LoadModelFromMesh(planeMesh);
-    trackModel.materials[0].maps[MATERIAL_MAP_DIFFUSE].color = DARKGRAY;
-    modelLoaded = true;
-    
     trackBounds.min = {-100, 0, -100};
     trackBounds.max = {100, 5, 100};
+    
+    // No GPU context in headless runs
+    if (!IsWindowReady()) return;
+    
+    // Create a larger ground plane for the track (200x200 instead of 100x100)
+    trackModel = AssetCache::GetInstance().GetPlane(200.0f, 200.0f, 10, 10);
 }
 
 void Track::Update(float deltaTime) {
@@ -144,9 +149,11 @@ void Track::Update(float deltaTime) {
     }
 }
 
-void Track::Render() const {
-    if (modelLoaded) {
-        DrawModel(trackModel, {0, 0, 0}, 1.0f, WHITE);
+void Track::Render(RenderQueue& queue) const {
+    if (trackModel) {
+        queue.DrawModel(*trackModel.Get(), {0, 0, 0}, 1.0f, DARKGRAY);
+    } else {
+        queue.DrawPlane({0, 0, 0}, {200.0f, 200.0f}, DARKGRAY);
     }
     
     // Draw MASSIVE finish line at the last checkpoint (now the actual finish)
@@ -156,40 +163,41 @@ void Track::Render() const {
         // Draw giant red and white checkered finish line
         for (int i = -10; i <= 10; i++) {
             Color stripColor = (i % 2 == 0) ? RED : WHITE;
-            DrawCube({finishPos.x + i * 3.0f, 0.2f, finishPos.z}, 3.0f, 0.4f, 10.0f, stripColor);
+            queue.DrawCube({finishPos.x + i * 3.0f, 0.2f, finishPos.z}, 3.0f, 0.4f, 10.0f, stripColor);
         }
         
         // Draw tall finish line pillars
-        DrawCylinder({finishPos.x - 30.0f, 15.0f, finishPos.z}, 2.0f, 2.0f, 30.0f, 16, Fade(RED, 0.8f));
-        DrawCylinder({finishPos.x + 30.0f, 15.0f, finishPos.z}, 2.0f, 2.0f, 30.0f, 16, Fade(RED, 0.8f));
+        queue.DrawCylinder({finishPos.x - 30.0f, 15.0f, finishPos.z}, 2.0f, 2.0f, 30.0f, 16, Fade(RED, 0.8f));
+        queue.DrawCylinder({finishPos.x + 30.0f, 15.0f, finishPos.z}, 2.0f, 2.0f, 30.0f, 16, Fade(RED, 0.8f));
         
         // Giant "FINISH" banner
-        DrawCube({finishPos.x, 30.0f, finishPos.z}, 70.0f, 3.0f, 2.0f, GOLD);
-        DrawCube({finishPos.x, 32.0f, finishPos.z}, 65.0f, 2.0f, 1.5f, RED);
+        queue.DrawCube({finishPos.x, 30.0f, finishPos.z}, 70.0f, 3.0f, 2.0f, GOLD);
+        queue.DrawCube({finishPos.x, 32.0f, finishPos.z}, 65.0f, 2.0f, 1.5f, RED);
         
         // Also draw start line at first checkpoint
         Vector3 startPos = checkpoints[0]->GetPosition();
         for (int i = -8; i <= 8; i++) {
             Color stripColor = (i % 2 == 0) ? GREEN : WHITE;
-            DrawCube({startPos.x + i * 2.5f, 0.1f, startPos.z}, 2.5f, 0.2f, 5.0f, stripColor);
+            queue.DrawCube({startPos.x + i * 2.5f, 0.1f, startPos.z}, 2.5f, 0.2f, 5.0f, stripColor);
         }
-        DrawCube({startPos.x, 8.0f, startPos.z}, 40.0f, 2.0f, 1.0f, LIME);
+        queue.DrawCube({startPos.x, 8.0f, startPos.z}, 40.0f, 2.0f, 1.0f, LIME);
     }
     
     // Render obstacles
     for (const auto& obstacle : obstacles) {
-        obstacle->Render();
+        obstacle->Render(queue);
     }
 }
 
-void Track::RenderDebug() const {
+void Track::RenderDebug(RenderQueue& queue) const {
     // Render checkpoints
     for (const auto& checkpoint : checkpoints) {
-        checkpoint->Render();
+        checkpoint->Render(queue);
     }
+    racingLine.RenderDebug(queue);
     
     // Render track bounds
-    DrawBoundingBox(trackBounds, BLUE);
+    queue.DrawBoundingBox(trackBounds, BLUE);
 }
 
 bool Track::CheckCheckpoint(int playerID, Vector3 bikePosition, int currentCheckpoint) {
@@ -204,3 +212,7 @@ bool Track::CheckCheckpoint(int playerID, Vector3 bikePosition, int currentCheck
 Vector3 Track::GetSpawnPoint(int playerID) const {
     return (playerID == 0) ? trackData.player1SpawnPoint : trackData.player2SpawnPoint;
 }
+
+void Track::AddObstacle(Vector3 position, ObstacleType type, Vector3 size) {
+    obstacles.push_back(std::make_unique<Obstacle>(position, type, size));
+}
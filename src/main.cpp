@@ -1,8 +1,17 @@
 #include "core/GameEngine.h"
 #include "utils/Logger.h"
 #include "utils/Config.h"
+#include "utils/StartupTimeline.h"
+#include "net/NetLoopbackTest.h"
+#include "systems/LevelManager.h"
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+int main(int argc, char** argv) {
+    StartupTimeline::GetInstance().Mark("main");
 
-int main() {
     // Initialize logger
     Logger::GetInstance().Init("game.log");
     LOG_INFO("=== Bike Race Game Starting ===");
@@ -10,10 +19,112 @@ int main() {
     // Get game engine instance
     GameEngine& engine = GameEngine::GetInstance();
 
+    // Headless render submission benchmark: --render-bench [frames per track]
+    if (argc > 1 && std::string(argv[1]) == "--render-bench") {
+        int frames = (argc > 2) ? std::atoi(argv[2]) : 600;
+        engine.InitializeHeadless();
+        int result = engine.RunRenderBenchmark(frames);
+        engine.Shutdown();
+        return result;
+    }
+
+    // Headless scaling test: --stress [ticks] [racer counts...]
+    if (argc > 1 && std::string(argv[1]) == "--stress") {
+        int ticks = (argc > 2) ? std::atoi(argv[2]) : 600;
+        std::vector<int> racerCounts;
+        for (int i = 3; i < argc; i++) {
+            racerCounts.push_back(std::atoi(argv[i]));
+        }
+        if (racerCounts.empty()) {
+            racerCounts = {1000, 5000};
+        }
+        Logger::GetInstance().SetConsoleOutput(false);
+        engine.InitializeHeadless();
+        int result = engine.RunStressTest(racerCounts, ticks);
+        engine.Shutdown();
+        Logger::GetInstance().Shutdown();
+        return result;
+    }
+
+    // Unattended input latency run with scripted steering:
+    // --latency-test [frames] [--headless]
+    if (argc > 1 && std::string(argv[1]) == "--latency-test") {
+        int frames = (argc > 2) ? std::atoi(argv[2]) : 3600;
+        bool headless = (argc > 3) && std::string(argv[3]) == "--headless";
+        Logger::GetInstance().SetConsoleOutput(false);
+        if (headless) {
+            engine.InitializeHeadless();
+        } else {
+            engine.Initialize();
+        }
+        int result = engine.RunLatencyTest(frames);
+        engine.Shutdown();
+        Logger::GetInstance().Shutdown();
+        return result;
+    }
+
+    // Headless replay of a recorded race: --replay <file>
+    if (argc > 2 && std::string(argv[1]) == "--replay") {
+        engine.InitializeHeadless();
+        int result = engine.RunReplay(argv[2]);
+        engine.Shutdown();
+        Logger::GetInstance().Shutdown();
+        return result;
+    }
+
+    // Time to the first interactive frame, and what startup spent it on:
+    // --startup-report [max frames]
+    if (argc > 1 && std::string(argv[1]) == "--startup-report") {
+        int frames = (argc > 2) ? std::atoi(argv[2]) : 600;
+        Logger::GetInstance().SetConsoleOutput(false);
+        engine.Initialize();
+        int result = engine.RunStartupReport(frames);
+        engine.Shutdown();
+        Logger::GetInstance().Shutdown();
+        return result;
+    }
+
+    // Rollback netcode check over loopback:
+    // --net-test [latency ms] [loss %] [jitter ms] [ticks]
+    if (argc > 1 && std::string(argv[1]) == "--net-test") {
+        LinkSettings link = {};
+        link.latencyMs = (argc > 2) ? (float)std::atof(argv[2]) : 0.0f;
+        link.lossPercent = (argc > 3) ? (float)std::atof(argv[3]) : 0.0f;
+        link.jitterMs = (argc > 4) ? (float)std::atof(argv[4]) : 0.0f;
+        int ticks = (argc > 5) ? std::atoi(argv[5]) : 3600;
+        Logger::GetInstance().SetConsoleOutput(false);
+        int result = RunNetLoopbackTest(link, ticks);
+        Logger::GetInstance().Shutdown();
+        return result;
+    }
+
     // Initialize engine
     LOG_INFO("Initializing game engine...");
     engine.Initialize();
 
+    // Measure input latency while playing; the histogram is printed on exit
+    if (argc > 1 && std::string(argv[1]) == "--latency") {
+        engine.EnableLatencyMonitor();
+    }
+
+    // Offline race size: --racers <count>. Online races keep the default
+    // grid, which both peers build without exchanging it.
+    if (argc > 2 && std::string(argv[1]) == "--racers") {
+        engine.GetLevelManager()->SetRacerCount(std::atoi(argv[2]));
+    }
+
+    // Online race: --host <port> [track] or --join <ip:port>
+    if (argc > 2 && std::string(argv[1]) == "--host") {
+        int track = (argc > 3) ? std::atoi(argv[3]) : 1;
+        if (!engine.HostOnlineRace((uint16_t)std::atoi(argv[2]), std::max(1, std::min(track, 3)))) {
+            LOG_ERROR("Could not host an online race");
+        }
+    } else if (argc > 2 && std::string(argv[1]) == "--join") {
+        if (!engine.JoinOnlineRace(argv[2])) {
+            LOG_ERROR("Could not join an online race");
+        }
+    }
+
     // Run game loop
     LOG_INFO("Starting game loop...");
     engine.Run();
@@ -23,5 +134,6 @@ int main() {
     engine.Shutdown();
 
     LOG_INFO("=== Bike Race Game Terminated ===");
+    Logger::GetInstance().Shutdown();
     return 0;
 }
@@ -0,0 +1,55 @@
+#include "net/LinkConditioner.h"
+#include <cstring>
+
+LinkConditioner::LinkConditioner(uint32_t seed) :
+    settings{},
+    rng(seed),
+    queued(0)
+{
+}
+
+void LinkConditioner::Configure(const LinkSettings& linkSettings) {
+    settings = linkSettings;
+}
+
+void LinkConditioner::Send(UdpSocket& socket, const NetAddress& to, const uint8_t* data, size_t size, double now) {
+    if (size > UdpSocket::MAX_PACKET_SIZE) return;
+
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    if (settings.lossPercent > 0.0f && unit(rng) * 100.0f < settings.lossPercent) {
+        return;
+    }
+
+    float delayMs = settings.latencyMs + settings.jitterMs * unit(rng);
+    if (delayMs <= 0.0f) {
+        socket.Send(to, data, size);
+        return;
+    }
+
+    if (queued == queue.size()) {
+        queue.emplace_back();
+    }
+    DelayedPacket& packet = queue[queued++];
+    packet.releaseTime = now + delayMs / 1000.0;
+    packet.to = to;
+    packet.size = size;
+    std::memcpy(packet.data, data, size);
+}
+
+void LinkConditioner::Flush(UdpSocket& socket, double now) {
+    size_t i = 0;
+    while (i < queued) {
+        DelayedPacket& packet = queue[i];
+        if (packet.releaseTime > now) {
+            i++;
+            continue;
+        }
+        socket.Send(packet.to, packet.data, packet.size);
+
+        // Swap-remove; order doesn't matter since packets carry their ticks
+        if (i != queued - 1) {
+            packet = queue[queued - 1];
+        }
+        queued--;
+    }
+}
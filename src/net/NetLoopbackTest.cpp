@@ -0,0 +1,117 @@
+#include "net/NetLoopbackTest.h"
+#include "net/RollbackSession.h"
+#include "core/InputManager.h"
+#include "physics/PhysicsEngine.h"
+#include "utils/Config.h"
+#include "utils/Logger.h"
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+namespace {
+    constexpr uint32_t SEED = 4242;
+    constexpr int CONNECT_TIMEOUT_TICKS = 600;
+    constexpr int SEGMENT_TICKS = 20;   // Scripted steering changes this often
+
+    // Stand-in for a player: full throttle, steering that changes every
+    // segment, so the peer's predictions are regularly wrong
+    RacerInput ScriptedInput(int player, uint32_t tick) {
+        uint32_t h = (tick / SEGMENT_TICKS) * 0x9E3779B9u ^ (uint32_t)(player + 1) * 0x85EBCA6Bu;
+        h ^= h >> 15;
+        h *= 0x2C1B3C6Du;
+        h ^= h >> 12;
+        float turn = (float)((int)(h % 3) - 1);
+        bool brake = (h >> 8) % 8 == 0;
+        return RacerInput::FromAxes(brake ? 0.0f : 1.0f, brake ? 1.0f : 0.0f, turn, false);
+    }
+
+    // One peer: its own simulation plus the session driving it
+    struct Peer {
+        PhysicsEngine physics;
+        InputManager input;
+        LevelManager level;
+        RollbackSession session;
+        std::vector<uint64_t> checksums;
+
+        Peer() : session(level) {
+            level.Initialize(&physics, &input);
+            session.SetChecksumLog(&checksums);
+        }
+    };
+}
+
+int RunNetLoopbackTest(const LinkSettings& link, int ticks) {
+    Peer host;
+    Peer client;
+    host.session.SetLinkSettings(link);
+    client.session.SetLinkSettings(link);
+
+    NetAddress hostAddress = {0x7F000001, 0};
+    if (!host.session.Host(0, {SEED, 1, 0})) {
+        return 1;
+    }
+    hostAddress.port = host.session.GetLocalPort();
+    if (!client.session.Join(hostAddress)) {
+        return 1;
+    }
+
+    double now = 0.0;
+    for (int i = 0; i < CONNECT_TIMEOUT_TICKS && !(host.session.IsConnected() && client.session.IsConnected()); i++) {
+        now += Config::FIXED_TIMESTEP;
+        host.session.Poll(now);
+        client.session.Poll(now);
+    }
+    if (!host.session.IsConnected() || !client.session.IsConnected()) {
+        LOG_ERROR("Loopback peers failed to connect");
+        return 1;
+    }
+
+    int rollbackFrames = 0;
+    int maxDepth = 0;
+    long long resimTicks = 0;
+    double resimMsTotal = 0.0;
+    float resimMsMax = 0.0f;
+    int stalls = 0;
+
+    for (int frame = 0; frame < ticks; frame++) {
+        now += Config::FIXED_TIMESTEP;
+        for (Peer* peer : {&host, &client}) {
+            RollbackSession& session = peer->session;
+            session.BeginFrame();
+            session.Poll(now);
+            uint32_t inputTick = session.GetCurrentTick() + RollbackSession::INPUT_DELAY;
+            session.AdvanceTick(ScriptedInput(session.GetLocalPlayer(), inputTick), now);
+
+            const RollbackStats& stats = session.GetFrameStats();
+            rollbackFrames += stats.rollbacks > 0 ? 1 : 0;
+            maxDepth = std::max(maxDepth, stats.rollbackDepth);
+            resimTicks += stats.resimulatedTicks;
+            resimMsTotal += stats.resimMs;
+            resimMsMax = std::max(resimMsMax, stats.resimMs);
+            stalls += stats.stalls;
+        }
+    }
+
+    // Every tick both peers have confirmed must have produced the same state
+    size_t compared = std::min(host.checksums.size(), client.checksums.size());
+    long long firstDesync = -1;
+    for (size_t i = 0; i < compared; i++) {
+        if (host.checksums[i] != client.checksums[i]) {
+            firstDesync = (long long)i;
+            break;
+        }
+    }
+
+    int peerFrames = std::max(2 * ticks, 1);
+    std::printf("{\"net_test\":\"loopback\",\"latency_ms\":%.0f,\"jitter_ms\":%.0f,\"loss_pct\":%.1f,"
+                "\"ticks\":%d,\"host_tick\":%u,\"client_tick\":%u,\"rollback_frames_pct\":%.1f,"
+                "\"avg_resim_ticks\":%.2f,\"max_rollback_depth\":%d,\"resim_ms_avg\":%.3f,"
+                "\"resim_ms_max\":%.3f,\"stalls\":%d,\"compared_ticks\":%zu,\"first_desync\":%lld}\n",
+                link.latencyMs, link.jitterMs, link.lossPercent, ticks,
+                host.session.GetCurrentTick(), client.session.GetCurrentTick(),
+                100.0 * rollbackFrames / peerFrames, (double)resimTicks / peerFrames, maxDepth,
+                resimMsTotal / peerFrames, resimMsMax, stalls, compared, firstDesync);
+    std::fflush(stdout);
+
+    return (firstDesync < 0 && compared > 0) ? 0 : 1;
+}
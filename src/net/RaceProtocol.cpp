@@ -0,0 +1,36 @@
+#include "net/RaceProtocol.h"
+#include "raymath.h"
+#include <cmath>
+
+namespace {
+    constexpr uint8_t FLAG_FINISHED = 1;
+
+    int16_t QuantizeCentimetres(float metres) {
+        return (int16_t)Clamp(std::round(metres * 100.0f), -32768.0f, 32767.0f);
+    }
+}
+
+namespace RaceProtocol {
+    QuantizedRacer Quantize(const RacerRecord& racer) {
+        float turns = racer.rotation / 360.0f;
+        QuantizedRacer q;
+        q.x = QuantizeCentimetres(racer.position.x);
+        q.y = QuantizeCentimetres(racer.position.y);
+        q.z = QuantizeCentimetres(racer.position.z);
+        q.yaw = (uint16_t)(int32_t)std::lround((turns - std::floor(turns)) * 65536.0f);
+        q.speed = QuantizeCentimetres(racer.speed);
+        q.lap = (uint8_t)Clamp((float)racer.lap, 0.0f, 255.0f);
+        q.flags = racer.finished ? FLAG_FINISHED : 0;
+        return q;
+    }
+
+    RacerRecord Dequantize(const QuantizedRacer& q) {
+        RacerRecord racer;
+        racer.position = {q.x / 100.0f, q.y / 100.0f, q.z / 100.0f};
+        racer.rotation = q.yaw * (360.0f / 65536.0f);
+        racer.speed = q.speed / 100.0f;
+        racer.lap = q.lap;
+        racer.finished = (q.flags & FLAG_FINISHED) != 0;
+        return racer;
+    }
+}
@@ -0,0 +1,288 @@
+#include "net/RollbackSession.h"
+#include "net/PacketIO.h"
+#include "utils/Config.h"
+#include "utils/Logger.h"
+#include <algorithm>
+#include <chrono>
+
+namespace {
+    constexpr uint8_t PACKET_MAGIC = 0xB7;
+    constexpr uint8_t PACKET_HELLO = 1;      // Client -> host, repeated until welcomed
+    constexpr uint8_t PACKET_WELCOME = 2;    // Host -> client: seed, track, bike
+    constexpr uint8_t PACKET_INPUT = 3;      // Ack, first tick, count, inputs
+
+    constexpr uint32_t NO_ROLLBACK = 0xFFFFFFFFu;
+    constexpr double HELLO_INTERVAL = 0.2;
+    constexpr int INPUT_HEADER_SIZE = 11;
+    constexpr int MAX_INPUTS_PER_PACKET = 255;
+}
+
+RollbackSession::RollbackSession(LevelManager& levelManager) :
+    level(levelManager),
+    peer{},
+    setup{},
+    isHost(false),
+    connected(false),
+    localPlayer(0),
+    lastHelloTime(-HELLO_INTERVAL),
+    currentTick(0),
+    localInputEnd(0),
+    localAcked(0),
+    remoteConfirmed(0),
+    rollbackFrom(NO_ROLLBACK),
+    checksummedUpTo(0),
+    lastRemoteInput{},
+    localInputs{},
+    remoteInputs{},
+    usedRemoteInputs{},
+    checksums{},
+    frameStats{},
+    checksumLog(nullptr)
+{
+    remoteInputTicks.fill(NO_ROLLBACK);
+}
+
+RollbackSession::~RollbackSession() {
+    level.SetExternalHumanInput(false);
+    level.SetHumanPlayerCount(1);
+    level.SetViewPlayer(0);
+    level.ClearSeed();
+}
+
+bool RollbackSession::Host(uint16_t port, const RaceSetup& raceSetup) {
+    if (!socket.Open(port)) {
+        LOG_ERROR("Failed to open UDP port %d", (int)port);
+        return false;
+    }
+    isHost = true;
+    localPlayer = 0;
+    setup = raceSetup;
+    LOG_INFO("Hosting on port %d, waiting for a player to join", (int)socket.GetLocalPort());
+    return true;
+}
+
+bool RollbackSession::Join(const NetAddress& hostAddress) {
+    if (!socket.Open(0)) {
+        LOG_ERROR("Failed to open a UDP socket");
+        return false;
+    }
+    isHost = false;
+    localPlayer = 1;
+    peer = hostAddress;
+    LOG_INFO("Joining %s", peer.ToString());
+    return true;
+}
+
+void RollbackSession::StartRace(const RaceSetup& raceSetup) {
+    setup = raceSetup;
+    connected = true;
+
+    level.SetSeed(setup.seed);
+    level.SetHumanPlayerCount(2);
+    level.SetExternalHumanInput(true);
+    level.SetViewPlayer(localPlayer);
+    level.LoadLevel(setup.trackID, setup.bikeIndex);
+    level.StartRace();
+
+    // Size every snapshot now so ticks never allocate
+    for (RaceSnapshot& snapshot : snapshots) {
+        level.SaveState(snapshot);
+    }
+
+    // Both sides start with INPUT_DELAY neutral ticks nobody has to send
+    currentTick = 0;
+    localInputEnd = INPUT_DELAY;
+    localAcked = INPUT_DELAY;
+    remoteConfirmed = INPUT_DELAY;
+    for (uint32_t tick = 0; tick < INPUT_DELAY; tick++) {
+        remoteInputTicks[tick % HISTORY] = tick;
+    }
+
+    LOG_INFO("Online race started with %s (seed %u, track %d)", peer.ToString(), setup.seed, setup.trackID);
+}
+
+void RollbackSession::Poll(double now) {
+    if (!socket.IsOpen()) return;
+
+    conditioner.Flush(socket, now);
+
+    if (!isHost && !connected && now - lastHelloTime >= HELLO_INTERVAL) {
+        uint8_t hello[2] = {PACKET_MAGIC, PACKET_HELLO};
+        conditioner.Send(socket, peer, hello, sizeof(hello), now);
+        lastHelloTime = now;
+    }
+
+    uint8_t buffer[UdpSocket::MAX_PACKET_SIZE];
+    NetAddress from;
+    int size;
+    while ((size = socket.Receive(from, buffer, sizeof(buffer))) >= 0) {
+        HandlePacket(buffer, size, from, now);
+    }
+}
+
+void RollbackSession::HandlePacket(const uint8_t* data, int size, const NetAddress& from, double now) {
+    if (size < 2 || data[0] != PACKET_MAGIC) return;
+
+    switch (data[1]) {
+        case PACKET_HELLO:
+            if (!isHost || (connected && from != peer)) return;
+            if (!connected) {
+                peer = from;
+                StartRace(setup);
+            }
+            // Repeated until the client stops asking, in case it was lost
+            {
+                uint8_t welcome[8] = {PACKET_MAGIC, PACKET_WELCOME};
+                PacketIO::WriteU32(welcome + 2, setup.seed);
+                welcome[6] = (uint8_t)setup.trackID;
+                welcome[7] = (uint8_t)setup.bikeIndex;
+                conditioner.Send(socket, peer, welcome, sizeof(welcome), now);
+            }
+            break;
+
+        case PACKET_WELCOME:
+            if (isHost || connected || from != peer || size < 8) return;
+            StartRace({PacketIO::ReadU32(data + 2), data[6], data[7]});
+            break;
+
+        case PACKET_INPUT:
+            if (connected && from == peer) {
+                ReceiveInputs(data, size);
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+void RollbackSession::ReceiveInputs(const uint8_t* data, int size) {
+    if (size < INPUT_HEADER_SIZE) return;
+    uint32_t ack = PacketIO::ReadU32(data + 2);
+    uint32_t start = PacketIO::ReadU32(data + 6);
+    int count = data[10];
+    if (size < INPUT_HEADER_SIZE + count * PacketIO::INPUT_SIZE) return;
+
+    localAcked = std::max(localAcked, std::min(ack, localInputEnd));
+
+    for (int i = 0; i < count; i++) {
+        uint32_t tick = start + i;
+        // Ticks we already have, or so far ahead they'd overwrite slots
+        // still needed for re-simulation
+        if (tick < remoteConfirmed || tick >= remoteConfirmed + HISTORY / 2) continue;
+        remoteInputs[tick % HISTORY] = PacketIO::ReadInput(data + INPUT_HEADER_SIZE + i * PacketIO::INPUT_SIZE);
+        remoteInputTicks[tick % HISTORY] = tick;
+    }
+
+    // Confirm in order; a tick simulated with a wrong guess needs a rollback
+    while (remoteInputTicks[remoteConfirmed % HISTORY] == remoteConfirmed) {
+        int slot = remoteConfirmed % HISTORY;
+        lastRemoteInput = remoteInputs[slot];
+        if (remoteConfirmed < currentTick && remoteInputs[slot] != usedRemoteInputs[slot]) {
+            rollbackFrom = std::min(rollbackFrom, remoteConfirmed);
+        }
+        remoteConfirmed++;
+    }
+}
+
+void RollbackSession::SendInputs(double now) {
+    uint32_t first = localAcked;
+    int count = std::min((int)(localInputEnd - first), MAX_INPUTS_PER_PACKET);
+
+    uint8_t packet[INPUT_HEADER_SIZE + MAX_INPUTS_PER_PACKET * PacketIO::INPUT_SIZE];
+    packet[0] = PACKET_MAGIC;
+    packet[1] = PACKET_INPUT;
+    PacketIO::WriteU32(packet + 2, remoteConfirmed);
+    PacketIO::WriteU32(packet + 6, first);
+    packet[10] = (uint8_t)count;
+    for (int i = 0; i < count; i++) {
+        PacketIO::WriteInput(packet + INPUT_HEADER_SIZE + i * PacketIO::INPUT_SIZE, localInputs[(first + i) % HISTORY]);
+    }
+    conditioner.Send(socket, peer, packet, INPUT_HEADER_SIZE + count * PacketIO::INPUT_SIZE, now);
+}
+
+bool RollbackSession::AdvanceTick(const RacerInput& localInput, double now) {
+    if (!connected) return false;
+
+    if (rollbackFrom != NO_ROLLBACK) {
+        Rollback();
+    }
+    LogConfirmedChecksums();
+
+    // Too far ahead of the peer's input, or of its acks (the ring would
+    // overwrite inputs it still needs): wait for it to catch up
+    uint32_t inputTick = currentTick + INPUT_DELAY;
+    if (currentTick >= remoteConfirmed + MAX_PREDICTION || inputTick >= localAcked + HISTORY / 2) {
+        frameStats.stalls++;
+        SendInputs(now);
+        return false;
+    }
+
+    localInputs[inputTick % HISTORY] = localInput;
+    localInputEnd = inputTick + 1;
+    SendInputs(now);
+
+    level.SaveState(snapshots[currentTick % HISTORY]);
+    SimulateTick(currentTick);
+    currentTick++;
+
+    frameStats.ticksAhead = (int)(currentTick - std::min(remoteConfirmed, currentTick));
+    return true;
+}
+
+bool RollbackSession::IsRaceOver() const {
+    if (!connected || rollbackFrom != NO_ROLLBACK) return false;
+
+    // Snapshots hold the state before each tick, so the one at the first
+    // unconfirmed tick is the newest confirmed state
+    uint32_t confirmed = std::min(remoteConfirmed, currentTick);
+    if (confirmed == currentTick) {
+        return level.IsRaceFinished();
+    }
+    return snapshots[confirmed % HISTORY].GetHeader().raceState == RaceState::FINISHED;
+}
+
+void RollbackSession::SimulateTick(uint32_t tick) {
+    int slot = tick % HISTORY;
+    RacerInput remote = (tick < remoteConfirmed) ? remoteInputs[slot] : lastRemoteInput;
+    usedRemoteInputs[slot] = remote;
+
+    level.SetHumanInput(localPlayer, localInputs[slot]);
+    level.SetHumanInput(1 - localPlayer, remote);
+    level.Update(Config::FIXED_TIMESTEP);
+
+    if (checksumLog) {
+        checksums[slot] = level.ComputeStateChecksum();
+    }
+}
+
+void RollbackSession::Rollback() {
+    auto start = std::chrono::steady_clock::now();
+    uint32_t from = rollbackFrom;
+    rollbackFrom = NO_ROLLBACK;
+
+    // Only the tick about to be presented makes new sounds
+    level.LoadState(snapshots[from % HISTORY]);
+    level.SetImpactsMuted(true);
+    for (uint32_t tick = from; tick < currentTick; tick++) {
+        if (tick != from) {
+            level.SaveState(snapshots[tick % HISTORY]);
+        }
+        SimulateTick(tick);
+    }
+    level.SetImpactsMuted(false);
+
+    int depth = (int)(currentTick - from);
+    frameStats.rollbacks++;
+    frameStats.rollbackDepth = std::max(frameStats.rollbackDepth, depth);
+    frameStats.resimulatedTicks += depth;
+    frameStats.resimMs += std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+void RollbackSession::LogConfirmedChecksums() {
+    if (!checksumLog) return;
+    uint32_t finalTick = std::min(remoteConfirmed, currentTick);
+    for (; checksummedUpTo < finalTick; checksummedUpTo++) {
+        checksumLog->push_back(checksums[checksummedUpTo % HISTORY]);
+    }
+}
@@ -0,0 +1,304 @@
+#include "net/SnapshotCodec.h"
+#include "net/PacketIO.h"
+#include <algorithm>
+#include <cmath>
+
+using RaceProtocol::QuantizedRacer;
+
+namespace {
+    // Which fields differ from the baseline
+    constexpr uint8_t FIELD_X = 1 << 0;
+    constexpr uint8_t FIELD_Y = 1 << 1;
+    constexpr uint8_t FIELD_Z = 1 << 2;
+    constexpr uint8_t FIELD_YAW = 1 << 3;
+    constexpr uint8_t FIELD_SPEED = 1 << 4;
+    constexpr uint8_t FIELD_LAP = 1 << 5;
+    constexpr uint8_t FIELD_FLAGS = 1 << 6;
+
+    // Index gap, mask, five varints and two bytes
+    constexpr size_t MAX_ENTRY_SIZE = 3 + 1 + 5 * 3 + 2;
+
+    // Interest: full rate up close, then every 2nd and every 4th snapshot.
+    // Two points on a lap are at most about a third of its length apart.
+    constexpr float NEAR_FRACTION = 0.08f;
+    constexpr float MID_FRACTION = 0.16f;
+    constexpr float DEFAULT_TRACK_LENGTH = 500.0f;
+
+    bool IsNewer(uint16_t a, uint16_t b) {
+        return (int16_t)(a - b) > 0;
+    }
+
+    size_t WriteEntry(uint8_t* out, int gap, const QuantizedRacer& base, const QuantizedRacer& current) {
+        uint8_t* start = out;
+        uint8_t mask = (current.x != base.x ? FIELD_X : 0) | (current.y != base.y ? FIELD_Y : 0) |
+                       (current.z != base.z ? FIELD_Z : 0) | (current.yaw != base.yaw ? FIELD_YAW : 0) |
+                       (current.speed != base.speed ? FIELD_SPEED : 0) | (current.lap != base.lap ? FIELD_LAP : 0) |
+                       (current.flags != base.flags ? FIELD_FLAGS : 0);
+
+        out += PacketIO::WriteVarint(out, (uint32_t)gap);
+        *out++ = mask;
+        if (mask & FIELD_X) out += PacketIO::WriteVarint(out, PacketIO::ZigZag(current.x - base.x));
+        if (mask & FIELD_Y) out += PacketIO::WriteVarint(out, PacketIO::ZigZag(current.y - base.y));
+        if (mask & FIELD_Z) out += PacketIO::WriteVarint(out, PacketIO::ZigZag(current.z - base.z));
+        if (mask & FIELD_YAW) out += PacketIO::WriteVarint(out, PacketIO::ZigZag((int16_t)(current.yaw - base.yaw)));
+        if (mask & FIELD_SPEED) out += PacketIO::WriteVarint(out, PacketIO::ZigZag(current.speed - base.speed));
+        if (mask & FIELD_LAP) *out++ = current.lap;
+        if (mask & FIELD_FLAGS) *out++ = current.flags;
+        return out - start;
+    }
+
+    // Reads one field delta; false if the packet is truncated
+    bool ReadDelta(const uint8_t*& in, const uint8_t* end, int32_t& delta) {
+        uint32_t value;
+        int size = PacketIO::ReadVarint(in, end, value);
+        if (size == 0) return false;
+        in += size;
+        delta = PacketIO::UnZigZag(value);
+        return true;
+    }
+
+    void WriteHeader(uint8_t* out, const SnapshotInfo& info, uint16_t sequence, uint16_t baseline,
+                     int fragment, int racerCount) {
+        out[0] = RaceProtocol::MAGIC;
+        out[1] = RaceProtocol::STATE;
+        PacketIO::WriteU16(out + 2, info.raceID);
+        PacketIO::WriteU32(out + 4, info.tick);
+        out[8] = info.raceState;
+        PacketIO::WriteU16(out + 9, sequence);
+        PacketIO::WriteU16(out + 11, baseline);
+        out[13] = (uint8_t)fragment;
+        out[14] = 0;   // Fragment count, patched once known
+        PacketIO::WriteU16(out + 15, (uint16_t)racerCount);
+    }
+}
+
+SnapshotEncoder::SnapshotEncoder() :
+    nextSequence(0),
+    lastSequence(0),
+    ackedSequence(RaceProtocol::NO_SNAPSHOT),
+    encodeCount(0),
+    interestEnabled(true),
+    trackLength(DEFAULT_TRACK_LENGTH)
+{
+    Reset();
+}
+
+void SnapshotEncoder::Reset() {
+    for (Snapshot& snapshot : history) {
+        snapshot.valid = false;
+    }
+    ackedSequence = RaceProtocol::NO_SNAPSHOT;
+}
+
+void SnapshotEncoder::Acknowledge(uint16_t sequence) {
+    if (sequence == RaceProtocol::NO_SNAPSHOT) return;
+
+    // Only snapshots actually sent and still held can become baselines
+    const Snapshot& snapshot = history[sequence % HISTORY];
+    if (!snapshot.valid || snapshot.sequence != sequence || !IsNewer(nextSequence, sequence)) return;
+    if (ackedSequence == RaceProtocol::NO_SNAPSHOT || IsNewer(sequence, ackedSequence)) {
+        ackedSequence = sequence;
+    }
+}
+
+int SnapshotEncoder::RefreshInterval(const QuantizedRacer& racer, const QuantizedRacer& viewer) const {
+    float dx = (racer.x - viewer.x) / 100.0f;
+    float dz = (racer.z - viewer.z) / 100.0f;
+    float distance = std::sqrt(dx * dx + dz * dz);
+    if (distance < NEAR_FRACTION * trackLength) return 1;
+    if (distance < MID_FRACTION * trackLength) return 2;
+    return 4;
+}
+
+int SnapshotEncoder::Encode(const SnapshotInfo& info, const QuantizedRacer* racers, int racerCount, int viewer) {
+    uint16_t sequence = nextSequence++;
+    lastSequence = sequence;
+    encodeCount++;
+
+    // The baseline must still be in the ring (ours is about to overwrite a slot)
+    const Snapshot* baseline = nullptr;
+    if (ackedSequence != RaceProtocol::NO_SNAPSHOT && (uint16_t)(sequence - ackedSequence) < HISTORY) {
+        const Snapshot& acked = history[ackedSequence % HISTORY];
+        if (acked.valid && acked.sequence == ackedSequence && (int)acked.racers.size() == racerCount) {
+            baseline = &acked;
+        }
+    }
+    uint16_t baselineSequence = baseline ? ackedSequence : RaceProtocol::NO_SNAPSHOT;
+
+    // The snapshot as the client will rebuild it: baseline plus what we send
+    Snapshot& current = history[sequence % HISTORY];
+    current.sequence = sequence;
+    current.valid = true;
+    if (baseline) {
+        current.racers = baseline->racers;
+        current.known = baseline->known;
+    } else {
+        current.racers.assign(racerCount, QuantizedRacer{});
+        current.known.assign(racerCount, 0);
+    }
+
+    int fragments = 0;
+    uint8_t* out = nullptr;
+    uint8_t* end = nullptr;
+    int previous = -1;
+    bool full = false;
+
+    bool spectator = viewer < 0 || viewer >= racerCount;
+    for (int i = 0; i < racerCount; i++) {
+        // A racer the client has no acknowledged value for is always sent,
+        // or it would sit at zero
+        bool due = !current.known[i] || !interestEnabled || spectator || i == viewer ||
+                   (encodeCount + i) % RefreshInterval(racers[i], racers[viewer]) == 0;
+        if (!due) continue;
+        const QuantizedRacer& value = racers[i];
+        if (value == current.racers[i]) {
+            current.known[i] = 1;
+            continue;
+        }
+
+        if (out == nullptr || end - out < (ptrdiff_t)MAX_ENTRY_SIZE) {
+            if (fragments > 0) {
+                packets[fragments - 1].size = out - packets[fragments - 1].data;
+            }
+            if (fragments == MAX_FRAGMENTS) {
+                full = true;   // The rest keep their baseline values this time
+                break;
+            }
+            Packet& packet = packets[fragments];
+            WriteHeader(packet.data, info, sequence, baselineSequence, fragments, racerCount);
+            out = packet.data + RaceProtocol::STATE_HEADER_SIZE;
+            end = packet.data + UdpSocket::MAX_PACKET_SIZE;
+            previous = -1;
+            fragments++;
+        }
+
+        out += WriteEntry(out, i - previous - 1, current.racers[i], value);
+        current.racers[i] = value;
+        current.known[i] = 1;
+        previous = i;
+    }
+
+    // Nothing changed: an empty snapshot still advances the client's ack
+    if (fragments == 0) {
+        WriteHeader(packets[0].data, info, sequence, baselineSequence, 0, racerCount);
+        out = packets[0].data + RaceProtocol::STATE_HEADER_SIZE;
+        fragments = 1;
+    }
+    if (!full) {
+        packets[fragments - 1].size = out - packets[fragments - 1].data;
+    }
+
+    for (int f = 0; f < fragments; f++) {
+        packets[f].data[14] = (uint8_t)fragments;
+    }
+    return fragments;
+}
+
+SnapshotDecoder::SnapshotDecoder() :
+    pendingActive(false),
+    pendingFragments(0),
+    pendingFragmentCount(0),
+    pendingInfo{},
+    latest(-1),
+    info{},
+    undecodable(0)
+{
+    for (Snapshot& snapshot : history) {
+        snapshot.valid = false;
+    }
+    pending.valid = false;
+}
+
+uint16_t SnapshotDecoder::GetAckSequence() const {
+    return latest >= 0 ? history[latest].sequence : RaceProtocol::NO_SNAPSHOT;
+}
+
+bool SnapshotDecoder::Decode(const uint8_t* data, size_t size) {
+    if (size < RaceProtocol::STATE_HEADER_SIZE || data[0] != RaceProtocol::MAGIC ||
+        data[1] != RaceProtocol::STATE) {
+        return false;
+    }
+
+    uint16_t sequence = PacketIO::ReadU16(data + 9);
+    uint16_t baseline = PacketIO::ReadU16(data + 11);
+    int fragment = data[13];
+    int fragmentCount = data[14];
+    int racerCount = PacketIO::ReadU16(data + 15);
+    if (fragmentCount == 0 || fragmentCount > SnapshotEncoder::MAX_FRAGMENTS || fragment >= fragmentCount) {
+        return false;
+    }
+
+    // Older than what we already have, or than the snapshot being assembled
+    if (HasSnapshot() && !IsNewer(sequence, history[latest].sequence)) return false;
+    if (pendingActive && IsNewer(pending.sequence, sequence)) return false;
+
+    if (!pendingActive || pending.sequence != sequence) {
+        if (!StartPending(sequence, baseline, racerCount, fragmentCount)) {
+            undecodable++;
+            return false;
+        }
+        pendingInfo = {PacketIO::ReadU16(data + 2), PacketIO::ReadU32(data + 4), data[8]};
+    }
+
+    uint32_t bit = 1u << fragment;
+    if (pendingFragments & bit) return false;
+    if (!ApplyFragment(data + RaceProtocol::STATE_HEADER_SIZE, data + size)) {
+        pendingActive = false;   // Malformed; wait for the next snapshot
+        return false;
+    }
+    pendingFragments |= bit;
+    uint32_t allFragments = (pendingFragmentCount == 32) ? 0xFFFFFFFFu : (1u << pendingFragmentCount) - 1u;
+    if (pendingFragments != allFragments) return false;
+
+    // Complete: swap into the ring so both vectors keep their capacity
+    int slot = pending.sequence % HISTORY;
+    std::swap(history[slot].racers, pending.racers);
+    history[slot].sequence = pending.sequence;
+    history[slot].valid = true;
+    latest = slot;
+    info = pendingInfo;
+    pendingActive = false;
+    return true;
+}
+
+bool SnapshotDecoder::StartPending(uint16_t sequence, uint16_t baseline, int racerCount, int fragmentCount) {
+    if (baseline == RaceProtocol::NO_SNAPSHOT) {
+        pending.racers.assign(racerCount, QuantizedRacer{});
+    } else {
+        const Snapshot& base = history[baseline % HISTORY];
+        if (!base.valid || base.sequence != baseline || (int)base.racers.size() != racerCount) {
+            return false;
+        }
+        pending.racers = base.racers;
+    }
+
+    pending.sequence = sequence;
+    pendingActive = true;
+    pendingFragments = 0;
+    pendingFragmentCount = fragmentCount;
+    return true;
+}
+
+bool SnapshotDecoder::ApplyFragment(const uint8_t* in, const uint8_t* end) {
+    int index = -1;
+    while (in < end) {
+        uint32_t gap;
+        int size = PacketIO::ReadVarint(in, end, gap);
+        if (size == 0 || in + size >= end) return false;
+        in += size;
+        index += (int)gap + 1;
+        if (index >= (int)pending.racers.size()) return false;
+
+        QuantizedRacer& racer = pending.racers[index];
+        uint8_t mask = *in++;
+        int32_t delta;
+        if (mask & FIELD_X) { if (!ReadDelta(in, end, delta)) return false; racer.x = (int16_t)(racer.x + delta); }
+        if (mask & FIELD_Y) { if (!ReadDelta(in, end, delta)) return false; racer.y = (int16_t)(racer.y + delta); }
+        if (mask & FIELD_Z) { if (!ReadDelta(in, end, delta)) return false; racer.z = (int16_t)(racer.z + delta); }
+        if (mask & FIELD_YAW) { if (!ReadDelta(in, end, delta)) return false; racer.yaw = (uint16_t)(racer.yaw + delta); }
+        if (mask & FIELD_SPEED) { if (!ReadDelta(in, end, delta)) return false; racer.speed = (int16_t)(racer.speed + delta); }
+        if (mask & FIELD_LAP) { if (in >= end) return false; racer.lap = *in++; }
+        if (mask & FIELD_FLAGS) { if (in >= end) return false; racer.flags = *in++; }
+    }
+    return true;
+}
@@ -0,0 +1,159 @@
+#include "net/UdpSocket.h"
+#include <cstdio>
+
+// No raylib includes here: the socket headers on Windows clash with its names
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <winsock2.h>
+#include <ws2tcpip.h>
+typedef SOCKET NativeSocket;
+#else
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+typedef int NativeSocket;
+#endif
+
+namespace {
+    constexpr intptr_t INVALID = -1;
+
+#ifdef _WIN32
+    // WSAStartup is reference counted, so one call per open socket is fine
+    bool StartNetworking() {
+        WSADATA data;
+        return WSAStartup(MAKEWORD(2, 2), &data) == 0;
+    }
+    void StopNetworking() { WSACleanup(); }
+    void CloseSocket(intptr_t handle) { closesocket((NativeSocket)handle); }
+    bool MakeNonBlocking(intptr_t handle) {
+        u_long enabled = 1;
+        return ioctlsocket((NativeSocket)handle, FIONBIO, &enabled) == 0;
+    }
+#else
+    bool StartNetworking() { return true; }
+    void StopNetworking() {}
+    void CloseSocket(intptr_t handle) { close((int)handle); }
+    bool MakeNonBlocking(intptr_t handle) {
+        int flags = fcntl((int)handle, F_GETFL, 0);
+        return flags >= 0 && fcntl((int)handle, F_SETFL, flags | O_NONBLOCK) == 0;
+    }
+#endif
+
+    sockaddr_in ToSockAddr(const NetAddress& address) {
+        sockaddr_in addr = {};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(address.ip);
+        addr.sin_port = htons(address.port);
+        return addr;
+    }
+}
+
+bool NetAddress::Parse(const std::string& text, NetAddress& address) {
+    size_t colon = text.rfind(':');
+    if (colon == std::string::npos) return false;
+
+    std::string host = text.substr(0, colon);
+    if (host == "localhost") host = "127.0.0.1";
+
+    unsigned a, b, c, d, port;
+    char extra;
+    if (std::sscanf(host.c_str(), "%u.%u.%u.%u%c", &a, &b, &c, &d, &extra) != 4 ||
+        std::sscanf(text.c_str() + colon + 1, "%u%c", &port, &extra) != 1 ||
+        a > 255 || b > 255 || c > 255 || d > 255 || port == 0 || port > 65535) {
+        return false;
+    }
+
+    address.ip = (a << 24) | (b << 16) | (c << 8) | d;
+    address.port = (uint16_t)port;
+    return true;
+}
+
+std::string NetAddress::ToString() const {
+    char text[32];
+    std::snprintf(text, sizeof(text), "%u.%u.%u.%u:%u",
+                  (unsigned)(ip >> 24), (unsigned)(ip >> 16) & 0xFF, (unsigned)(ip >> 8) & 0xFF,
+                  (unsigned)ip & 0xFF, (unsigned)port);
+    return text;
+}
+
+UdpSocket::UdpSocket() :
+    handle(INVALID)
+{
+}
+
+UdpSocket::~UdpSocket() {
+    Close();
+}
+
+bool UdpSocket::Open(uint16_t port) {
+    Close();
+    if (!StartNetworking()) return false;
+
+    NativeSocket native = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+#ifdef _WIN32
+    intptr_t s = (native == INVALID_SOCKET) ? INVALID : (intptr_t)native;
+#else
+    intptr_t s = (native < 0) ? INVALID : (intptr_t)native;
+#endif
+    if (s == INVALID) {
+        StopNetworking();
+        return false;
+    }
+
+    sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons(port);
+    if (bind((NativeSocket)s, (const sockaddr*)&addr, sizeof(addr)) != 0 || !MakeNonBlocking(s)) {
+        CloseSocket(s);
+        StopNetworking();
+        return false;
+    }
+
+    handle = s;
+    return true;
+}
+
+void UdpSocket::Close() {
+    if (handle == INVALID) return;
+    CloseSocket(handle);
+    StopNetworking();
+    handle = INVALID;
+}
+
+bool UdpSocket::IsOpen() const {
+    return handle != INVALID;
+}
+
+bool UdpSocket::Send(const NetAddress& to, const uint8_t* data, size_t size) {
+    if (handle == INVALID || size > MAX_PACKET_SIZE) return false;
+    sockaddr_in addr = ToSockAddr(to);
+    return sendto((NativeSocket)handle, (const char*)data, (int)size, 0,
+                  (const sockaddr*)&addr, sizeof(addr)) == (int)size;
+}
+
+int UdpSocket::Receive(NetAddress& from, uint8_t* buffer, size_t capacity) {
+    if (handle == INVALID) return -1;
+
+    // Errors (including ICMP "port unreachable" on Windows) read as no data
+    sockaddr_in addr = {};
+    socklen_t length = sizeof(addr);
+    int received = (int)recvfrom((NativeSocket)handle, (char*)buffer, (int)capacity, 0,
+                                 (sockaddr*)&addr, &length);
+    if (received < 0) return -1;
+
+    from.ip = ntohl(addr.sin_addr.s_addr);
+    from.port = ntohs(addr.sin_port);
+    return received;
+}
+
+uint16_t UdpSocket::GetLocalPort() const {
+    if (handle == INVALID) return 0;
+    sockaddr_in addr = {};
+    socklen_t length = sizeof(addr);
+    if (getsockname((NativeSocket)handle, (sockaddr*)&addr, &length) != 0) return 0;
+    return ntohs(addr.sin_port);
+}
@@ -1,6 +1,7 @@
 #include "physics/PhysicsEngine.h"
 #include "utils/Config.h"
 #include "utils/Logger.h"
+#include "utils/Profiler.h"
 #include <cmath>
 
 PhysicsEngine::PhysicsEngine() :
@@ -18,6 +19,7 @@ void PhysicsEngine::Update(float deltaTime) {
 }
 
 void PhysicsEngine::ApplyPhysics(Bike* bike, float deltaTime) {
+    PROFILE_SCOPE("PhysicsEngine::ApplyPhysics");
     if (!bike) return;
     
     Vector3 position = bike->GetPosition();
@@ -0,0 +1,132 @@
+#include "physics/SpatialGrid.h"
+#include "raymath.h"
+#include <algorithm>
+#include <cmath>
+
+SpatialGrid::SpatialGrid(float cellSize, float halfExtent) :
+    cellSize(cellSize),
+    halfExtent(halfExtent),
+    cellsPerSide(std::max(1, (int)ceilf(2.0f * halfExtent / cellSize)))
+{
+    cellStart.assign(cellsPerSide * cellsPerSide + 1, 0);
+    cellFill.assign(cellsPerSide * cellsPerSide, 0);
+}
+
+void SpatialGrid::Clear() {
+    circles.clear();
+}
+
+void SpatialGrid::Add(Vector2 centre, float radius, int owner) {
+    circles.push_back({centre, radius, owner});
+}
+
+int SpatialGrid::CellCoord(float value) const {
+    // Anything past the edge lands in the border cells
+    return std::clamp((int)floorf((value + halfExtent) / cellSize), 0, cellsPerSide - 1);
+}
+
+void SpatialGrid::Build() {
+    // Counting sort: count per cell, prefix sum, then fill
+    std::fill(cellFill.begin(), cellFill.end(), 0);
+    for (const Circle& circle : circles) {
+        for (int cz = CellCoord(circle.centre.y - circle.radius); cz <= CellCoord(circle.centre.y + circle.radius); cz++) {
+            for (int cx = CellCoord(circle.centre.x - circle.radius); cx <= CellCoord(circle.centre.x + circle.radius); cx++) {
+                cellFill[cz * cellsPerSide + cx]++;
+            }
+        }
+    }
+
+    int cellCount = cellsPerSide * cellsPerSide;
+    cellStart[0] = 0;
+    for (int cell = 0; cell < cellCount; cell++) {
+        cellStart[cell + 1] = cellStart[cell] + cellFill[cell];
+        cellFill[cell] = cellStart[cell];
+    }
+    cellItems.resize(cellStart[cellCount]);
+
+    for (int i = 0; i < (int)circles.size(); i++) {
+        const Circle& circle = circles[i];
+        for (int cz = CellCoord(circle.centre.y - circle.radius); cz <= CellCoord(circle.centre.y + circle.radius); cz++) {
+            for (int cx = CellCoord(circle.centre.x - circle.radius); cx <= CellCoord(circle.centre.x + circle.radius); cx++) {
+                cellItems[cellFill[cz * cellsPerSide + cx]++] = i;
+            }
+        }
+    }
+}
+
+void SpatialGrid::CastRays(const SensorRay* rays, int count, SensorHit* hits) const {
+    for (int i = 0; i < count; i++) {
+        hits[i].owner = -1;
+        hits[i].distance = CastRay(rays[i], hits[i].owner);
+    }
+}
+
+void SpatialGrid::Query(Vector2 centre, float radius, std::vector<int>& owners) const {
+    owners.clear();
+    for (int cz = CellCoord(centre.y - radius); cz <= CellCoord(centre.y + radius); cz++) {
+        for (int cx = CellCoord(centre.x - radius); cx <= CellCoord(centre.x + radius); cx++) {
+            int cell = cz * cellsPerSide + cx;
+            for (int item = cellStart[cell]; item < cellStart[cell + 1]; item++) {
+                const Circle& circle = circles[cellItems[item]];
+                float reach = radius + circle.radius;
+                if (Vector2DistanceSqr(centre, circle.centre) < reach * reach) {
+                    owners.push_back(circle.owner);
+                }
+            }
+        }
+    }
+
+    // A circle spanning several of the visited cells was found in each
+    std::sort(owners.begin(), owners.end());
+    owners.erase(std::unique(owners.begin(), owners.end()), owners.end());
+}
+
+float SpatialGrid::CastRay(const SensorRay& ray, int& owner) const {
+    float best = ray.length;
+
+    // Walk the cells along the ray in order (Amanatides-Woo). A circle sits
+    // in every cell it overlaps, so once the nearest hit is before the next
+    // cell boundary nothing further can beat it.
+    int cx = CellCoord(ray.origin.x);
+    int cz = CellCoord(ray.origin.y);
+    int stepX = ray.direction.x >= 0.0f ? 1 : -1;
+    int stepZ = ray.direction.y >= 0.0f ? 1 : -1;
+    auto boundary = [this](int cell, int step) { return (cell + (step > 0 ? 1 : 0)) * cellSize - halfExtent; };
+    float tDeltaX = ray.direction.x != 0.0f ? cellSize / fabsf(ray.direction.x) : INFINITY;
+    float tDeltaZ = ray.direction.y != 0.0f ? cellSize / fabsf(ray.direction.y) : INFINITY;
+    float tMaxX = ray.direction.x != 0.0f ? (boundary(cx, stepX) - ray.origin.x) / ray.direction.x : INFINITY;
+    float tMaxZ = ray.direction.y != 0.0f ? (boundary(cz, stepZ) - ray.origin.y) / ray.direction.y : INFINITY;
+
+    while (true) {
+        int cell = cz * cellsPerSide + cx;
+        for (int item = cellStart[cell]; item < cellStart[cell + 1]; item++) {
+            const Circle& circle = circles[cellItems[item]];
+            if (circle.owner == ray.ignoreOwner && circle.owner >= 0) continue;
+
+            Vector2 offset = Vector2Subtract(ray.origin, circle.centre);
+            float b = Vector2DotProduct(offset, ray.direction);
+            float c = Vector2DotProduct(offset, offset) - circle.radius * circle.radius;
+            if (c > 0.0f && b > 0.0f) continue;   // Outside and pointing away
+            float discriminant = b * b - c;
+            if (discriminant < 0.0f) continue;
+            float t = std::max(-b - sqrtf(discriminant), 0.0f);
+            if (t < best) {
+                best = t;
+                owner = circle.owner;
+            }
+        }
+
+        float tNext = std::min(tMaxX, tMaxZ);
+        if (best <= tNext || tNext > ray.length) break;
+        if (tMaxX < tMaxZ) {
+            cx += stepX;
+            tMaxX += tDeltaX;
+            if (cx < 0 || cx >= cellsPerSide) break;
+        } else {
+            cz += stepZ;
+            tMaxZ += tDeltaZ;
+            if (cz < 0 || cz >= cellsPerSide) break;
+        }
+    }
+    return best;
+}
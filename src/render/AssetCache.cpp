@@ -0,0 +1,138 @@
+#include "render/AssetCache.h"
+#include "utils/Logger.h"
+#include "rlgl.h"
+#include <cstdarg>
+#include <cstdio>
+
+namespace {
+    constexpr int MATERIAL_MAP_SLOTS = 12;   // raylib's MAX_MATERIAL_MAPS (config.h, not public)
+
+    // Bytes of the attribute arrays raylib keeps in RAM and uploads
+    size_t MeshBytes(const Mesh& mesh) {
+        size_t vertices = (size_t)mesh.vertexCount;
+        size_t bytes = 0;
+        if (mesh.vertices) bytes += vertices * 3 * sizeof(float);
+        if (mesh.texcoords) bytes += vertices * 2 * sizeof(float);
+        if (mesh.texcoords2) bytes += vertices * 2 * sizeof(float);
+        if (mesh.normals) bytes += vertices * 3 * sizeof(float);
+        if (mesh.tangents) bytes += vertices * 4 * sizeof(float);
+        if (mesh.colors) bytes += vertices * 4;
+        if (mesh.indices) bytes += (size_t)mesh.triangleCount * 3 * sizeof(unsigned short);
+        return bytes;
+    }
+
+    size_t TextureBytes(const Texture2D& texture) {
+        if (texture.id == 0) return 0;
+        return (size_t)GetPixelDataSize(texture.width, texture.height, texture.format);
+    }
+
+    std::string FormatKey(const char* format, ...) {
+        char buffer[128];
+        va_list args;
+        va_start(args, format);
+        std::vsnprintf(buffer, sizeof(buffer), format, args);
+        va_end(args);
+        return buffer;
+    }
+}
+
+template <typename MakeModel>
+ModelHandle AssetCache::Acquire(const std::string& key, MakeModel make) {
+    // No GPU context in headless runs, which may be on any thread
+    if (!IsWindowReady()) return ModelHandle();
+
+    auto it = models.find(key);
+    if (it != models.end() && it->second.loaded) {
+        it->second.reuses++;
+        return ModelHandle(&it->second);
+    }
+
+    CachedModel& entry = models[key];
+    entry.model = make();
+    entry.loaded = true;
+    entry.reuses = 0;
+    entry.cpuBytes = sizeof(Model) + entry.model.meshCount * (sizeof(Mesh) + sizeof(int)) +
+                     entry.model.materialCount * (sizeof(Material) + MATERIAL_MAP_SLOTS * sizeof(MaterialMap));
+    entry.gpuBytes = 0;
+    for (int i = 0; i < entry.model.meshCount; i++) {
+        size_t bytes = MeshBytes(entry.model.meshes[i]);
+        entry.cpuBytes += bytes;
+        entry.gpuBytes += bytes;
+    }
+    for (int i = 0; i < entry.model.materialCount; i++) {
+        // The default texture is raylib's, not this model's
+        const Texture2D& texture = entry.model.materials[i].maps[MATERIAL_MAP_DIFFUSE].texture;
+        if (texture.id != rlGetTextureIdDefault()) {
+            entry.gpuBytes += TextureBytes(texture);
+        }
+    }
+    return ModelHandle(&entry);
+}
+
+ModelHandle AssetCache::GetCube(Vector3 size) {
+    return Acquire(FormatKey("cube %.3f %.3f %.3f", size.x, size.y, size.z), [size]() {
+        return LoadModelFromMesh(GenMeshCube(size.x, size.y, size.z));
+    });
+}
+
+ModelHandle AssetCache::GetPlane(float width, float length, int resX, int resZ) {
+    return Acquire(FormatKey("plane %.3f %.3f %d %d", width, length, resX, resZ), [=]() {
+        return LoadModelFromMesh(GenMeshPlane(width, length, resX, resZ));
+    });
+}
+
+ModelHandle AssetCache::GetModelFile(const std::string& path) {
+    return Acquire("file " + path, [&path]() {
+        return ::LoadModel(path.c_str());
+    });
+}
+
+void AssetCache::Collect() {
+    if (!IsWindowReady()) return;   // Headless: nothing cached, maybe not the main thread
+    for (auto it = models.begin(); it != models.end();) {
+        if (it->second.refCount == 0) {
+            if (it->second.loaded) {
+                UnloadModel(it->second.model);
+            }
+            it = models.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void AssetCache::UnloadAll() {
+    for (auto& [key, entry] : models) {
+        if (entry.loaded) {
+            UnloadModel(entry.model);
+            entry.loaded = false;
+        }
+    }
+    // Entries with handles still out stay (empty) until those are dropped
+    Collect();
+}
+
+size_t AssetCache::GetCpuBytes() const {
+    size_t total = 0;
+    for (const auto& [key, entry] : models) {
+        if (entry.loaded) total += entry.cpuBytes;
+    }
+    return total;
+}
+
+size_t AssetCache::GetGpuBytes() const {
+    size_t total = 0;
+    for (const auto& [key, entry] : models) {
+        if (entry.loaded) total += entry.gpuBytes;
+    }
+    return total;
+}
+
+void AssetCache::LogReport() const {
+    LOG_INFO("Asset cache: %d models, %.1f KB CPU, %.1f KB GPU", GetModelCount(),
+             GetCpuBytes() / 1024.0, GetGpuBytes() / 1024.0);
+    for (const auto& [key, entry] : models) {
+        LOG_INFO("  %s: %d refs, %d reuses, %.1f KB CPU, %.1f KB GPU", key, entry.refCount, entry.reuses,
+                 entry.cpuBytes / 1024.0, entry.gpuBytes / 1024.0);
+    }
+}
@@ -0,0 +1,157 @@
+#include "render/RenderBackend.h"
+#include "rlgl.h"
+#include <cmath>
+
+// ---------------------------------------------------------------------------
+// RaylibRenderBackend
+// ---------------------------------------------------------------------------
+
+void RaylibRenderBackend::BeginScene(const Camera3D& camera) {
+    BeginMode3D(camera);
+}
+
+void RaylibRenderBackend::EndScene() {
+    EndMode3D();
+}
+
+void RaylibRenderBackend::Execute(const RenderCommand& command) {
+    if (command.primitive == RenderPrimitive::MODEL) {
+        if (!command.model) return;
+        ::DrawModelEx(*command.model, command.position, {0.0f, 1.0f, 0.0f}, command.yaw,
+                      {command.size.x, command.size.y, command.size.z}, command.color);
+        return;
+    }
+
+    if (command.primitive == RenderPrimitive::GRID) {
+        ::DrawGrid(command.slices, command.size.x);
+        return;
+    }
+
+    // Shape draws are expressed in their local frame
+    bool transformed = command.position.x != 0.0f || command.position.y != 0.0f ||
+                       command.position.z != 0.0f || command.yaw != 0.0f;
+    if (transformed) {
+        rlPushMatrix();
+        rlTranslatef(command.position.x, command.position.y, command.position.z);
+        rlRotatef(command.yaw, 0.0f, 1.0f, 0.0f);
+    }
+
+    const Vector3& o = command.offset;
+    const Vector3& s = command.size;
+    switch (command.primitive) {
+        case RenderPrimitive::CUBE:
+            ::DrawCube(o, s.x, s.y, s.z, command.color);
+            break;
+        case RenderPrimitive::CUBE_WIRES:
+            ::DrawCubeWires(o, s.x, s.y, s.z, command.color);
+            break;
+        case RenderPrimitive::CYLINDER:
+            ::DrawCylinder(o, s.x, s.y, s.z, command.slices, command.color);
+            break;
+        case RenderPrimitive::CYLINDER_WIRES:
+            ::DrawCylinderWires(o, s.x, s.y, s.z, command.slices, command.color);
+            break;
+        case RenderPrimitive::SPHERE:
+            ::DrawSphere(o, s.x, command.color);
+            break;
+        case RenderPrimitive::PLANE:
+            ::DrawPlane(o, {s.x, s.z}, command.color);
+            break;
+        case RenderPrimitive::LINE:
+            ::DrawLine3D(o, s, command.color);
+            break;
+        case RenderPrimitive::RING:
+            ::DrawCircle3D(o, s.x, {1.0f, 0.0f, 0.0f}, 90.0f, command.color);
+            break;
+        case RenderPrimitive::BOUNDING_BOX:
+            ::DrawBoundingBox({o, s}, command.color);
+            break;
+        default:
+            break;
+    }
+
+    if (transformed) {
+        rlPopMatrix();
+    }
+}
+
+// ---------------------------------------------------------------------------
+// NullRenderBackend
+// ---------------------------------------------------------------------------
+
+NullRenderBackend::NullRenderBackend() :
+    sceneCount(0),
+    drawCount(0),
+    invalidCount(0),
+    sceneOpen(false)
+{
+}
+
+void NullRenderBackend::ResetCounters() {
+    sceneCount = 0;
+    drawCount = 0;
+    invalidCount = 0;
+}
+
+void NullRenderBackend::BeginScene(const Camera3D& camera) {
+    // Nested scenes or a degenerate camera would be bugs on the real backend too
+    if (sceneOpen || camera.fovy <= 0.0f) {
+        invalidCount++;
+    }
+    sceneOpen = true;
+    sceneCount++;
+}
+
+void NullRenderBackend::EndScene() {
+    if (!sceneOpen) {
+        invalidCount++;
+    }
+    sceneOpen = false;
+}
+
+void NullRenderBackend::Execute(const RenderCommand& command) {
+    drawCount++;
+    if (!sceneOpen || !IsValid(command)) {
+        invalidCount++;
+    }
+}
+
+bool NullRenderBackend::IsValid(const RenderCommand& command) {
+    auto finite = [](Vector3 v) {
+        return std::isfinite(v.x) && std::isfinite(v.y) && std::isfinite(v.z);
+    };
+
+    if (!finite(command.position) || !finite(command.offset) || !finite(command.size) ||
+        !std::isfinite(command.yaw)) {
+        return false;
+    }
+
+    // A fully transparent draw costs a call and shows nothing
+    if (command.color.a == 0) return false;
+
+    switch (command.primitive) {
+        case RenderPrimitive::CUBE:
+        case RenderPrimitive::CUBE_WIRES:
+            return command.size.x > 0.0f && command.size.y > 0.0f && command.size.z > 0.0f;
+        case RenderPrimitive::CYLINDER:
+        case RenderPrimitive::CYLINDER_WIRES:
+            return command.slices >= 3 && command.size.z > 0.0f &&
+                   command.size.x >= 0.0f && command.size.y >= 0.0f &&
+                   (command.size.x > 0.0f || command.size.y > 0.0f);
+        case RenderPrimitive::SPHERE:
+        case RenderPrimitive::RING:
+            return command.size.x > 0.0f;
+        case RenderPrimitive::PLANE:
+            return command.size.x > 0.0f && command.size.z > 0.0f;
+        case RenderPrimitive::BOUNDING_BOX:
+            return command.size.x >= command.offset.x && command.size.y >= command.offset.y &&
+                   command.size.z >= command.offset.z;
+        case RenderPrimitive::MODEL:
+            return command.model != nullptr && command.model->meshCount > 0 && command.size.x > 0.0f;
+        case RenderPrimitive::GRID:
+            return command.slices > 0 && command.size.x > 0.0f;
+        case RenderPrimitive::LINE:
+            return true;
+    }
+    return false;
+}
@@ -0,0 +1,219 @@
+#include "render/RenderQueue.h"
+#include "render/RenderBackend.h"
+#include "raymath.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace {
+    constexpr size_t INITIAL_CAPACITY = 256;
+
+    // Squared distances are non-negative, so their IEEE bit patterns sort like integers
+    uint32_t DepthBits(float distanceSquared) {
+        uint32_t bits;
+        std::memcpy(&bits, &distanceSquared, sizeof(bits));
+        return bits;
+    }
+
+    uint32_t HashPointer(const void* ptr, int bits) {
+        uint64_t value = (uint64_t)(uintptr_t)ptr;
+        value ^= value >> 33;
+        value *= 0xff51afd7ed558ccdULL;
+        value ^= value >> 33;
+        return (uint32_t)(value & ((1ULL << bits) - 1));
+    }
+
+    uint32_t HashColor(Color color, int bits) {
+        uint32_t packed = ((uint32_t)color.r << 24) | ((uint32_t)color.g << 16) |
+                          ((uint32_t)color.b << 8) | color.a;
+        packed *= 0x9e3779b1u;
+        return packed >> (32 - bits);
+    }
+
+    bool SameState(const RenderCommand& a, const RenderCommand& b) {
+        return a.primitive == b.primitive && a.model == b.model &&
+               a.color.r == b.color.r && a.color.g == b.color.g &&
+               a.color.b == b.color.b && a.color.a == b.color.a;
+    }
+}
+
+RenderQueue::RenderQueue() :
+    camera{},
+    currentPosition({0, 0, 0}),
+    currentYaw(0.0f),
+    lastStats{}
+{
+    commands.reserve(INITIAL_CAPACITY);
+}
+
+void RenderQueue::Begin(const Camera3D& newCamera) {
+    camera = newCamera;
+    commands.clear();
+    ResetTransform();
+}
+
+void RenderQueue::SetTransform(Vector3 position, float yaw) {
+    currentPosition = position;
+    currentYaw = yaw;
+}
+
+void RenderQueue::ResetTransform() {
+    currentPosition = {0, 0, 0};
+    currentYaw = 0.0f;
+}
+
+RenderCommand& RenderQueue::Push(RenderPrimitive primitive, Color color) {
+    commands.emplace_back();
+    RenderCommand& command = commands.back();
+    command.primitive = primitive;
+    command.color = color;
+    command.position = currentPosition;
+    command.yaw = currentYaw;
+    command.offset = {0, 0, 0};
+    command.size = {0, 0, 0};
+    command.slices = 0;
+    command.model = nullptr;
+    command.sortKey = 0;
+    return command;
+}
+
+void RenderQueue::DrawCube(Vector3 offset, float width, float height, float length, Color color) {
+    RenderCommand& command = Push(RenderPrimitive::CUBE, color);
+    command.offset = offset;
+    command.size = {width, height, length};
+}
+
+void RenderQueue::DrawCubeWires(Vector3 offset, float width, float height, float length, Color color) {
+    RenderCommand& command = Push(RenderPrimitive::CUBE_WIRES, color);
+    command.offset = offset;
+    command.size = {width, height, length};
+}
+
+void RenderQueue::DrawCylinder(Vector3 offset, float radiusTop, float radiusBottom, float height, int slices, Color color) {
+    RenderCommand& command = Push(RenderPrimitive::CYLINDER, color);
+    command.offset = offset;
+    command.size = {radiusTop, radiusBottom, height};
+    command.slices = slices;
+}
+
+void RenderQueue::DrawCylinderWires(Vector3 offset, float radiusTop, float radiusBottom, float height, int slices, Color color) {
+    RenderCommand& command = Push(RenderPrimitive::CYLINDER_WIRES, color);
+    command.offset = offset;
+    command.size = {radiusTop, radiusBottom, height};
+    command.slices = slices;
+}
+
+void RenderQueue::DrawSphere(Vector3 offset, float radius, Color color) {
+    RenderCommand& command = Push(RenderPrimitive::SPHERE, color);
+    command.offset = offset;
+    command.size = {radius, radius, radius};
+}
+
+void RenderQueue::DrawPlane(Vector3 offset, Vector2 size, Color color) {
+    RenderCommand& command = Push(RenderPrimitive::PLANE, color);
+    command.offset = offset;
+    command.size = {size.x, 0.0f, size.y};
+}
+
+void RenderQueue::DrawLine(Vector3 start, Vector3 end, Color color) {
+    RenderCommand& command = Push(RenderPrimitive::LINE, color);
+    command.offset = start;
+    command.size = end;
+}
+
+void RenderQueue::DrawRing(Vector3 offset, float radius, Color color) {
+    RenderCommand& command = Push(RenderPrimitive::RING, color);
+    command.offset = offset;
+    command.size = {radius, 0.0f, radius};
+}
+
+void RenderQueue::DrawBoundingBox(BoundingBox box, Color color) {
+    RenderCommand& command = Push(RenderPrimitive::BOUNDING_BOX, color);
+    command.offset = box.min;
+    command.size = box.max;
+}
+
+void RenderQueue::DrawModel(const Model& model, Vector3 position, float scale, Color tint) {
+    RenderCommand& command = Push(RenderPrimitive::MODEL, tint);
+    command.position = position;
+    command.yaw = 0.0f;
+    command.size = {scale, scale, scale};
+    command.model = &model;
+}
+
+void RenderQueue::DrawGrid(int slices, float spacing) {
+    RenderCommand& command = Push(RenderPrimitive::GRID, LIGHTGRAY);
+    command.position = {0, 0, 0};
+    command.yaw = 0.0f;
+    command.size = {spacing, 0.0f, spacing};
+    command.slices = slices;
+}
+
+uint64_t RenderQueue::MakeSortKey(const RenderCommand& command) const {
+    Vector3 center = Vector3Add(command.position, command.offset);
+    uint32_t depth = DepthBits(Vector3DistanceSqr(center, camera.position));
+
+    if (command.color.a < 255) {
+        // Translucent: after all opaque draws, farthest first
+        return (1ULL << 63) | ((uint64_t)(0xFFFFFFFFu - depth) << 16) |
+               ((uint64_t)command.primitive << 12) | HashColor(command.color, 12);
+    }
+
+    // Opaque: [primitive:4][mesh:12][colour:15][depth:32], nearest first within a state
+    uint64_t mesh = command.model ? HashPointer(command.model->meshes, 12) : 0;
+    return ((uint64_t)command.primitive << 59) | (mesh << 47) |
+           ((uint64_t)HashColor(command.color, 15) << 32) | depth;
+}
+
+void RenderQueue::Sort() {
+    for (RenderCommand& command : commands) {
+        command.sortKey = MakeSortKey(command);
+    }
+    std::sort(commands.begin(), commands.end(), [](const RenderCommand& a, const RenderCommand& b) {
+        return a.sortKey < b.sortKey;
+    });
+}
+
+void RenderQueue::Flush(RenderBackend& backend) {
+    auto start = std::chrono::steady_clock::now();
+
+    Sort();
+
+    RenderStats stats = {};
+    backend.BeginScene(camera);
+    for (size_t i = 0; i < commands.size(); i++) {
+        const RenderCommand& command = commands[i];
+        if (i == 0 || !SameState(command, commands[i - 1])) {
+            stats.stateChanges++;
+        }
+        stats.triangles += EstimateTriangles(command);
+        backend.Execute(command);
+    }
+    backend.EndScene();
+    stats.drawCalls = (int)commands.size();
+
+    auto end = std::chrono::steady_clock::now();
+    stats.submitMicros = std::chrono::duration<float, std::micro>(end - start).count();
+    lastStats = stats;
+
+    commands.clear();
+}
+
+int RenderQueue::EstimateTriangles(const RenderCommand& command) {
+    switch (command.primitive) {
+        case RenderPrimitive::CUBE: return 12;
+        case RenderPrimitive::CYLINDER: return command.slices * 4; // Sides plus both caps
+        case RenderPrimitive::SPHERE: return 18 * 16 * 2;          // DrawSphere uses 16 rings x 16 slices
+        case RenderPrimitive::PLANE: return 2;
+        case RenderPrimitive::MODEL: {
+            if (!command.model) return 0;
+            int total = 0;
+            for (int i = 0; i < command.model->meshCount; i++) {
+                total += command.model->meshes[i].triangleCount;
+            }
+            return total;
+        }
+        default:
+            return 0; // Line primitives
+    }
+}
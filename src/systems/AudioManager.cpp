@@ -1,62 +1,114 @@
 #include "systems/AudioManager.h"
 #include "utils/Logger.h"
+#include "utils/AssetArchive.h"
 #include "utils/Config.h"
+#include "raymath.h"
+#include <algorithm>
+
+namespace {
+    // Sounds are at full level within the reference distance, fall off as
+    // 1/distance past it and reach silence at the audible range
+    constexpr float SOUND_REFERENCE_DISTANCE = 6.0f;
+    constexpr float SOUND_AUDIBLE_DISTANCE = 90.0f;
+    constexpr float MIN_AUDIBILITY = 0.02f;   // Below this a sound isn't started
+}
 
 AudioManager::AudioManager() :
+    voices{},
+    listenerPosition({0, 0, 0}),
+    listenerRight({1, 0, 0}),
+    frameStats{},
+    lastFrameStats{},
     musicPlaying(false),
     masterVolume(1.0f),
     musicVolume(0.7f),
     soundVolume(0.8f)
 {
+    for (Voice& voice : voices) {
+        voice.sound = INVALID_SOUND;
+    }
 }
 
 AudioManager::~AudioManager() {
+    Shutdown();
+}
+
+void AudioManager::Shutdown() {
+    engineSynth.Stop();
+
+    // Aliases before the sounds they share data with
+    for (Voice& voice : voices) {
+        if (voice.sound != INVALID_SOUND) {
+            UnloadSoundAlias(voice.alias);
+            voice.sound = INVALID_SOUND;
+        }
+    }
+
     // Unload all music and sounds
     for (auto& [name, music] : musicTracks) {
         UnloadMusicStream(music);
     }
-    
-    for (auto& [name, sound] : soundEffects) {
+    musicTracks.clear();
+    musicPlaying = false;
+
+    for (Sound& sound : sounds) {
         UnloadSound(sound);
     }
+    sounds.clear();
+    soundNames.clear();
 }
 
-void AudioManager::Initialize() {
+void AudioManager::Initialize(ThreadPool* loadPool) {
     LOG_INFO("AudioManager initialized");
-    LoadAudio();
+    LoadAudio(loadPool);
+    engineSynth.SetVolume(soundVolume * masterVolume);
+    engineSynth.Start();
 }
 
-void AudioManager::LoadAudio() {
-    // Note: These files don't exist yet, so we'll create placeholders
-    // In a real project, you'd load actual audio files
-    
-    // For now, we'll just log that we tried to load them
-    LOG_INFO("Audio loading skipped (no audio files yet)");
-    
+void AudioManager::LoadAudio(ThreadPool* loadPool) {
+    // Effects are optional: whichever exist are loaded, and playing a
+    // missing one is a no-op. They are read (and decompressed) together,
+    // then decoded here, as the audio device isn't thread-safe.
+    const char* EFFECTS[] = {"collision"};
+    std::vector<std::string> assetNames;
+    for (const char* name : EFFECTS) {
+        assetNames.push_back(std::string("audio/sfx/") + name + ".wav");
+    }
+    std::vector<std::vector<unsigned char>> files;
+    AssetArchive::GetInstance().LoadMany(assetNames, files, loadPool);
+    for (size_t i = 0; i < assetNames.size(); i++) {
+        if (!files[i].empty()) {
+            LoadSound(EFFECTS[i], assetNames[i], files[i]);
+        }
+    }
+    LOG_INFO("Loaded %d sound effects", (int)sounds.size());
+
     // Example of how to load when files exist:
     // LoadMusic("menu", Config::AUDIO_PATH + "music/menu.ogg");
     // LoadMusic("race", Config::AUDIO_PATH + "music/race.ogg");
-    // LoadSound("engine", Config::AUDIO_PATH + "sfx/engine.wav");
-    // LoadSound("collision", Config::AUDIO_PATH + "sfx/collision.wav");
 }
 
 void AudioManager::LoadMusic(const std::string& name, const std::string& filepath) {
     Music music = ::LoadMusicStream(filepath.c_str());
     if (music.frameCount > 0) {
         musicTracks[name] = music;
-        LOG_INFO("Loaded music: " + name);
+        LOG_INFO("Loaded music: %s", name);
     } else {
-        LOG_WARNING("Failed to load music: " + filepath);
+        LOG_WARNING("Failed to load music: %s", filepath);
     }
 }
 
-void AudioManager::LoadSound(const std::string& name, const std::string& filepath) {
-    Sound sound = ::LoadSound(filepath.c_str());
+void AudioManager::LoadSound(const std::string& name, const std::string& assetName,
+                             const std::vector<unsigned char>& file) {
+    Wave wave = LoadWaveFromMemory(GetFileExtension(assetName.c_str()), file.data(), (int)file.size());
+    Sound sound = LoadSoundFromWave(wave);
+    UnloadWave(wave);
     if (sound.frameCount > 0) {
-        soundEffects[name] = sound;
-        LOG_INFO("Loaded sound: " + name);
+        soundNames[name] = (SoundHandle)sounds.size();
+        sounds.push_back(sound);
+        LOG_INFO("Loaded sound: %s", name);
     } else {
-        LOG_WARNING("Failed to load sound: " + filepath);
+        LOG_WARNING("Failed to load sound: %s", assetName);
     }
 }
 
@@ -65,6 +117,15 @@ void AudioManager::Update(float deltaTime) {
     if (musicPlaying) {
         ::UpdateMusicStream(currentMusic);
     }
+
+    frameStats.active = 0;
+    for (const Voice& voice : voices) {
+        if (voice.sound != INVALID_SOUND && IsSoundPlaying(voice.alias)) {
+            frameStats.active++;
+        }
+    }
+    lastFrameStats = frameStats;
+    frameStats = {};
 }
 
 void AudioManager::PlayMusic(const std::string& musicName) {
@@ -80,9 +141,9 @@ void AudioManager::PlayMusic(const std::string& musicName) {
         ::SetMusicVolume(currentMusic, musicVolume * masterVolume);
         ::PlayMusicStream(currentMusic);
         musicPlaying = true;
-        LOG_INFO("Playing music: " + musicName);
+        LOG_INFO("Playing music: %s", musicName);
     } else {
-        LOG_WARNING("Music not found: " + musicName);
+        LOG_WARNING("Music not found: %s", musicName);
     }
 }
 
@@ -100,16 +161,75 @@ void AudioManager::SetMusicVolume(float volume) {
     }
 }
 
-void AudioManager::PlaySound(const std::string& soundName) {
-    auto it = soundEffects.find(soundName);
-    if (it != soundEffects.end()) {
-        ::SetSoundVolume(it->second, soundVolume * masterVolume);
-        ::PlaySound(it->second);
-    } else {
-        LOG_WARNING("Sound not found: " + soundName);
+SoundHandle AudioManager::FindSound(const std::string& name) const {
+    auto it = soundNames.find(name);
+    return it != soundNames.end() ? it->second : INVALID_SOUND;
+}
+
+void AudioManager::SetListener(Vector3 position, Vector3 right) {
+    listenerPosition = position;
+    listenerRight = right;
+}
+
+void AudioManager::PlaySound(SoundHandle sound, int priority, float volume) {
+    PlaySound(sound, listenerPosition, priority, volume);
+}
+
+void AudioManager::PlaySound(SoundHandle sound, Vector3 position, int priority, float volume) {
+    if (sound < 0 || sound >= (int)sounds.size()) return;
+
+    Vector3 offset = Vector3Subtract(position, listenerPosition);
+    float distance = Vector3Length(offset);
+    float falloff = std::min(1.0f, SOUND_REFERENCE_DISTANCE / std::max(distance, 0.001f))
+                  * std::max(0.0f, 1.0f - distance / SOUND_AUDIBLE_DISTANCE);
+    float audibility = volume * falloff;
+    if (audibility < MIN_AUDIBILITY) {
+        frameStats.culled++;
+        return;
     }
+    float pan = distance > 0.001f ? Vector3DotProduct(offset, listenerRight) / distance : 0.0f;
+
+    // A free voice, else the least important one playing
+    Voice* victim = nullptr;
+    for (Voice& voice : voices) {
+        if (voice.sound == INVALID_SOUND || !IsSoundPlaying(voice.alias)) {
+            StartVoice(voice, sound, priority, audibility, pan);
+            return;
+        }
+        if (!victim || voice.priority < victim->priority ||
+            (voice.priority == victim->priority && voice.audibility < victim->audibility)) {
+            victim = &voice;
+        }
+    }
+
+    if (victim->priority > priority ||
+        (victim->priority == priority && victim->audibility >= audibility)) {
+        frameStats.culled++;
+        return;
+    }
+    StopSound(victim->alias);
+    frameStats.stolen++;
+    StartVoice(*victim, sound, priority, audibility, pan);
+}
+
+void AudioManager::StartVoice(Voice& voice, SoundHandle sound, int priority, float audibility, float pan) {
+    if (voice.sound != sound) {
+        if (voice.sound != INVALID_SOUND) {
+            UnloadSoundAlias(voice.alias);
+        }
+        voice.alias = LoadSoundAlias(sounds[sound]);
+        voice.sound = sound;
+    }
+    voice.priority = priority;
+    voice.audibility = audibility;
+
+    ::SetSoundVolume(voice.alias, std::min(audibility, 1.0f) * soundVolume * masterVolume);
+    ::SetSoundPan(voice.alias, 0.5f - 0.5f * std::clamp(pan, -1.0f, 1.0f));   // raylib: 1 is left
+    ::PlaySound(voice.alias);
+    frameStats.started++;
 }
 
 void AudioManager::SetSoundVolume(float volume) {
     soundVolume = volume;
+    engineSynth.SetVolume(soundVolume * masterVolume);
 }
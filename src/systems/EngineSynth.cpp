@@ -0,0 +1,200 @@
+#include "systems/EngineSynth.h"
+#include "utils/Logger.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    constexpr int GEAR_COUNT = 5;
+    constexpr float SHIFT_DROP = 0.35f;        // Fraction of the rev range kept after an upshift
+    constexpr float FIRINGS_PER_REV = 2.0f;    // Inline four, four-stroke
+
+    // Tone: a saw at the firing frequency plus intake noise that grows with
+    // load, through a one-pole low-pass that opens up with load
+    constexpr float NOISE_LEVEL = 0.35f;
+    constexpr float FILTER_CLOSED = 0.06f;
+    constexpr float FILTER_OPEN = 0.35f;
+    constexpr float VOICE_LEVEL = 0.3f;
+
+    constexpr unsigned int STREAM_BUFFER_FRAMES = 1024;   // ~23 ms
+
+    float SoftClip(float x) {
+        x = std::clamp(x, -3.0f, 3.0f);
+        return x * (27.0f + x * x) / (27.0f + 9.0f * x * x);
+    }
+}
+
+static_assert(std::atomic<float>::is_always_lock_free, "EngineSynth parameters must be lock-free");
+
+std::atomic<EngineSynth*> EngineSynth::active{nullptr};
+
+EngineSynth::EngineSynth() :
+    voices{},
+    volume(1.0f),
+    stream{},
+    running(false)
+{
+    for (int i = 0; i < VOICE_COUNT; i++) {
+        shared[i].rpm.store(IDLE_RPM, std::memory_order_relaxed);
+        shared[i].load.store(0.0f, std::memory_order_relaxed);
+        shared[i].gain.store(0.0f, std::memory_order_relaxed);
+        shared[i].pan.store(0.0f, std::memory_order_relaxed);
+        voices[i].rpm = IDLE_RPM;
+        voices[i].noise = 0x9E3779B9u * (i + 1);
+    }
+}
+
+EngineSynth::~EngineSynth() {
+    Stop();
+}
+
+bool EngineSynth::Start() {
+    if (running) return true;
+    if (!IsAudioDeviceReady()) {
+        LOG_WARNING("Engine synth not started: no audio device");
+        return false;
+    }
+
+    EngineSynth* expected = nullptr;
+    if (!active.compare_exchange_strong(expected, this)) {
+        LOG_WARNING("Engine synth not started: another synth is playing");
+        return false;
+    }
+
+    SetAudioStreamBufferSizeDefault(STREAM_BUFFER_FRAMES);
+    stream = LoadAudioStream(SAMPLE_RATE, 32, 2);
+    SetAudioStreamBufferSizeDefault(0);
+    if (!IsAudioStreamReady(stream)) {
+        active.store(nullptr);
+        LOG_WARNING("Engine synth not started: stream could not be opened");
+        return false;
+    }
+
+    SetAudioStreamCallback(stream, AudioCallback);
+    PlayAudioStream(stream);
+    running = true;
+    LOG_INFO("Engine synth started (%d voices, %d Hz)", VOICE_COUNT, SAMPLE_RATE);
+    return true;
+}
+
+void EngineSynth::Stop() {
+    if (!running) return;
+    StopAudioStream(stream);
+    UnloadAudioStream(stream);
+    active.store(nullptr);
+    running = false;
+}
+
+void EngineSynth::SetVoice(int voice, const VoiceParams& params) {
+    if (voice < 0 || voice >= VOICE_COUNT) return;
+    SharedVoice& target = shared[voice];
+    target.rpm.store(params.rpm, std::memory_order_relaxed);
+    target.load.store(params.load, std::memory_order_relaxed);
+    target.gain.store(params.gain, std::memory_order_relaxed);
+    target.pan.store(params.pan, std::memory_order_relaxed);
+}
+
+void EngineSynth::SilenceFrom(int voice) {
+    for (int i = std::max(voice, 0); i < VOICE_COUNT; i++) {
+        shared[i].gain.store(0.0f, std::memory_order_relaxed);
+    }
+}
+
+void EngineSynth::SetVolume(float newVolume) {
+    volume.store(std::clamp(newVolume, 0.0f, 1.0f), std::memory_order_relaxed);
+}
+
+float EngineSynth::RpmFromSpeed(float speed, float maxSpeed) {
+    if (maxSpeed <= 0.0f) return IDLE_RPM;
+
+    float ratio = std::clamp(speed / maxSpeed, 0.0f, 1.0f) * GEAR_COUNT;
+    int gear = std::min((int)ratio, GEAR_COUNT - 1);
+    float inGear = ratio - gear;
+    float sweep = (gear == 0) ? inGear : SHIFT_DROP + (1.0f - SHIFT_DROP) * inGear;
+    return IDLE_RPM + (REDLINE_RPM - IDLE_RPM) * sweep;
+}
+
+void EngineSynth::AudioCallback(void* buffer, unsigned int frames) {
+    float* output = static_cast<float*>(buffer);
+    EngineSynth* synth = active.load(std::memory_order_acquire);
+    if (!synth) {
+        std::fill(output, output + frames * 2, 0.0f);
+        return;
+    }
+    synth->Render(output, frames);
+}
+
+void EngineSynth::Render(float* output, unsigned int frames) {
+    std::fill(output, output + frames * 2, 0.0f);
+    if (frames == 0) return;
+
+    const float step = 1.0f / frames;
+    for (int i = 0; i < VOICE_COUNT; i++) {
+        VoiceState& voice = voices[i];
+        const SharedVoice& target = shared[i];
+
+        // Parameters are ramped across the buffer from where the last one
+        // ended, so tick-rate updates don't click
+        float rpmEnd = std::clamp(target.rpm.load(std::memory_order_relaxed), IDLE_RPM * 0.5f, REDLINE_RPM * 1.2f);
+        float loadEnd = std::clamp(target.load.load(std::memory_order_relaxed), 0.0f, 1.0f);
+        float gainEnd = std::max(target.gain.load(std::memory_order_relaxed), 0.0f);
+        float panEnd = std::clamp(target.pan.load(std::memory_order_relaxed), -1.0f, 1.0f);
+        if (voice.gain <= 0.0f && gainEnd <= 0.0f) {
+            voice.rpm = rpmEnd;
+            voice.load = loadEnd;
+            voice.pan = panEnd;
+            continue;
+        }
+
+        // Equal-power pan at both ends, linear in between
+        float leftStart = voice.gain * std::sqrt(0.5f * (1.0f - voice.pan));
+        float rightStart = voice.gain * std::sqrt(0.5f * (1.0f + voice.pan));
+        float leftEnd = gainEnd * std::sqrt(0.5f * (1.0f - panEnd));
+        float rightEnd = gainEnd * std::sqrt(0.5f * (1.0f + panEnd));
+
+        float freq = voice.rpm / 60.0f * FIRINGS_PER_REV / SAMPLE_RATE;
+        float freqStep = (rpmEnd / 60.0f * FIRINGS_PER_REV / SAMPLE_RATE - freq) * step;
+        float load = voice.load;
+        float loadStep = (loadEnd - load) * step;
+        float left = leftStart;
+        float leftStep = (leftEnd - leftStart) * step;
+        float right = rightStart;
+        float rightStep = (rightEnd - rightStart) * step;
+
+        float phase = voice.phase;
+        float filtered = voice.filtered;
+        uint32_t noise = voice.noise;
+        for (unsigned int frame = 0; frame < frames; frame++) {
+            phase += freq;
+            phase -= (float)(int)phase;
+
+            noise ^= noise << 13;
+            noise ^= noise >> 17;
+            noise ^= noise << 5;
+            float white = (float)(int32_t)noise * (1.0f / 2147483648.0f);
+
+            float raw = (2.0f * phase - 1.0f) + white * NOISE_LEVEL * load;
+            filtered += (FILTER_CLOSED + (FILTER_OPEN - FILTER_CLOSED) * load) * (raw - filtered);
+
+            output[frame * 2] += filtered * left;
+            output[frame * 2 + 1] += filtered * right;
+
+            freq += freqStep;
+            load += loadStep;
+            left += leftStep;
+            right += rightStep;
+        }
+
+        voice.rpm = rpmEnd;
+        voice.load = loadEnd;
+        voice.gain = gainEnd;
+        voice.pan = panEnd;
+        voice.phase = phase;
+        voice.filtered = filtered;
+        voice.noise = noise;
+    }
+
+    float level = VOICE_LEVEL * volume.load(std::memory_order_relaxed);
+    for (unsigned int i = 0; i < frames * 2; i++) {
+        output[i] = SoftClip(output[i] * level);
+    }
+}
@@ -0,0 +1,156 @@
+#include "systems/Ghost.h"
+#include "utils/Config.h"
+#include "utils/Logger.h"
+#include "raymath.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace {
+    constexpr char MAGIC[4] = {'B', 'R', 'G', 'H'};
+    constexpr uint32_t VERSION = 1;
+    constexpr int SAMPLE_TICKS = 3;                 // 20 samples per second at 60 Hz
+    constexpr size_t RESERVED_SAMPLES = 20 * 180;   // Three-minute lap without reallocating
+
+    int16_t QuantizeCoordinate(float value) {
+        return (int16_t)Clamp(roundf(value * 100.0f), -32767.0f, 32767.0f);
+    }
+
+    uint16_t QuantizeYaw(float degrees) {
+        return (uint16_t)((int32_t)lroundf(degrees * (65536.0f / 360.0f)) & 0xFFFF);
+    }
+
+    GhostSample MakeSample(Vector3 position, float yaw) {
+        return {QuantizeCoordinate(position.x), QuantizeCoordinate(position.y),
+                QuantizeCoordinate(position.z), QuantizeYaw(yaw)};
+    }
+}
+
+GhostRecorder::GhostRecorder() :
+    ticksInLap(0),
+    recording(false)
+{
+    samples.reserve(RESERVED_SAMPLES);
+}
+
+void GhostRecorder::BeginLap(Vector3 position, float yaw) {
+    samples.clear();
+    samples.push_back(MakeSample(position, yaw));
+    ticksInLap = 0;
+    recording = true;
+}
+
+void GhostRecorder::Tick(Vector3 position, float yaw) {
+    if (!recording) return;
+    ticksInLap++;
+    if (ticksInLap % SAMPLE_TICKS == 0) {
+        samples.push_back(MakeSample(position, yaw));
+    }
+}
+
+void GhostRecorder::EndLap(Vector3 position, float yaw) {
+    if (!recording) return;
+    samples.push_back(MakeSample(position, yaw));
+    recording = false;
+}
+
+bool GhostRecorder::Save(const std::string& path, float lapTime) const {
+    if (recording || samples.size() < 2) return false;
+
+    GhostFileHeader header = {};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.lapTime = lapTime;
+    header.sampleInterval = SAMPLE_TICKS * Config::FIXED_TIMESTEP;
+    header.sampleCount = (uint32_t)samples.size();
+
+    std::error_code error;
+    std::filesystem::path target(path);
+    if (target.has_parent_path()) {
+        std::filesystem::create_directories(target.parent_path(), error);
+    }
+
+    std::string tempPath = path + ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::binary);
+        file.write((const char*)&header, sizeof(header));
+        file.write((const char*)samples.data(), samples.size() * sizeof(GhostSample));
+        if (!file) {
+            LOG_ERROR("Failed to write ghost: %s", tempPath);
+            return false;
+        }
+    }
+
+    std::filesystem::rename(tempPath, target, error);
+    if (error) {
+        LOG_ERROR("Failed to replace ghost %s: %s", path, error.message());
+        return false;
+    }
+
+    LOG_INFO("Saved ghost %s (%.2fs, %u samples)", path, lapTime, header.sampleCount);
+    return true;
+}
+
+GhostTrack::GhostTrack() :
+    header{}
+{
+}
+
+bool GhostTrack::Load(const std::string& path) {
+    Unload();
+    if (!file.Open(path)) return false;
+
+    // Only the header is read now; samples are read from the mapping as needed
+    bool valid = file.GetSize() >= sizeof(GhostFileHeader);
+    if (valid) {
+        std::memcpy(&header, file.GetData(), sizeof(header));
+        valid = std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) == 0 &&
+                header.version == VERSION &&
+                header.sampleCount >= 2 &&
+                header.sampleInterval > 0.0f &&
+                header.lapTime > 0.0f &&
+                file.GetSize() == sizeof(GhostFileHeader) + (size_t)header.sampleCount * sizeof(GhostSample);
+    }
+    if (!valid) {
+        LOG_WARNING("Ignoring invalid ghost file: %s", path);
+        Unload();
+        return false;
+    }
+
+    LOG_INFO("Loaded ghost %s (%.2fs)", path, header.lapTime);
+    return true;
+}
+
+void GhostTrack::Unload() {
+    file.Close();
+    header = {};
+}
+
+GhostSample GhostTrack::ReadSample(uint32_t index) const {
+    GhostSample sample;
+    std::memcpy(&sample, file.GetData() + sizeof(GhostFileHeader) + index * sizeof(GhostSample), sizeof(sample));
+    return sample;
+}
+
+bool GhostTrack::Sample(float lapTime, Vector3& position, float& yaw) const {
+    if (!IsLoaded() || lapTime < 0.0f || lapTime > header.lapTime) return false;
+
+    uint32_t last = header.sampleCount - 1;
+    uint32_t index = std::min((uint32_t)(lapTime / header.sampleInterval), last - 1);
+    float startTime = index * header.sampleInterval;
+    float endTime = (index + 1 == last) ? header.lapTime : (index + 1) * header.sampleInterval;
+    float t = (endTime > startTime) ? Clamp((lapTime - startTime) / (endTime - startTime), 0.0f, 1.0f) : 1.0f;
+
+    GhostSample a = ReadSample(index);
+    GhostSample b = ReadSample(index + 1);
+    position.x = Lerp(a.x, b.x, t) * 0.01f;
+    position.y = Lerp(a.y, b.y, t) * 0.01f;
+    position.z = Lerp(a.z, b.z, t) * 0.01f;
+
+    // Shortest way round, so 359 -> 1 degrees doesn't spin the ghost
+    int16_t yawDelta = (int16_t)(uint16_t)(b.yaw - a.yaw);
+    yaw = (a.yaw + yawDelta * t) * (360.0f / 65536.0f);
+    return true;
+}
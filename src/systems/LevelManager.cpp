@@ -1,42 +1,191 @@
 #include "systems/LevelManager.h"
-#include "core/GameEngine.h"
+#include "systems/Replay.h"
+#include "systems/EngineSynth.h"
 #include "core/InputManager.h"
 #include "core/CameraManager.h"
 #include "physics/PhysicsEngine.h"
+#include "render/AssetCache.h"
+#include "render/RenderQueue.h"
+#include "ui/PerfOverlay.h"
+#include "utils/Config.h"
 #include "utils/Logger.h"
+#include "utils/Profiler.h"
 #include "raymath.h"
 #include <algorithm>
+#include <array>
+#include <cmath>
 #include <random>
+#include <type_traits>
+
+namespace {
+    constexpr unsigned char GHOST_ALPHA = 110;
+
+    constexpr float BIKE_COLLISION_RADIUS = 2.0f;   // As in CheckCollisions and ResolveCollision
+    constexpr float SENSOR_CELL_SIZE = 8.0f;
+    constexpr float MOVING_CELL_SIZE = 4.0f;        // Packs of bikes crowd larger cells
+    constexpr float SENSOR_GRID_EXTENT = 100.0f;    // Physics resets bikes past this from the origin
+    constexpr float BIKE_SENSE_RADIUS = 3.5f;       // Just under the grid spacing, so neighbours on the grid aren't touching
+    constexpr float BIKE_GRID_CELL_SIZE = 5.0f;
+    constexpr float BIKE_CONTACT_SLACK = 1.0f;      // Earlier pushes in the same pass move bikes a little
+    constexpr float IMPACT_MIN_SPEED = 3.0f;        // Slower contacts (scraping, resting) make no sound
+
+    // Starting grid: rows of five behind the spawn point while they fit
+    constexpr int GRID_COLUMNS = 5;
+    constexpr float GRID_LANE_SPACING = 4.0f;
+    constexpr float GRID_ROW_SPACING = 5.0f;
+    constexpr float GRID_RADIUS = 96.0f;            // Inside the 100 m the physics keeps bikes within
+    constexpr float GRID_SHRINK = 0.95f;
+
+    constexpr Color BIKE_COLORS[] = {RED, BLUE, GREEN, YELLOW, ORANGE, PURPLE, PINK, LIME, SKYBLUE, BROWN};
+    constexpr int BIKE_COLOR_COUNT = sizeof(BIKE_COLORS) / sizeof(BIKE_COLORS[0]);
+
+    // Points for finishing 1st, 2nd, ...; the rest of the field gets none
+    constexpr int POSITION_POINTS[] = {100, 50};
+    constexpr int POINTS_PLACES = sizeof(POSITION_POINTS) / sizeof(POSITION_POINTS[0]);
+
+    // Rendering: bikes further than this from the camera are drawn as a
+    // single box, and bikes outside the view not at all
+    constexpr float BIKE_DETAIL_DISTANCE = 60.0f;
+    constexpr float BIKE_CULL_RADIUS = 1.5f;
+
+    // Engine audio: the listener sits at the camera target, just ahead of
+    // the viewed bike. Engines fall off with distance past the reference
+    // and aren't voiced at all beyond the audible range.
+    constexpr float ENGINE_REFERENCE_DISTANCE = 8.0f;
+    constexpr float ENGINE_AUDIBLE_DISTANCE = 80.0f;
+    constexpr float ENGINE_COASTING_LOAD = 0.15f;
+
+    // Everything is widened by the bike's collision radius, so a ray from a
+    // bike's centre stops where the bike itself would touch, and a bike
+    // centre inside the circle may be touching the obstacle
+    float ObstacleRadius(const Obstacle& obstacle) {
+        BoundingBox box = obstacle.GetBoundingBox();
+        return 0.5f * Vector2Length({box.max.x - box.min.x, box.max.z - box.min.z}) + BIKE_COLLISION_RADIUS;
+    }
+
+    // Slot positions for a grid of count racers. Small grids are the classic
+    // rows of five behind the spawn point; a grid that would reach past the
+    // arena becomes a near-square block backed onto the arena's edge, packed
+    // tighter until every slot is inside.
+    void BuildGridSlots(Vector3 spawn, Vector3 heading, int count, std::vector<Vector3>& slots) {
+        Vector3 forward = Vector3Normalize({heading.x, 0.0f, heading.z});
+        Vector3 lateral = {forward.z, 0.0f, -forward.x};
+        int columns = GRID_COLUMNS;
+        float spacing = 1.0f;   // Scale on the lane and row spacing
+        float front = 0.0f;     // Front row's distance ahead of the spawn point
+
+        auto slotPosition = [&](int slot) {
+            float across = (slot % columns - (columns - 1) * 0.5f) * GRID_LANE_SPACING * spacing;
+            float ahead = front - (slot / columns) * GRID_ROW_SPACING * spacing;
+            return Vector3Add(spawn, Vector3Add(Vector3Scale(lateral, across), Vector3Scale(forward, ahead)));
+        };
+        auto fits = [&]() {
+            int lastRow = (count - 1) / columns * columns;
+            for (int corner : {0, columns - 1, lastRow, lastRow + columns - 1}) {
+                Vector3 position = slotPosition(corner);
+                if (Vector2Length({position.x, position.z}) > GRID_RADIUS) return false;
+            }
+            return true;
+        };
+
+        if (!fits()) {
+            columns = std::max(GRID_COLUMNS, (int)ceilf(sqrtf((float)count)));
+            int rows = (count + columns - 1) / columns;
+            float spawnAcross = fabsf(Vector3DotProduct(spawn, lateral));
+            float spawnAhead = Vector3DotProduct(spawn, forward);
+            while (true) {
+                float halfWidth = (columns - 1) * 0.5f * GRID_LANE_SPACING * spacing + spawnAcross;
+                float back = sqrtf(std::max(GRID_RADIUS * GRID_RADIUS - halfWidth * halfWidth, 0.0f));
+                front = (rows - 1) * GRID_ROW_SPACING * spacing - back - spawnAhead;
+                if (fits()) break;
+                spacing *= GRID_SHRINK;
+            }
+        }
+
+        slots.resize(count);
+        for (int slot = 0; slot < count; slot++) {
+            slots[slot] = slotPosition(slot);
+        }
+    }
+
+    // Conservative test against the view cone; only ever keeps too much
+    bool IsInView(const Camera3D& camera, Vector3 point, float radius) {
+        Vector3 forward = Vector3Normalize(Vector3Subtract(camera.target, camera.position));
+        Vector3 right = Vector3Normalize(Vector3CrossProduct(forward, camera.up));
+        Vector3 up = Vector3CrossProduct(right, forward);
+        Vector3 offset = Vector3Subtract(point, camera.position);
+
+        float depth = Vector3DotProduct(offset, forward);
+        if (depth < -radius) return false;
+        float tanHalfHeight = tanf(camera.fovy * 0.5f * DEG2RAD);
+        float tanHalfWidth = tanHalfHeight * Config::SCREEN_WIDTH / Config::SCREEN_HEIGHT;
+        // Widening by the radius over cos(half angle) keeps spheres that
+        // straddle a side plane
+        float reachX = depth * tanHalfWidth + radius * sqrtf(1.0f + tanHalfWidth * tanHalfWidth);
+        float reachY = depth * tanHalfHeight + radius * sqrtf(1.0f + tanHalfHeight * tanHalfHeight);
+        return fabsf(Vector3DotProduct(offset, right)) <= reachX && fabsf(Vector3DotProduct(offset, up)) <= reachY;
+    }
+}
 
 LevelManager::LevelManager() :
     raceState(RaceState::NOT_STARTED),
     countdownTimer(3.0f),
     raceTime(0.0f),
-    currentLevelID(1)
+    raceTick(0),
+    currentLevelID(1),
+    currentBikeIndex(0),
+    aiParams(AIParamsFile::Defaults()),
+    physicsEngine(nullptr),
+    inputManager(nullptr),
+    raceSeed(std::random_device{}()),
+    fixedSeed(false),
+    externalHumanInput(false),
+    humanPlayerCount(1),
+    viewPlayer(0),
+    replaySource(nullptr),
+    finalChecksum(0),
+    ghostsEnabled(false),
+    staticGrid(SENSOR_CELL_SIZE, SENSOR_GRID_EXTENT),
+    movingGrid(MOVING_CELL_SIZE, SENSOR_GRID_EXTENT),
+    bikeGrid(BIKE_GRID_CELL_SIZE, SENSOR_GRID_EXTENT),
+    staticGridObstacles(-1),
+    impactsMuted(false)
 {
     // Initialize with level 1 unlocked
     unlockedLevels.resize(5, false);
     unlockedLevels[0] = true; // Level 1 unlocked by default
+    std::fill(std::begin(bestLaps), std::end(bestLaps), 0.0f);
+    impacts.reserve(IMPACT_CAPACITY);
 }
 
-void LevelManager::Initialize() {
+LevelManager::~LevelManager() = default;
+
+void LevelManager::Initialize(PhysicsEngine* physics, InputManager* input) {
+    physicsEngine = physics;
+    inputManager = input;
     LOG_INFO("LevelManager initialized");
-    
-    // Create 5 players - 1 human + 4 AI opponents
-    AddPlayer(0, "Player 1");
-    AddPlayer(1, "CPU 1");
-    AddPlayer(2, "CPU 2");
-    AddPlayer(3, "CPU 3");
-    AddPlayer(4, "CPU 4");
-    
-    // Set all except Player 1 as AI
-    for (size_t i = 1; i < players.size(); i++) {
-        players[i]->SetAI(true);
-    }
+    // Racers are created with the first level, unless SetRacerCount comes
+    // first: each bike holds a GPU model, which the menus don't need
 }
 
 void LevelManager::LoadLevel(int levelID, int playerBikeIndex) {
     currentLevelID = levelID;
+    currentBikeIndex = playerBikeIndex;
+    if (players.empty()) {
+        SetRacerCount(Config::DEFAULT_RACERS);
+    }
+
+    // The seed is all a replay needs to rebuild the starting grid
+    if (!fixedSeed) {
+        raceSeed = std::random_device{}();
+    }
+    rng.seed(raceSeed);
+
+    if (ghostsEnabled) {
+        ghost.Load(GetGhostPath(levelID));
+    } else {
+        ghost.Unload();
+    }
     
     // Create new track
     currentTrack = std::make_unique<Track>();
@@ -44,50 +193,64 @@ void LevelManager::LoadLevel(int levelID, int playerBikeIndex) {
     // Load appropriate track based on level ID
     std::string trackName = "track" + std::to_string(levelID);
     currentTrack->LoadTrack(trackName);
+    staticGridObstacles = -1;
     
     // Reset players with randomized starting grid positions
-    Color bikeColors[] = {RED, BLUE, GREEN, YELLOW, ORANGE};
+    std::vector<Vector3> gridSlots;
+    BuildGridSlots(currentTrack->GetSpawnPoint(0), currentTrack->GetSpawnDirection(), (int)players.size(), gridSlots);
     
     // Create shuffled grid positions for randomization
-    std::vector<int> gridPositions = {0, 1, 2, 3, 4};
-    std::random_device rd;
-    std::mt19937 g(rd());
-    std::shuffle(gridPositions.begin(), gridPositions.end(), g);
-    
-    // Swap bike colors if needed so selected bike is always at index 0 (player 0)
-    // This ensures player 0 (arrow keys) controls the selected bike
-    if (playerBikeIndex == 1) {
-        // User selected blue bike, swap red and blue
-        std::swap(bikeColors[0], bikeColors[1]);
+    std::vector<int> gridPositions(players.size());
+    for (size_t i = 0; i < gridPositions.size(); i++) {
+        gridPositions[i] = (int)i;
     }
+    std::shuffle(gridPositions.begin(), gridPositions.end(), rng);
     
     for (size_t i = 0; i < players.size(); i++) {
         // Use randomized grid position instead of player index
-        int gridSlot = gridPositions[i];
-        float xOffset = (gridSlot - 2.0f) * 4.0f; // -8, -4, 0, 4, 8
-        Vector3 baseSpawn = currentTrack->GetSpawnPoint(0); // Get track start
-        Vector3 startPos = {baseSpawn.x + xOffset, baseSpawn.y, baseSpawn.z};
+        Vector3 startPos = gridSlots[gridPositions[i]];
         
-        Color bikeColor = bikeColors[i % 5];
+        // Swap red and blue if needed so the selected bike is always
+        // player 0 (arrow keys)
+        int colorIndex = (int)(i % BIKE_COLOR_COUNT);
+        if (playerBikeIndex == 1 && colorIndex < 2) {
+            colorIndex = 1 - colorIndex;
+        }
         
         // Initialize player with bike
-        players[i]->Initialize(startPos, bikeColor);
+        players[i]->Initialize(startPos, BIKE_COLORS[colorIndex]);
         
         // Reset player race stats
         players[i]->ResetRace();
     }
+    // Drops whatever an online race added to player 1's stats
+    if (!externalHumanInput) {
+        players[0]->SetStats(careerStats);
+    }
     
-    // Player 0 is always human (uses arrow keys), all others are AI
-    players[0]->SetAI(false);
-    for (size_t i = 1; i < players.size(); i++) {
-        players[i]->SetAI(true);
+    // Player 0 is human (uses arrow keys), plus the remote player online;
+    // all others are AI
+    for (size_t i = 0; i < players.size(); i++) {
+        players[i]->SetAI((int)i >= humanPlayerCount);
     }
     
+    // The new track and bikes hold what they use; the rest is unloaded.
+    // Headless levels (server and tuner workers) cache no models.
+    if (IsWindowReady()) {
+        AssetCache& assets = AssetCache::GetInstance();
+        assets.Collect();
+        LOG_INFO("Assets: %d models, %.1f KB CPU, %.1f KB GPU", assets.GetModelCount(),
+                 assets.GetCpuBytes() / 1024.0, assets.GetGpuBytes() / 1024.0);
+    }
+
+    SaveState(gridSnapshot);
+
     std::string bikeChoice = (playerBikeIndex == 0) ? "RED" : "BLUE";
-    LOG_INFO("Loaded level " + std::to_string(levelID) + " - Player chose " + bikeChoice + " bike");
+    LOG_INFO("Loaded level %d - Player chose %s bike", levelID, bikeChoice);
 }
 
 void LevelManager::Update(float deltaTime) {
+    PROFILE_SCOPE("LevelManager::Update");
     if (!currentTrack) return;
     
     currentTrack->Update(deltaTime);
@@ -98,55 +261,52 @@ void LevelManager::Update(float deltaTime) {
             if (countdownTimer <= 0.0f) {
                 raceState = RaceState::RACING;
                 LOG_INFO("Race started!");
+
+                if (ghostsEnabled) {
+                    const Bike* bike = players[0]->GetBike();
+                    ghostRecorder.BeginLap(bike->GetPosition(), bike->GetRotation());
+                }
             }
             break;
             
         case RaceState::RACING: {
             UpdateRaceProgress(deltaTime);
-            CheckCheckpoints();
-            CheckCollisions();
-            UpdatePlayerPositions();
+            {
+                SectionTimer timer(PerfSection::CHECKPOINTS);
+                CheckCheckpoints();
+            }
+            {
+                SectionTimer timer(PerfSection::COLLISIONS);
+                CheckCollisions();
+            }
+            {
+                SectionTimer timer(PerfSection::RANKING);
+                UpdatePlayerPositions();
+            }
             
-            // Update players
-            for (auto& player : players) {
-                if (!player) continue;
-                
-                if (player->IsAI()) {
-                    // AI Navigation - Always target the NEXT checkpoint
-                    Vector3 targetPos = {0, 0, 100}; // Default: forward
-                    
-                    if (currentTrack) {
-                        const auto& checkpoints = currentTrack->GetCheckpoints();
-                        if (!checkpoints.empty()) {
-                            int cpsPassed = player->GetCheckpointsPassed();
-                            
-                            // Target the next checkpoint in sequence
-                            if (cpsPassed < (int)checkpoints.size()) {
-                                targetPos = checkpoints[cpsPassed]->GetPosition();
-                            } else {
-                                // Race complete, target last checkpoint (finish)
-                                targetPos = checkpoints[checkpoints.size() - 1]->GetPosition();
-                            }
-                        }
-                    }
-                    
-                    player->UpdateAI(deltaTime, targetPos, currentLevelID);
-                } else {
-                    // Human Input
-                    auto inputMgr = GameEngine::GetInstance().GetInputManager();
-                    float accel = inputMgr->GetAxisValue(player->GetID(), InputAction::ACCELERATE);
-                    float brake = inputMgr->GetAxisValue(player->GetID(), InputAction::BRAKE);
-                    float turn = inputMgr->GetAxisValue(player->GetID(), InputAction::TURN_RIGHT);
-                    bool nitroPressed = inputMgr->IsActionDown(player->GetID(), InputAction::NITRO);
+            // Steering pass: AI decisions and human input for every player.
+            // Each player only reads its own bike here, so doing this before
+            // the movement pass gives the same result as interleaving them.
+            GatherInputs();
+            for (size_t i = 0; i < players.size(); i++) {
+                players[i]->ProcessInput(tickInputs[i]);
+            }
+            raceTick++;
+
+            // Movement pass: update and apply physics
+            {
+                SectionTimer timer(PerfSection::PHYSICS);
+                for (auto& player : players) {
+                    if (!player) continue;
                     
-                    player->ProcessInput(accel, brake, turn, nitroPressed);
+                    player->Update(deltaTime);
+                    physicsEngine->ApplyPhysics(player->GetBike(), deltaTime);
                 }
-                
-                player->Update(deltaTime);
-                
-                // Apply physics
-                auto physicsEngine = GameEngine::GetInstance().GetPhysicsEngine();
-                physicsEngine->ApplyPhysics(player->GetBike(), deltaTime);
+            }
+
+            if (ghostsEnabled) {
+                const Bike* bike = players[0]->GetBike();
+                ghostRecorder.Tick(bike->GetPosition(), bike->GetRotation());
             }
             
             // TODO: Update camera for both players (camera manager recreation causing issues)
@@ -168,15 +328,14 @@ void LevelManager::Update(float deltaTime) {
     }
 }
 
-void LevelManager::Render() const {
-    if (!currentTrack) return;
-    
-    // Create camera that follows Player 1
+Camera3D LevelManager::GetCamera() const {
+    // Create camera that follows the local player
     Camera3D camera = { 0 };
+    const Player* viewed = GetPlayer(viewPlayer);
     
-    if (!players.empty() && players[0]->GetBike()) {
-        Vector3 bikePos = players[0]->GetBike()->GetPosition();
-        Vector3 bikeDir = players[0]->GetBike()->GetDirection();
+    if (viewed && viewed->GetBike()) {
+        Vector3 bikePos = viewed->GetBike()->GetPosition();
+        Vector3 bikeDir = viewed->GetBike()->GetDirection();
         
         // Camera position: behind and above the bike
         Vector3 cameraOffset = {-bikeDir.x * 20.0f, 15.0f, -bikeDir.z * 20.0f};
@@ -195,65 +354,158 @@ void LevelManager::Render() const {
     camera.fovy = 45.0f;
     camera.projection = CAMERA_PERSPECTIVE;
     
-    BeginMode3D(camera);
+    return camera;
+}
+
+void LevelManager::PublishEngineAudio(EngineSynth& synth) const {
+    if (!currentTrack || raceState == RaceState::NOT_STARTED) {
+        synth.SilenceFrom(0);
+        return;
+    }
+
+    Camera3D camera = GetCamera();
+    Vector3 listener = camera.target;
+    Vector3 right = Vector3Normalize(Vector3CrossProduct(Vector3Subtract(camera.target, camera.position), camera.up));
+
+    // The nearest bikes in range, closest first
+    std::array<int, EngineSynth::VOICE_COUNT> nearest;
+    std::array<float, EngineSynth::VOICE_COUNT> nearestDistSqr;
+    int voiceCount = 0;
+    for (int i = 0; i < (int)players.size(); i++) {
+        float distSqr = Vector3DistanceSqr(players[i]->GetBike()->GetPosition(), listener);
+        if (distSqr > ENGINE_AUDIBLE_DISTANCE * ENGINE_AUDIBLE_DISTANCE) continue;
+        if (voiceCount == EngineSynth::VOICE_COUNT && distSqr >= nearestDistSqr[voiceCount - 1]) continue;
+
+        int slot = std::min(voiceCount, EngineSynth::VOICE_COUNT - 1);
+        while (slot > 0 && nearestDistSqr[slot - 1] > distSqr) {
+            nearest[slot] = nearest[slot - 1];
+            nearestDistSqr[slot] = nearestDistSqr[slot - 1];
+            slot--;
+        }
+        nearest[slot] = i;
+        nearestDistSqr[slot] = distSqr;
+        voiceCount = std::min(voiceCount + 1, EngineSynth::VOICE_COUNT);
+    }
+
+    for (int voice = 0; voice < voiceCount; voice++) {
+        int i = nearest[voice];
+        const Bike* bike = players[i]->GetBike();
+        float distance = sqrtf(nearestDistSqr[voice]);
+        Vector3 offset = Vector3Subtract(bike->GetPosition(), listener);
+        float throttle = (i < (int)tickInputs.size() && raceState == RaceState::RACING)
+                       ? tickInputs[i].accelerate / 127.0f : 0.0f;
+
+        EngineSynth::VoiceParams params;
+        params.rpm = EngineSynth::RpmFromSpeed(bike->GetSpeed(), bike->GetMaxSpeed());
+        params.load = std::max(throttle, ENGINE_COASTING_LOAD);
+        params.gain = std::min(1.0f, ENGINE_REFERENCE_DISTANCE / std::max(distance, 1.0f))
+                    * (1.0f - distance / ENGINE_AUDIBLE_DISTANCE);
+        params.pan = distance > 1.0f ? Vector3DotProduct(offset, right) / distance : 0.0f;
+        synth.SetVoice(voice, params);
+    }
+    synth.SilenceFrom(voiceCount);
+}
+
+void LevelManager::Render(RenderQueue& queue) const {
+    if (!currentTrack) return;
+    
+    Camera3D camera = GetCamera();
+    queue.Begin(camera);
     
     // Render track
-    currentTrack->Render();
+    currentTrack->Render(queue);
     
     // Render debug checkpoints
     #ifdef DEBUG
-    currentTrack->RenderDebug();
+    currentTrack->RenderDebug(queue);
     #endif
     
-    // Render players
+    // Render players: full detail near the camera, a single box further
+    // out, nothing outside the view
     for (const auto& player : players) {
-        player->Render();
+        const Bike* bike = player->GetBike();
+        Vector3 position = bike->GetPosition();
+        if (!IsInView(camera, position, BIKE_CULL_RADIUS)) continue;
+
+        if (Vector3DistanceSqr(position, camera.position) < BIKE_DETAIL_DISTANCE * BIKE_DETAIL_DISTANCE) {
+            player->Render(queue);
+        } else {
+            Bike::RenderLowDetail(queue, position, bike->GetRotation(), bike->GetColor());
+        }
+    }
+
+    // Ghost of the best lap, at the same time into the lap as player 1.
+    // Sampled here rather than simulated, so it costs one bike's draws.
+    if (raceState == RaceState::RACING && ghost.IsLoaded()) {
+        Vector3 ghostPosition;
+        float ghostYaw;
+        if (ghost.Sample(players[0]->GetCurrentLapTime(), ghostPosition, ghostYaw)) {
+            Bike::RenderShape(queue, ghostPosition, ghostYaw, SKYBLUE, GHOST_ALPHA);
+        }
     }
     
     // Draw ground grid for reference
-    DrawGrid(50, 2.0f);
-    
-    EndMode3D();
+    queue.DrawGrid(50, 2.0f);
 }
 
 void LevelManager::StartRace() {
     raceState = RaceState::COUNTDOWN;
     countdownTimer = 3.0f;
     raceTime = 0.0f;
+    raceTick = 0;
+    finalChecksum = 0;
+    impacts.clear();
     
     for (auto& player : players) {
         player->StartRace();
     }
+
+    if (replayWriter) {
+        ReplayHeader header = {};
+        header.seed = raceSeed;
+        header.trackID = currentLevelID;
+        header.bikeIndex = currentBikeIndex;
+        header.racerCount = (int)players.size();
+        header.tickRate = (int)lroundf(1.0f / Config::FIXED_TIMESTEP);
+        replayWriter->Begin(header);
+    }
     
-    LOG_INFO("Race countdown started");
+    LOG_INFO("Race countdown started (%d racers)", (int)players.size());
 }
 
 void LevelManager::EndRace() {
     raceState = RaceState::FINISHED;
+
+    finalChecksum = ComputeStateChecksum();
+    if (replayWriter) {
+        replayWriter->Finish(finalChecksum);
+    }
     
     // Determine winner and award points
     int winner = GetWinner();
     if (winner >= 0 && winner < (int)players.size()) {
         // Award points based on position
         for (auto& player : players) {
-            if (player->GetRacePosition() == 1) {
-                player->AddPoints(100); // Winner gets 100 points
-                LOG_INFO("Player " + std::to_string(player->GetID() + 1) + " finished 1st - awarded 100 points");
-            } else {
-                player->AddPoints(50); // Second place gets 50 points
-                LOG_INFO("Player " + std::to_string(player->GetID() + 1) + " finished 2nd - awarded 50 points");
+            int position = player->GetRacePosition();
+            if (position >= 1 && position <= POINTS_PLACES) {
+                player->AddPoints(POSITION_POINTS[position - 1]);
             }
         }
                 
-        // Unlock next level if player 1 won
-        if (winner == 0 && currentLevelID < 3) {
-            UnlockLevel(currentLevelID + 1);
+        // Online, player 1 may be the other peer; career progress is
+        // only kept for offline races
+        if (!externalHumanInput) {
+            careerStats = players[0]->GetStats();
+            // Unlock next level if player 1 won
+            if (winner == 0 && currentLevelID < 3) {
+                UnlockLevel(currentLevelID + 1);
+            }
         }
         
-        LOG_INFO("Race ended - WINNER: Player " + std::to_string(winner + 1));
+        LOG_INFO("Race ended - WINNER: Player %d of %d (player 1 finished P%d, %d points)", winner + 1,
+                 (int)players.size(), players[0]->GetRacePosition(), players[0]->GetTotalPoints());
         
-        // Transition to game over screen
-        GameEngine::GetInstance().SetState(GameState::GAME_OVER);
+        // GameEngine switches to the game over screen once IsRaceFinished()
     }
 }
 
@@ -266,14 +518,83 @@ void LevelManager::ResumeRace() {
 }
 
 void LevelManager::RestartRace() {
-    LoadLevel(currentLevelID);
+    // Rewind to the grid LoadLevel left instead of rebuilding the track.
+    // Career stats earned since then are kept.
+    if (!gridSnapshot.IsEmpty() && gridSnapshot.GetHeader().playerCount == players.size()) {
+        Player::State* gridPlayers = gridSnapshot.GetPlayers();
+        for (size_t i = 0; i < players.size(); i++) {
+            gridPlayers[i].stats = players[i]->GetStats();
+        }
+    }
+    if (!LoadState(gridSnapshot)) {
+        LoadLevel(currentLevelID, currentBikeIndex);
+    }
     StartRace();
 }
 
+void LevelManager::SetSeed(uint32_t seed) {
+    raceSeed = seed;
+    fixedSeed = true;
+}
+
+void LevelManager::SetReplayRecording(bool enabled) {
+    if (enabled && !replayWriter) {
+        replayWriter = std::make_unique<ReplayWriter>();
+    } else if (!enabled) {
+        replayWriter.reset();
+    }
+}
+
+bool LevelManager::SaveReplay(const std::string& path) const {
+    return replayWriter && replayWriter->HasRecording() && replayWriter->SaveToFile(path);
+}
+
+uint64_t LevelManager::ComputeStateChecksum() const {
+    // FNV-1a over the raw bits, so any divergence at all shows up
+    uint64_t hash = 14695981039346656037ull;
+    auto mix = [&hash](const void* data, size_t size) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; i++) {
+            hash = (hash ^ bytes[i]) * 1099511628211ull;
+        }
+    };
+
+    for (const auto& player : players) {
+        Vector3 position = player->GetBike()->GetPosition();
+        Vector3 velocity = player->GetBike()->GetVelocity();
+        int progress[2] = {player->GetCurrentLap(), player->GetCheckpointsPassed()};
+        mix(&position, sizeof(position));
+        mix(&velocity, sizeof(velocity));
+        mix(progress, sizeof(progress));
+    }
+    return hash;
+}
+
 void LevelManager::AddPlayer(int playerID, const std::string& name) {
     auto player = std::make_unique<Player>(playerID, name);
     players.push_back(std::move(player));
-    LOG_INFO("Added player: " + name + " (ID: " + std::to_string(playerID) + ")");
+    LOG_INFO("Added player: %s (ID: %d)", name, playerID);
+}
+
+void LevelManager::SetRacerCount(int count) {
+    count = std::clamp(count, 1, Config::MAX_RACERS);
+    int previous = (int)players.size();
+    if (count < previous) {
+        players.resize(count);
+    }
+    // Not through AddPlayer: thousands of log lines for one setting.
+    // Player 1 plus AI opponents; LoadLevel hands humans their slots.
+    for (int playerID = previous; playerID < count; playerID++) {
+        std::string name = (playerID == 0) ? "Player 1" : "CPU " + std::to_string(playerID);
+        players.push_back(std::make_unique<Player>(playerID, name));
+        players.back()->SetAI(playerID != 0);
+        if (playerID == 0) {
+            players.back()->SetStats(careerStats);
+        }
+    }
+    if (count != previous) {
+        LOG_INFO("Racer count set to %d", count);
+    }
 }
 
 Player* LevelManager::GetPlayer(int playerID) const {
@@ -284,27 +605,19 @@ Player* LevelManager::GetPlayer(int playerID) const {
 }
 
 int LevelManager::GetWinner() const {
-    // Simple winner determination: player who finished first or is furthest ahead
-    if (players.size() < 2) return 0;
-    
-    if (players[0]->GetCurrentLap() > players[1]->GetCurrentLap()) {
-        return 0;
-    } else if (players[1]->GetCurrentLap() > players[0]->GetCurrentLap()) {
-        return 1;
-    } else {
-        // Same lap, check checkpoints
-        if (players[0]->GetCheckpointsPassed() >= players[1]->GetCheckpointsPassed()) {
-            return 0;
-        } else {
-            return 1;
+    // Whoever leads the rankings: furthest ahead, the lowest ID on a tie
+    for (size_t i = 0; i < players.size(); i++) {
+        if (players[i]->GetRacePosition() == 1) {
+            return (int)i;
         }
     }
+    return 0;
 }
 
 void LevelManager::UnlockLevel(int levelID) {
     if (levelID > 0 && levelID < (int)unlockedLevels.size()) {
         unlockedLevels[levelID - 1] = true;
-        LOG_INFO("Unlocked level " + std::to_string(levelID));
+        LOG_INFO("Unlocked level %d", levelID);
     }
 }
 
@@ -315,6 +628,36 @@ bool LevelManager::IsLevelUnlocked(int levelID) const {
     return false;
 }
 
+PlayerProgress LevelManager::GetProgress() const {
+    PlayerProgress progress = {};
+    progress.stats = careerStats;
+    std::copy(std::begin(bestLaps), std::end(bestLaps), progress.bestLaps);
+    for (size_t i = 0; i < unlockedLevels.size() && i < 32; i++) {
+        if (unlockedLevels[i]) progress.unlockedLevels |= 1u << i;
+    }
+    return progress;
+}
+
+void LevelManager::SetProgress(const PlayerProgress& progress) {
+    careerStats = progress.stats;
+    if (!players.empty()) {
+        players[0]->SetStats(progress.stats);
+    }
+    std::copy(std::begin(progress.bestLaps), std::end(progress.bestLaps), bestLaps);
+    for (size_t i = 0; i < unlockedLevels.size() && i < 32; i++) {
+        unlockedLevels[i] = (progress.unlockedLevels & (1u << i)) != 0;
+    }
+    unlockedLevels[0] = true;
+}
+
+void LevelManager::RecordBestLap(float lapTime) {
+    if (currentLevelID < 1 || currentLevelID > PlayerProgress::TRACK_COUNT) return;
+    float& best = bestLaps[currentLevelID - 1];
+    if (best <= 0.0f || lapTime < best) {
+        best = lapTime;
+    }
+}
+
 void LevelManager::UpdateRaceProgress(float deltaTime) {
     raceTime += deltaTime;
     
@@ -327,31 +670,248 @@ void LevelManager::UpdateRaceProgress(float deltaTime) {
     }
 }
 
+void LevelManager::SetHumanInput(int playerID, const RacerInput& input) {
+    if (playerID < 0) return;
+    if ((int)humanInputs.size() <= playerID) {
+        humanInputs.resize(playerID + 1);
+    }
+    humanInputs[playerID] = input;
+}
+
+RacerInput LevelManager::ReadDeviceInput(int playerID) const {
+    // One lookup per tick; includes taps that came and went since the last
+    ActionBits actions = inputManager->TakeTickActions(playerID);
+    // Partly, for a gamepad stick or trigger only partly pushed
+    auto held = [&](InputAction action) {
+        return actions.test((size_t)action) ? inputManager->GetActionAmount(playerID, action) : 0.0f;
+    };
+    float accel = held(InputAction::ACCELERATE);
+    float brake = held(InputAction::BRAKE);
+    float turn = held(InputAction::TURN_RIGHT) - held(InputAction::TURN_LEFT);
+    bool nitroPressed = actions.test((size_t)InputAction::NITRO);
+    
+    return RacerInput::FromAxes(accel, brake, turn, nitroPressed);
+}
+
+void RaceSnapshot::Reserve(size_t playerCount, size_t obstacleCount) {
+    static_assert(std::is_trivially_copyable<Player::State>::value, "racer state must be copyable as bytes");
+    static_assert(std::is_trivially_copyable<Obstacle::State>::value, "obstacle state must be copyable as bytes");
+
+    size_t obstaclesOffset = AlignUp(PLAYERS_OFFSET + playerCount * sizeof(Player::State), alignof(Obstacle::State));
+    buffer.resize(obstaclesOffset + obstacleCount * sizeof(Obstacle::State));
+    GetHeader().playerCount = (uint32_t)playerCount;
+    GetHeader().obstacleCount = (uint32_t)obstacleCount;
+}
+
+void LevelManager::SaveState(RaceSnapshot& snapshot) const {
+    const auto& obstacles = currentTrack->GetObstacles();
+    snapshot.Reserve(players.size(), obstacles.size());
+
+    RaceSnapshot::Header& header = snapshot.GetHeader();
+    header.raceState = raceState;
+    header.countdownTimer = countdownTimer;
+    header.raceTime = raceTime;
+    header.raceTick = raceTick;
+
+    Player::State* playerStates = snapshot.GetPlayers();
+    for (size_t i = 0; i < players.size(); i++) {
+        players[i]->SaveState(playerStates[i]);
+    }
+
+    Obstacle::State* obstacleStates = snapshot.GetObstacles();
+    for (size_t i = 0; i < obstacles.size(); i++) {
+        obstacles[i]->SaveState(obstacleStates[i]);
+    }
+}
+
+bool LevelManager::LoadState(const RaceSnapshot& snapshot) {
+    if (snapshot.IsEmpty() || !currentTrack) return false;
+
+    const RaceSnapshot::Header& header = snapshot.GetHeader();
+    const auto& obstacles = currentTrack->GetObstacles();
+    if (header.playerCount != players.size() || header.obstacleCount != obstacles.size()) {
+        return false;
+    }
+
+    raceState = header.raceState;
+    countdownTimer = header.countdownTimer;
+    raceTime = header.raceTime;
+    raceTick = header.raceTick;
+
+    const Player::State* playerStates = snapshot.GetPlayers();
+    for (size_t i = 0; i < players.size(); i++) {
+        players[i]->LoadState(playerStates[i]);
+    }
+
+    const Obstacle::State* obstacleStates = snapshot.GetObstacles();
+    for (size_t i = 0; i < obstacles.size(); i++) {
+        obstacles[i]->LoadState(obstacleStates[i]);
+    }
+    return true;
+}
+
+void LevelManager::FinishGhostLap(float lapTime) {
+    const Bike* bike = players[0]->GetBike();
+    ghostRecorder.EndLap(bike->GetPosition(), bike->GetRotation());
+
+    if (!ghost.IsLoaded() || lapTime < ghost.GetLapTime()) {
+        // Unmapped first: the file is replaced underneath
+        std::string path = GetGhostPath(currentLevelID);
+        ghost.Unload();
+        ghostRecorder.Save(path, lapTime);
+        ghost.Load(path);
+    }
+
+    // The next lap starts where this one ended
+    ghostRecorder.BeginLap(bike->GetPosition(), bike->GetRotation());
+}
+
+std::string LevelManager::GetGhostPath(int levelID) const {
+    return Config::GHOSTS_PATH + "track" + std::to_string(levelID) + ".ghost";
+}
+
+void LevelManager::GatherInputs() {
+    tickInputs.resize(players.size());
+
+    if (replaySource) {
+        // Recorded inputs stand in for the AI and the devices; past the end
+        // of the recording everyone coasts
+        if (!replaySource->ReadTick(tickInputs)) {
+            std::fill(tickInputs.begin(), tickInputs.end(), RacerInput{});
+        }
+        tickInputs.resize(players.size());
+    } else {
+        {
+            SectionTimer timer(PerfSection::AI);
+            SenseAI();
+        }
+        const AIParams& difficultyParams = aiParams[std::clamp(currentLevelID, 1, AIParams::DIFFICULTY_COUNT) - 1];
+        for (size_t i = 0; i < players.size(); i++) {
+            Player* player = players[i].get();
+
+            if (player->IsAI()) {
+                SectionTimer timer(PerfSection::AI);
+                tickInputs[i] = player->DriveAI(currentTrack->GetRacingLine(), difficultyParams, aiSensors[i]);
+            } else if (externalHumanInput) {
+                tickInputs[i] = i < humanInputs.size() ? humanInputs[i] : RacerInput{};
+            } else {
+                SectionTimer timer(PerfSection::INPUT);
+                tickInputs[i] = ReadDeviceInput(player->GetID());
+            }
+        }
+    }
+
+    if (replayWriter && replayWriter->IsRecording()) {
+        replayWriter->RecordTick(tickInputs);
+    }
+}
+
+void LevelManager::EnsureStaticGrid() {
+    const auto& obstacles = currentTrack->GetObstacles();
+    if (staticGridObstacles == (int)obstacles.size()) return;
+
+    staticGrid.Clear();
+    movingPlatforms.clear();
+    for (int i = 0; i < (int)obstacles.size(); i++) {
+        if (obstacles[i]->GetType() == ObstacleType::MOVING_PLATFORM) {
+            movingPlatforms.push_back(i);
+            continue;
+        }
+        Vector3 position = obstacles[i]->GetPosition();
+        staticGrid.Add({position.x, position.z}, ObstacleRadius(*obstacles[i]), i);
+    }
+    staticGrid.Build();
+    staticGridObstacles = (int)obstacles.size();
+}
+
+void LevelManager::SenseAI() {
+    PROFILE_SCOPE("LevelManager::SenseAI");
+    aiSensors.resize(players.size(), AISensors::Clear());
+    const auto& obstacles = currentTrack->GetObstacles();
+
+    EnsureStaticGrid();
+
+    movingGrid.Clear();
+    for (int index : movingPlatforms) {
+        Vector3 position = obstacles[index]->GetPosition();
+        movingGrid.Add({position.x, position.z}, ObstacleRadius(*obstacles[index]), -1);
+    }
+    for (size_t i = 0; i < players.size(); i++) {
+        Vector3 position = players[i]->GetBike()->GetPosition();
+        movingGrid.Add({position.x, position.z}, BIKE_SENSE_RADIUS, (int)i);
+    }
+    movingGrid.Build();
+
+    sensorRays.clear();
+    for (size_t i = 0; i < players.size(); i++) {
+        if (!players[i]->IsAI()) continue;
+        const Bike* bike = players[i]->GetBike();
+        Vector3 position = bike->GetPosition();
+        Vector3 heading = bike->GetDirection();
+        for (int ray = 0; ray < AISensors::RAY_COUNT; ray++) {
+            // Rotated the same way Bike::ApplyTurn turns, so positive
+            // angles are on the right-turn side
+            float angle = AISensors::RayAngle(ray) * DEG2RAD;
+            Vector2 direction = {heading.x * cosf(angle) + heading.z * sinf(angle),
+                                 -heading.x * sinf(angle) + heading.z * cosf(angle)};
+            sensorRays.push_back({{position.x, position.z}, Vector2Normalize(direction), AISensors::RANGE, (int)i});
+        }
+    }
+
+    staticHits.resize(sensorRays.size());
+    movingHits.resize(sensorRays.size());
+    staticGrid.CastRays(sensorRays.data(), (int)sensorRays.size(), staticHits.data());
+    movingGrid.CastRays(sensorRays.data(), (int)sensorRays.size(), movingHits.data());
+
+    size_t next = 0;
+    for (size_t i = 0; i < players.size(); i++) {
+        if (!players[i]->IsAI()) continue;
+        Vector3 velocity = players[i]->GetBike()->GetVelocity();
+        AISensors& sensors = aiSensors[i];
+        for (int ray = 0; ray < AISensors::RAY_COUNT; ray++, next++) {
+            const SensorRay& sensorRay = sensorRays[next];
+            bool movingFirst = movingHits[next].distance < staticHits[next].distance;
+            const SensorHit& hit = movingFirst ? movingHits[next] : staticHits[next];
+            float closing = velocity.x * sensorRay.direction.x + velocity.z * sensorRay.direction.y;
+            if (movingFirst && hit.owner >= 0) {
+                Vector3 otherVelocity = players[hit.owner]->GetBike()->GetVelocity();
+                closing -= otherVelocity.x * sensorRay.direction.x + otherVelocity.z * sensorRay.direction.y;
+            }
+            sensors.clearance[ray] = hit.distance / AISensors::RANGE;
+            sensors.closingSpeed[ray] = closing;
+        }
+    }
+}
+
 void LevelManager::UpdatePlayerPositions() {
+    PROFILE_SCOPE("LevelManager::UpdatePlayerPositions");
     // Determine positions based on lap and checkpoints for all players
     if (players.empty()) return;
     
-    // Create a list of player indices sorted by race progress
-    std::vector<int> rankings;
+    // Sort players by race progress (laps, then checkpoints), most first.
+    // A counting sort: progress is a small integer, so this stays linear
+    // with thousands of racers. Ties keep player order.
+    int perLap = std::max(currentTrack->GetTotalCheckpoints(), 1);
+    auto progress = [&](const Player& player) {
+        return std::max((player.GetCurrentLap() - 1) * perLap + player.GetCheckpointsPassed(), 0);
+    };
+    int maxProgress = 0;
+    for (const auto& player : players) {
+        maxProgress = std::max(maxProgress, progress(*player));
+    }
+
+    rankCounts.assign(maxProgress + 2, 0);
+    for (const auto& player : players) {
+        rankCounts[maxProgress - progress(*player) + 1]++;
+    }
+    for (int slot = 1; slot <= maxProgress + 1; slot++) {
+        rankCounts[slot] += rankCounts[slot - 1];
+    }
+    rankings.resize(players.size());
     for (size_t i = 0; i < players.size(); i++) {
-        rankings.push_back(i);
+        rankings[rankCounts[maxProgress - progress(*players[i])]++] = (int)i;
     }
     
-    // Sort players by: lap (descending), then checkpoints (descending)
-    std::sort(rankings.begin(), rankings.end(), [this](int a, int b) {
-        int lapA = players[a]->GetCurrentLap();
-        int lapB = players[b]->GetCurrentLap();
-        
-        if (lapA != lapB) {
-            return lapA > lapB; // Higher lap = better position
-        }
-        
-        // Same lap, check checkpoints
-        int cpA = players[a]->GetCheckpointsPassed();
-        int cpB = players[b]->GetCheckpointsPassed();
-        return cpA > cpB; // More checkpoints = better position
-    });
-    
     // Assign positions based on ranking
     for (size_t i = 0; i < rankings.size(); i++) {
         players[rankings[i]]->SetRacePosition(i + 1); // Position 1,2,3,4,5...
@@ -359,6 +919,7 @@ void LevelManager::UpdatePlayerPositions() {
 }
 
 void LevelManager::CheckCheckpoints() {
+    PROFILE_SCOPE("LevelManager::CheckCheckpoints");
     if (!currentTrack) return;
     
     for (auto& player : players) {
@@ -371,6 +932,11 @@ void LevelManager::CheckCheckpoints() {
             
             // Check if completed a lap
             if (currentCheckpoint + 1 >= currentTrack->GetTotalCheckpoints()) {
+                // Best laps count in solo races only, like ghosts
+                if (ghostsEnabled && player == players[0]) {
+                    FinishGhostLap(player->GetCurrentLapTime());
+                    RecordBestLap(player->GetCurrentLapTime());
+                }
                 player->FinishLap(player->GetCurrentLapTime());
                 player->SetCheckpointsPassed(0);
             }
@@ -379,13 +945,32 @@ void LevelManager::CheckCheckpoints() {
 }
 
 void LevelManager::CheckCollisions() {
-    auto physicsEngine = GameEngine::GetInstance().GetPhysicsEngine();
-    
-    // Check ALL bike-to-bike collisions (every pair)
+    PROFILE_SCOPE("LevelManager::CheckCollisions");
+    // Bike-to-bike: only pairs close enough to touch, in the same order as
+    // checking every pair (i < j)
+    bikeGrid.Clear();
     for (size_t i = 0; i < players.size(); i++) {
-        for (size_t j = i + 1; j < players.size(); j++) {
-            if (players[i]->GetBike() && players[j]->GetBike()) {
-                physicsEngine->ResolveCollision(players[i]->GetBike(), players[j]->GetBike());
+        Vector3 position = players[i]->GetBike()->GetPosition();
+        bikeGrid.Add({position.x, position.z}, 0.0f, (int)i);
+    }
+    bikeGrid.Build();
+
+    for (size_t i = 0; i < players.size(); i++) {
+        Vector3 position = players[i]->GetBike()->GetPosition();
+        bikeGrid.Query({position.x, position.z}, 2.0f * BIKE_COLLISION_RADIUS + BIKE_CONTACT_SLACK, contacts);
+        for (int j : contacts) {
+            if (j > (int)i) {
+                Bike* bike = players[i]->GetBike();
+                Bike* other = players[j]->GetBike();
+                Vector3 offset = Vector3Subtract(other->GetPosition(), bike->GetPosition());
+                float distance = Vector3Length(offset);
+                if (distance > 0.0f && distance < 2.0f * BIKE_COLLISION_RADIUS) {
+                    float closing = Vector3DotProduct(Vector3Subtract(bike->GetVelocity(), other->GetVelocity()), offset) / distance;
+                    if (closing > IMPACT_MIN_SPEED && !impactsMuted && impacts.size() < IMPACT_CAPACITY) {
+                        impacts.push_back({Vector3Lerp(bike->GetPosition(), other->GetPosition(), 0.5f), closing});
+                    }
+                }
+                physicsEngine->ResolveCollision(bike, other);
             }
         }
     }
@@ -393,13 +978,22 @@ void LevelManager::CheckCollisions() {
     // Check bike-obstacle collisions
     if (!currentTrack) return;
     
+    // Candidates are the static obstacles whose circle holds the bike plus
+    // every moving platform, checked in obstacle order
+    EnsureStaticGrid();
+    const auto& obstacles = currentTrack->GetObstacles();
     for (auto& player : players) {
         if (!player->GetBike()) continue;
         
         Vector3 bikePos = player->GetBike()->GetPosition();
-        const float BIKE_COLLISION_RADIUS = 2.0f;
-        
-        for (const auto& obstacle : currentTrack->GetObstacles()) {
+        staticGrid.Query({bikePos.x, bikePos.z}, 0.0f, contacts);
+        if (!movingPlatforms.empty()) {
+            contacts.insert(contacts.end(), movingPlatforms.begin(), movingPlatforms.end());
+            std::sort(contacts.begin(), contacts.end());
+        }
+
+        for (int index : contacts) {
+            const auto& obstacle = obstacles[index];
             if (obstacle->CheckCollision(bikePos, BIKE_COLLISION_RADIUS)) {
                 // Apply obstacle effect (currently none for solid obstacles)
                 obstacle->ApplyEffect(player->GetBike());
@@ -414,6 +1008,11 @@ void LevelManager::CheckCollisions() {
                 float distance = Vector3Length(pushDirection);
                 if (distance > 0.01f) {
                     pushDirection = Vector3Normalize(pushDirection);
+
+                    float closing = -Vector3DotProduct(player->GetBike()->GetVelocity(), pushDirection);
+                    if (closing > IMPACT_MIN_SPEED && !impactsMuted && impacts.size() < IMPACT_CAPACITY) {
+                        impacts.push_back({bikePos, closing});
+                    }
                     
                     // Push bike away from obstacle
                     float pushStrength = 800.0f; // Increased from 500.0f for stronger collision
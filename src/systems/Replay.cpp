@@ -0,0 +1,233 @@
+#include "systems/Replay.h"
+#include "net/PacketIO.h"
+#include "utils/Logger.h"
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+
+namespace {
+    constexpr char MAGIC[4] = {'B', 'R', 'R', 'P'};
+    constexpr uint8_t VERSION = 1;
+    constexpr int MAX_RACERS = 1 << 16;   // Sanity limit when loading
+
+    // Change mask bits
+    constexpr uint32_t FIELD_ACCELERATE = 1 << 0;
+    constexpr uint32_t FIELD_BRAKE = 1 << 1;
+    constexpr uint32_t FIELD_TURN = 1 << 2;
+    constexpr uint32_t FIELD_NITRO = 1 << 3;
+    constexpr int MASK_BITS = 4;
+
+    // The packet varints, appended to and read from a growing buffer
+    void WriteVarint(std::vector<uint8_t>& out, uint32_t value) {
+        uint8_t bytes[5];
+        out.insert(out.end(), bytes, bytes + PacketIO::WriteVarint(bytes, value));
+    }
+
+    bool ReadVarint(const std::vector<uint8_t>& in, size_t& pos, uint32_t& value) {
+        int size = PacketIO::ReadVarint(in.data() + pos, in.data() + in.size(), value);
+        pos += size;
+        return size > 0;
+    }
+
+    void WriteFixed(std::vector<uint8_t>& out, uint64_t value, int bytes) {
+        for (int i = 0; i < bytes; i++) {
+            out.push_back((uint8_t)(value >> (8 * i)));
+        }
+    }
+
+    bool ReadFixed(const std::vector<uint8_t>& in, size_t& pos, uint64_t& value, int bytes) {
+        if (pos + bytes > in.size()) return false;
+        value = 0;
+        for (int i = 0; i < bytes; i++) {
+            value |= (uint64_t)in[pos++] << (8 * i);
+        }
+        return true;
+    }
+}
+
+ReplayWriter::ReplayWriter() :
+    header{},
+    tick(0),
+    lastRecordTick(0),
+    recording(false),
+    finished(false)
+{
+}
+
+void ReplayWriter::Begin(const ReplayHeader& raceHeader) {
+    header = raceHeader;
+    header.tickCount = 0;
+    header.finalChecksum = 0;
+    stream.clear();
+    previous.assign(header.racerCount, RacerInput{});
+    tick = 0;
+    lastRecordTick = 0;
+    recording = true;
+    finished = false;
+}
+
+void ReplayWriter::RecordTick(const std::vector<RacerInput>& inputs) {
+    if (!recording) return;
+
+    for (int racer = 0; racer < header.racerCount && racer < (int)inputs.size(); racer++) {
+        const RacerInput& input = inputs[racer];
+        RacerInput& last = previous[racer];
+        if (input == last) continue;
+
+        uint32_t mask = 0;
+        if (input.accelerate != last.accelerate) mask |= FIELD_ACCELERATE;
+        if (input.brake != last.brake) mask |= FIELD_BRAKE;
+        if (input.turn != last.turn) mask |= FIELD_TURN;
+        if (input.nitro != last.nitro) mask |= FIELD_NITRO;
+
+        WriteVarint(stream, tick - lastRecordTick);
+        WriteVarint(stream, ((uint32_t)racer << MASK_BITS) | mask);
+        if (mask & FIELD_ACCELERATE) WriteVarint(stream, PacketIO::ZigZag(input.accelerate - last.accelerate));
+        if (mask & FIELD_BRAKE) WriteVarint(stream, PacketIO::ZigZag(input.brake - last.brake));
+        if (mask & FIELD_TURN) WriteVarint(stream, PacketIO::ZigZag(input.turn - last.turn));
+
+        last = input;
+        lastRecordTick = tick;
+    }
+    tick++;
+}
+
+void ReplayWriter::Finish(uint64_t finalChecksum) {
+    if (!recording) return;
+    header.tickCount = tick;
+    header.finalChecksum = finalChecksum;
+    recording = false;
+    finished = true;
+}
+
+bool ReplayWriter::SaveToFile(const std::string& path) const {
+    if (!finished) return false;
+
+    std::vector<uint8_t> data(std::begin(MAGIC), std::end(MAGIC));
+    data.push_back(VERSION);
+    WriteVarint(data, header.tickRate);
+    WriteVarint(data, header.trackID);
+    WriteVarint(data, header.bikeIndex);
+    WriteVarint(data, header.racerCount);
+    WriteFixed(data, header.seed, 4);
+    WriteVarint(data, header.tickCount);
+    WriteFixed(data, header.finalChecksum, 8);
+    WriteVarint(data, (uint32_t)stream.size());
+    data.insert(data.end(), stream.begin(), stream.end());
+
+    std::ofstream file(path, std::ios::binary);
+    if (!file.write((const char*)data.data(), data.size())) {
+        LOG_ERROR("Failed to write replay: %s", path);
+        return false;
+    }
+
+    LOG_INFO("Saved replay %s (%u ticks, %zu bytes)", path, header.tickCount, data.size());
+    return true;
+}
+
+ReplayReader::ReplayReader() :
+    header{},
+    readPos(0),
+    tick(0),
+    nextRecordTick(0),
+    hasPendingRecord(false),
+    corrupt(false)
+{
+}
+
+bool ReplayReader::LoadFromFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        LOG_ERROR("Failed to open replay: %s", path);
+        return false;
+    }
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    size_t pos = 0;
+    uint32_t tickRate, trackID, bikeIndex, racerCount, tickCount, streamSize;
+    uint64_t seed, checksum;
+    bool ok = data.size() > sizeof(MAGIC) &&
+              std::equal(std::begin(MAGIC), std::end(MAGIC), data.begin()) &&
+              data[sizeof(MAGIC)] == VERSION;
+    pos = sizeof(MAGIC) + 1;
+    ok = ok && ReadVarint(data, pos, tickRate) && ReadVarint(data, pos, trackID) &&
+         ReadVarint(data, pos, bikeIndex) && ReadVarint(data, pos, racerCount) &&
+         ReadFixed(data, pos, seed, 4) && ReadVarint(data, pos, tickCount) &&
+         ReadFixed(data, pos, checksum, 8) && ReadVarint(data, pos, streamSize) &&
+         racerCount > 0 && racerCount <= MAX_RACERS && streamSize == data.size() - pos;
+    if (!ok) {
+        LOG_ERROR("Not a valid replay file: %s", path);
+        return false;
+    }
+
+    header.tickRate = (int)tickRate;
+    header.trackID = (int)trackID;
+    header.bikeIndex = (int)bikeIndex;
+    header.racerCount = (int)racerCount;
+    header.seed = (uint32_t)seed;
+    header.tickCount = (uint32_t)tickCount;
+    header.finalChecksum = checksum;
+
+    stream.assign(data.begin() + pos, data.end());
+    readPos = 0;
+    current.assign(header.racerCount, RacerInput{});
+    tick = 0;
+    nextRecordTick = 0;
+    corrupt = false;
+    hasPendingRecord = ReadNextRecordTick();
+
+    LOG_INFO("Loaded replay %s (track %d, %d racers, %u ticks)", path, header.trackID,
+             header.racerCount, header.tickCount);
+    return true;
+}
+
+bool ReplayReader::ReadNextRecordTick() {
+    if (readPos >= stream.size()) return false;
+    uint32_t gap;
+    if (!ReadVarint(stream, readPos, gap)) {
+        corrupt = true;
+        return false;
+    }
+    nextRecordTick += gap;
+    return true;
+}
+
+bool ReplayReader::ApplyRecord() {
+    uint32_t racerAndMask;
+    if (!ReadVarint(stream, readPos, racerAndMask)) return false;
+    uint32_t racer = racerAndMask >> MASK_BITS;
+    uint32_t mask = racerAndMask & ((1u << MASK_BITS) - 1);
+    if (racer >= current.size()) return false;
+
+    RacerInput& input = current[racer];
+    int8_t* axes[] = {&input.accelerate, &input.brake, &input.turn};
+    uint32_t axisFields[] = {FIELD_ACCELERATE, FIELD_BRAKE, FIELD_TURN};
+    for (int i = 0; i < 3; i++) {
+        if (!(mask & axisFields[i])) continue;
+        uint32_t delta;
+        if (!ReadVarint(stream, readPos, delta)) return false;
+        *axes[i] = (int8_t)(*axes[i] + PacketIO::UnZigZag(delta));
+    }
+    if (mask & FIELD_NITRO) {
+        input.nitro = !input.nitro;
+    }
+    return true;
+}
+
+bool ReplayReader::ReadTick(std::vector<RacerInput>& inputs) {
+    if (corrupt || IsAtEnd()) return false;
+
+    while (hasPendingRecord && nextRecordTick == tick) {
+        if (!ApplyRecord()) {
+            LOG_ERROR("Replay stream corrupt at tick %u", tick);
+            corrupt = true;
+            return false;
+        }
+        hasPendingRecord = ReadNextRecordTick();
+    }
+    if (corrupt) return false;
+
+    inputs = current;
+    tick++;
+    return true;
+}
@@ -0,0 +1,283 @@
+#include "systems/SaveGame.h"
+#include "utils/Crc32.h"
+#include "utils/Logger.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    constexpr char MAGIC[4] = {'B', 'R', 'S', 'V'};
+    constexpr uint32_t VERSION = 1;
+    constexpr uint16_t RECORD_VERSION = 1;   // Every record type is still at its first layout
+
+    template <typename T>
+    std::vector<unsigned char> Encode(const T& value) {
+        std::vector<unsigned char> payload(sizeof(T));
+        std::memcpy(payload.data(), &value, sizeof(T));
+        return payload;
+    }
+
+    template <typename T>
+    bool Decode(const unsigned char* payload, uint32_t size, T& value) {
+        if (size != sizeof(T)) return false;
+        std::memcpy(&value, payload, sizeof(T));
+        return true;
+    }
+
+    // Until this returns, the data may still only be in the OS cache, and
+    // a power cut could leave the renamed file empty
+    bool SyncToDisk(std::FILE* file) {
+        if (std::fflush(file) != 0) return false;
+#ifdef _WIN32
+        return _commit(_fileno(file)) == 0;
+#else
+        return fsync(fileno(file)) == 0;
+#endif
+    }
+
+    // So the rename itself survives a power cut (POSIX only; Windows
+    // commits renames with the file system metadata)
+    void SyncDirectory(const std::filesystem::path& directory) {
+#ifndef _WIN32
+        int fd = open(directory.empty() ? "." : directory.c_str(), O_RDONLY);
+        if (fd >= 0) {
+            fsync(fd);
+            close(fd);
+        }
+#else
+        (void)directory;
+#endif
+    }
+}
+
+static_assert(sizeof(SaveFileHeader) == 16, "Save header layout changed");
+static_assert(sizeof(SaveRecordHeader) == 12, "Save record header layout changed");
+
+SaveGame::SaveGame(const std::string& path) :
+    path(path),
+    pending{},
+    hasPending(false),
+    writing(false),
+    stopping(false),
+    writeCount(0)
+{
+    writer = std::thread(&SaveGame::WriterLoop, this);
+}
+
+SaveGame::~SaveGame() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_one();
+    writer.join();
+}
+
+bool SaveGame::Load(PlayerProgress& progress) {
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<unsigned char> data;
+    {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file) {
+            LOG_INFO("No save at %s, starting fresh", path);
+            return false;
+        }
+        std::streamoff size = file.tellg();
+        data.resize(size > 0 ? (size_t)size : 0);
+        file.seekg(0);
+        file.read(reinterpret_cast<char*>(data.data()), (std::streamsize)data.size());
+        if (!file) data.clear();
+    }
+
+    SaveFileHeader header = {};
+    bool valid = data.size() >= sizeof(header);
+    if (valid) {
+        std::memcpy(&header, data.data(), sizeof(header));
+        valid = std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) == 0 && header.version == VERSION;
+    }
+    if (!valid) {
+        LOG_WARNING("Ignoring invalid save: %s", path);
+        return false;
+    }
+
+    std::vector<Record> loaded;
+    int applied = 0;
+    int damaged = 0;
+    size_t offset = sizeof(header);
+    for (uint32_t i = 0; i < header.recordCount; i++) {
+        SaveRecordHeader record = {};
+        if (data.size() - offset < sizeof(record)) {
+            damaged++;
+            break;
+        }
+        std::memcpy(&record, data.data() + offset, sizeof(record));
+        offset += sizeof(record);
+        if (data.size() - offset < record.size) {
+            damaged++;
+            break;
+        }
+        const unsigned char* payload = data.data() + offset;
+        offset += record.size;
+        if (Crc32::Compute(payload, record.size) != record.crc) {
+            damaged++;
+            continue;
+        }
+
+        // Unknown types (from a newer build) are kept and written back as they were
+        bool ok = true;
+        if (record.version == RECORD_VERSION) {
+            switch (record.type) {
+                case SaveRecordType::STATS:
+                    ok = Decode(payload, record.size, progress.stats);
+                    break;
+                case SaveRecordType::BEST_LAPS:
+                    ok = Decode(payload, record.size, progress.bestLaps);
+                    break;
+                case SaveRecordType::UNLOCKS:
+                    ok = Decode(payload, record.size, progress.unlockedLevels);
+                    break;
+            }
+        }
+        if (!ok) {
+            damaged++;
+            continue;
+        }
+        applied++;
+        loaded.push_back({record.type, record.version, std::vector<unsigned char>(payload, payload + record.size)});
+    }
+    records = std::move(loaded);
+
+    double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    if (damaged > 0) {
+        LOG_WARNING("Save %s: skipped %d damaged records", path, damaged);
+    }
+    LOG_INFO("Loaded save %s (%d records, %zu bytes) in %.0f us", path, applied, data.size(), us);
+    return applied > 0;
+}
+
+void SaveGame::Save(const PlayerProgress& progress) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pending = progress;
+        hasPending = true;
+    }
+    wake.notify_one();
+}
+
+void SaveGame::Flush() {
+    std::unique_lock<std::mutex> lock(mutex);
+    idle.wait(lock, [this]() { return !hasPending && !writing; });
+}
+
+int SaveGame::GetWriteCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return writeCount;
+}
+
+void SaveGame::WriterLoop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        wake.wait(lock, [this]() { return hasPending || stopping; });
+        if (!hasPending) break;   // Stopping with nothing left to write
+
+        // Saves queued while this one is written coalesce into the next
+        PlayerProgress progress = pending;
+        hasPending = false;
+        writing = true;
+        lock.unlock();
+
+        // A failed write leaves the records as on disk, so the same
+        // progress is tried again on the next save
+        std::vector<Record> updated;
+        bool written = UpdateRecords(progress, updated) && WriteFile(updated);
+        if (written) records = std::move(updated);
+
+        lock.lock();
+        writing = false;
+        if (written) writeCount++;
+        idle.notify_all();
+    }
+}
+
+bool SaveGame::UpdateRecords(const PlayerProgress& progress, std::vector<Record>& updated) const {
+    const Record current[] = {
+        {SaveRecordType::STATS, RECORD_VERSION, Encode(progress.stats)},
+        {SaveRecordType::BEST_LAPS, RECORD_VERSION, Encode(progress.bestLaps)},
+        {SaveRecordType::UNLOCKS, RECORD_VERSION, Encode(progress.unlockedLevels)},
+    };
+
+    updated = records;
+    bool changed = false;
+    for (const Record& record : current) {
+        auto found = std::find_if(updated.begin(), updated.end(),
+                                  [&](const Record& saved) { return saved.type == record.type; });
+        if (found == updated.end()) {
+            updated.push_back(record);
+            changed = true;
+        } else if (found->version != record.version || found->payload != record.payload) {
+            // A newer build's layout of this record is replaced by ours
+            *found = record;
+            changed = true;
+        }
+    }
+    return changed;
+}
+
+bool SaveGame::WriteFile(const std::vector<Record>& contents) const {
+    std::vector<unsigned char> data(sizeof(SaveFileHeader));
+    SaveFileHeader header = {};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.recordCount = (uint32_t)contents.size();
+    std::memcpy(data.data(), &header, sizeof(header));
+    for (const Record& record : contents) {
+        SaveRecordHeader recordHeader = {};
+        recordHeader.type = record.type;
+        recordHeader.version = record.version;
+        recordHeader.size = (uint32_t)record.payload.size();
+        recordHeader.crc = Crc32::Compute(record.payload.data(), record.payload.size());
+        const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&recordHeader);
+        data.insert(data.end(), bytes, bytes + sizeof(recordHeader));
+        data.insert(data.end(), record.payload.begin(), record.payload.end());
+    }
+
+    std::error_code error;
+    std::filesystem::path target(path);
+    if (target.has_parent_path()) {
+        std::filesystem::create_directories(target.parent_path(), error);
+    }
+
+    std::string tempPath = path + ".tmp";
+    std::FILE* file = std::fopen(tempPath.c_str(), "wb");
+    if (!file) {
+        LOG_ERROR("Failed to open save for writing: %s", tempPath);
+        return false;
+    }
+    bool ok = std::fwrite(data.data(), 1, data.size(), file) == data.size() && SyncToDisk(file);
+    ok = (std::fclose(file) == 0) && ok;
+    if (!ok) {
+        LOG_ERROR("Failed to write save: %s", tempPath);
+        return false;
+    }
+
+    std::filesystem::rename(tempPath, target, error);
+    if (error) {
+        LOG_ERROR("Failed to replace save %s: %s", path, error.message());
+        return false;
+    }
+    SyncDirectory(target.parent_path());
+
+    LOG_INFO("Saved progress to %s (%zu bytes)", path, data.size());
+    return true;
+}
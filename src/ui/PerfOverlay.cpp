@@ -0,0 +1,253 @@
+#include "ui/PerfOverlay.h"
+#include "systems/AudioManager.h"
+#include "utils/AllocationCounter.h"
+#include "utils/Config.h"
+#include <algorithm>
+
+namespace {
+    // Accumulated by SectionTimer during the current frame. Per thread, so
+    // races ticked on server worker threads don't race the main thread; the
+    // overlay only ever reads the main thread's copy.
+    thread_local float sectionAccumMs[PerfOverlay::SECTION_COUNT] = {};
+
+    const char* SECTION_NAMES[PerfOverlay::SECTION_COUNT] = {
+        "Input", "AI", "Physics", "Checkpoints", "Collisions", "Ranking", "UI", "Render"
+    };
+
+    const Color SECTION_COLORS[PerfOverlay::SECTION_COUNT] = {
+        SKYBLUE, ORANGE, LIME, PINK, RED, PURPLE, YELLOW, BLUE
+    };
+
+    constexpr Color OTHER_COLOR = {130, 130, 130, 255};   // Frame time outside any section
+
+    constexpr int PANEL_X = 10;
+    constexpr int PANEL_Y = 10;
+    constexpr int PANEL_WIDTH = 2 * PerfOverlay::HISTORY_FRAMES + 20;
+    constexpr int GRAPH_HEIGHT = 120;
+    constexpr int FONT_SIZE = 10;
+}
+
+SectionTimer::~SectionTimer() {
+    auto end = std::chrono::steady_clock::now();
+    PerfOverlay::AddSectionTime(section, std::chrono::duration<float, std::milli>(end - start).count());
+}
+
+PerfOverlay::PerfOverlay() :
+    history{},
+    head(0),
+    count(0),
+    allocationsAtFrameStart(AllocationCounter::GetCount()),
+    renderScale(1.0f),
+    visible(false),
+    frameOnline(false),
+    frameRollbackDepth(0),
+    frameResimMs(0.0f),
+    frameTicksAhead(0),
+    frameSoundsActive(0),
+    frameSoundsStarted(0),
+    frameSoundsStolen(0),
+    frameSoundsCulled(0),
+    sortScratch{},
+    p99Ms(0.0f),
+    worstMs(0.0f),
+    worstAge(0),
+    sectionAvgMs{},
+    sectionMaxMs{},
+    maxRollbackDepth(0),
+    maxResimMs(0.0f),
+    windowSoundsStolen(0),
+    windowSoundsCulled(0)
+{
+}
+
+void PerfOverlay::AddSectionTime(PerfSection section, float ms) {
+    sectionAccumMs[(int)section] += ms;
+}
+
+float PerfOverlay::GetSectionTime(PerfSection section) {
+    return sectionAccumMs[(int)section];
+}
+
+void PerfOverlay::BeginFrame() {
+    std::fill(std::begin(sectionAccumMs), std::end(sectionAccumMs), 0.0f);
+    allocationsAtFrameStart = AllocationCounter::GetCount();
+    frameOnline = false;
+    frameSoundsActive = 0;
+    frameSoundsStarted = 0;
+    frameSoundsStolen = 0;
+    frameSoundsCulled = 0;
+}
+
+void PerfOverlay::SetNetStats(int rollbackDepth, float resimMs, int ticksAhead) {
+    frameOnline = true;
+    frameRollbackDepth = rollbackDepth;
+    frameResimMs = resimMs;
+    frameTicksAhead = ticksAhead;
+}
+
+void PerfOverlay::SetSoundStats(int active, int started, int stolen, int culled) {
+    frameSoundsActive = active;
+    frameSoundsStarted = started;
+    frameSoundsStolen = stolen;
+    frameSoundsCulled = culled;
+}
+
+void PerfOverlay::EndFrame(float frameMs, int drawCalls, int triangles, float scale) {
+    FrameSample& sample = history[head];
+    std::copy(std::begin(sectionAccumMs), std::end(sectionAccumMs), sample.sectionMs);
+    sample.frameMs = frameMs;
+    sample.drawCalls = drawCalls;
+    sample.triangles = triangles;
+    sample.allocations = (int)(AllocationCounter::GetCount() - allocationsAtFrameStart);
+    sample.online = frameOnline;
+    sample.rollbackDepth = frameOnline ? frameRollbackDepth : 0;
+    sample.resimMs = frameOnline ? frameResimMs : 0.0f;
+    sample.ticksAhead = frameOnline ? frameTicksAhead : 0;
+    sample.soundsActive = frameSoundsActive;
+    sample.soundsStarted = frameSoundsStarted;
+    sample.soundsStolen = frameSoundsStolen;
+    sample.soundsCulled = frameSoundsCulled;
+
+    head = (head + 1) % HISTORY_FRAMES;
+    count = std::min(count + 1, HISTORY_FRAMES);
+    renderScale = scale;
+
+    if (visible) {
+        UpdateSummary();
+    }
+}
+
+const PerfOverlay::FrameSample& PerfOverlay::GetSample(int age) const {
+    return history[(head - 1 - age + HISTORY_FRAMES) % HISTORY_FRAMES];
+}
+
+void PerfOverlay::UpdateSummary() {
+    std::fill(std::begin(sectionAvgMs), std::end(sectionAvgMs), 0.0f);
+    std::fill(std::begin(sectionMaxMs), std::end(sectionMaxMs), 0.0f);
+    worstMs = 0.0f;
+    worstAge = 0;
+    maxRollbackDepth = 0;
+    maxResimMs = 0.0f;
+    windowSoundsStolen = 0;
+    windowSoundsCulled = 0;
+
+    for (int age = 0; age < count; age++) {
+        const FrameSample& sample = GetSample(age);
+        sortScratch[age] = sample.frameMs;
+        if (sample.frameMs > worstMs) {
+            worstMs = sample.frameMs;
+            worstAge = age;
+        }
+        maxRollbackDepth = std::max(maxRollbackDepth, sample.rollbackDepth);
+        maxResimMs = std::max(maxResimMs, sample.resimMs);
+        windowSoundsStolen += sample.soundsStolen;
+        windowSoundsCulled += sample.soundsCulled;
+        for (int s = 0; s < SECTION_COUNT; s++) {
+            sectionAvgMs[s] += sample.sectionMs[s];
+            sectionMaxMs[s] = std::max(sectionMaxMs[s], sample.sectionMs[s]);
+        }
+    }
+
+    if (count == 0) {
+        p99Ms = 0.0f;
+        return;
+    }
+    for (int s = 0; s < SECTION_COUNT; s++) {
+        sectionAvgMs[s] /= count;
+    }
+
+    // Nearest-rank 99th percentile
+    int rank = std::max((count * 99 + 99) / 100 - 1, 0);
+    std::nth_element(sortScratch.begin(), sortScratch.begin() + rank, sortScratch.begin() + count);
+    p99Ms = sortScratch[rank];
+}
+
+void PerfOverlay::Render() const {
+    if (!visible || count == 0) return;
+
+    const FrameSample& last = GetSample(0);
+    int netLines = last.online ? 1 : 0;
+    int panelHeight = 62 + netLines * 14 + GRAPH_HEIGHT + 12 + ((SECTION_COUNT + 2) / 2) * 14;
+    DrawRectangle(PANEL_X, PANEL_Y, PANEL_WIDTH, panelHeight, Fade(BLACK, 0.75f));
+
+    int x = PANEL_X + 10;
+    int y = PANEL_Y + 8;
+    DrawText(TextFormat("Frame %.2f ms (%d FPS)   p99 %.2f ms   worst %.2f ms",
+                        last.frameMs, GetFPS(), p99Ms, worstMs),
+             x, y, FONT_SIZE, RAYWHITE);
+    y += 14;
+    DrawText(TextFormat("Draws %d   Tris %d   Allocs/frame %d   Scale %d%%",
+                        last.drawCalls, last.triangles, last.allocations,
+                        (int)(renderScale * 100.0f + 0.5f)),
+             x, y, FONT_SIZE, RAYWHITE);
+    y += 14;
+    DrawText(TextFormat("Voices %d/%d   Started %d   Stolen %d   Culled %d   (window: %d stolen, %d culled)",
+                        last.soundsActive, AudioManager::VOICE_COUNT, last.soundsStarted,
+                        last.soundsStolen, last.soundsCulled, windowSoundsStolen, windowSoundsCulled),
+             x, y, FONT_SIZE, RAYWHITE);
+    if (last.online) {
+        y += 14;
+        DrawText(TextFormat("Rollback %d ticks (max %d)   Resim %.2f ms (max %.2f)   Ahead %d",
+                            last.rollbackDepth, maxRollbackDepth, last.resimMs, maxResimMs,
+                            last.ticksAhead),
+                 x, y, FONT_SIZE, RAYWHITE);
+    }
+    y += 20;
+
+    // Stacked bars, newest on the right; the vertical scale fits the worst frame
+    float budgetMs = 1000.0f / Config::TARGET_FPS;
+    float scaleMs = std::max(worstMs, budgetMs) * 1.1f;
+    float pixelsPerMs = GRAPH_HEIGHT / scaleMs;
+    int graphBottom = y + GRAPH_HEIGHT;
+    int graphRight = x + 2 * HISTORY_FRAMES;
+
+    DrawRectangleLines(x - 1, y - 1, 2 * HISTORY_FRAMES + 2, GRAPH_HEIGHT + 2, DARKGRAY);
+
+    for (int age = 0; age < count; age++) {
+        const FrameSample& sample = GetSample(age);
+        int columnX = graphRight - 2 * (age + 1);
+        float stacked = 0.0f;
+        for (int s = 0; s < SECTION_COUNT; s++) {
+            float top = stacked + sample.sectionMs[s];
+            int y0 = graphBottom - (int)(top * pixelsPerMs);
+            int y1 = graphBottom - (int)(stacked * pixelsPerMs);
+            if (y1 > y0) {
+                DrawRectangle(columnX, y0, 2, y1 - y0, SECTION_COLORS[s]);
+            }
+            stacked = top;
+        }
+        if (sample.frameMs > stacked) {
+            int y0 = graphBottom - (int)(sample.frameMs * pixelsPerMs);
+            int y1 = graphBottom - (int)(stacked * pixelsPerMs);
+            if (y1 > y0) {
+                DrawRectangle(columnX, y0, 2, y1 - y0, OTHER_COLOR);
+            }
+        }
+    }
+
+    // Budget, p99 and worst-frame markers
+    int budgetY = graphBottom - (int)(budgetMs * pixelsPerMs);
+    DrawLine(x, budgetY, graphRight, budgetY, GREEN);
+    int p99Y = graphBottom - (int)(p99Ms * pixelsPerMs);
+    DrawLine(x, p99Y, graphRight, p99Y, GOLD);
+    DrawText("p99", graphRight - 18, p99Y - 10, FONT_SIZE, GOLD);
+    int worstX = graphRight - 2 * (worstAge + 1);
+    DrawRectangleLines(worstX - 1, y, 4, GRAPH_HEIGHT, RED);
+
+    // Legend: average / max per section over the window
+    y = graphBottom + 8;
+    for (int s = 0; s <= SECTION_COUNT; s++) {
+        int column = s % 2;
+        int row = s / 2;
+        int lx = x + column * HISTORY_FRAMES;
+        int ly = y + row * 14;
+        if (s < SECTION_COUNT) {
+            DrawRectangle(lx, ly + 1, 8, 8, SECTION_COLORS[s]);
+            DrawText(TextFormat("%-11s %5.2f avg %5.2f max", SECTION_NAMES[s], sectionAvgMs[s], sectionMaxMs[s]),
+                     lx + 12, ly, FONT_SIZE, RAYWHITE);
+        } else {
+            DrawRectangle(lx, ly + 1, 8, 8, OTHER_COLOR);
+            DrawText("Other (audio, untracked)", lx + 12, ly, FONT_SIZE, RAYWHITE);
+        }
+    }
+}
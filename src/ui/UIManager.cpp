@@ -3,18 +3,80 @@
 #include "core/InputManager.h"
 #include "systems/LevelManager.h"
 #include "utils/Config.h"
+#include "utils/Profiler.h"
+#include "rlgl.h"
+#include <algorithm>
+#include <cstdio>
 #include <string>
 
+namespace {
+    const char* OrdinalSuffix(int n) {
+        if (n % 100 >= 11 && n % 100 <= 13) return "th";
+        switch (n % 10) {
+            case 1: return "st";
+            case 2: return "nd";
+            case 3: return "rd";
+            default: return "th";
+        }
+    }
+
+    // Sentinel so the first UpdateHUD call formats every field
+    constexpr int HUD_UNSET = -1;
+}
+
 UIManager::UIManager() :
     currentState(UIState::MAIN_MENU),
     selectedMenuOption(0),
     maxMenuOptions(3),
     selectedBikeIndex(0), // Default to red bike
-    fontLoaded(false)
+    titleFont{},
+    fontLoaded(false),
+    menuCache{},
+    hudCache{},
+    resourcesLoaded(false),
+    menuCacheKey(HUD_UNSET),
+    hudDirty(true)
 {
     // Initialize HUD data
     player1HUD = {0.0f, 1, 3, 0.0f, 1};
     player2HUD = {0.0f, 1, 3, 0.0f, 2};
+    player1Display = {HUD_UNSET, HUD_UNSET, HUD_UNSET, HUD_UNSET, HUD_UNSET, "", "", "", ""};
+    player2Display = player1Display;
+}
+
+void UIManager::LoadResources() {
+    // Rasterize the glyph atlas once at the largest size we draw; smaller
+    // sizes are scaled down from it with bilinear filtering
+    std::string fontPath = Config::FONTS_PATH + "title.ttf";
+    if (FileExists(fontPath.c_str())) {
+        titleFont = LoadFontEx(fontPath.c_str(), 80, nullptr, 0);
+        fontLoaded = titleFont.texture.id != GetFontDefault().texture.id;
+    }
+    
+    if (fontLoaded) {
+        SetTextureFilter(titleFont.texture, TEXTURE_FILTER_BILINEAR);
+    } else {
+        // raylib's built-in font is already a prebuilt atlas
+        titleFont = GetFontDefault();
+    }
+    
+    menuCache = LoadRenderTexture(Config::SCREEN_WIDTH, Config::SCREEN_HEIGHT);
+    hudCache = LoadRenderTexture(Config::SCREEN_WIDTH, Config::SCREEN_HEIGHT);
+    resourcesLoaded = true;
+    menuCacheKey = HUD_UNSET;
+    hudDirty = true;
+}
+
+void UIManager::UnloadResources() {
+    if (!resourcesLoaded) return;
+    
+    if (fontLoaded) {
+        UnloadFont(titleFont);
+        fontLoaded = false;
+    }
+    UnloadRenderTexture(menuCache);
+    UnloadRenderTexture(hudCache);
+    resourcesLoaded = false;
 }
 
 void UIManager::Update(float deltaTime) {
@@ -79,37 +141,100 @@ void UIManager::Update(float deltaTime) {
     }
 }
 
-void UIManager::Render() const {
+void UIManager::Render() {
+    PROFILE_SCOPE("UIManager::Render");
+    if (!resourcesLoaded) {
+        if (!IsWindowReady()) return;
+        LoadResources();
+    }
+    
     switch (currentState) {
-        case UIState::MAIN_MENU:
-            RenderMainMenu();
-            break;
-        case UIState::BIKE_SELECT:
-            RenderBikeSelect();
-            break;
-        case UIState::LEVEL_SELECT:
-            RenderLevelSelect();
+        case UIState::IN_GAME:
+            // HUD is redrawn only when a displayed value changed
+            if (hudDirty) {
+                BeginCache(hudCache);
+                RenderInGameHUD();
+                EndCache();
+                hudDirty = false;
+            }
+            DrawCache(hudCache);
             break;
-        case UIState::IN_GAME: {
-            auto& levelMgr = *GameEngine::GetInstance().GetLevelManager();
-            if (levelMgr.GetPlayer(0) && levelMgr.GetPlayer(1)) {
-                RenderInGameHUD(*levelMgr.GetPlayer(0), *levelMgr.GetPlayer(1));
+            
+        case UIState::GAME_OVER: {
+            // Background and animations stay live, the results layer is cached
+            DrawRectangleGradientV(0, 0, Config::SCREEN_WIDTH, Config::SCREEN_HEIGHT, 
+                                   (Color){10, 10, 20, 255}, (Color){30, 20, 40, 255});
+            RenderConfetti();
+            
+            int key = GetMenuCacheKey();
+            if (key != menuCacheKey) {
+                BeginCache(menuCache);
+                RenderGameOver();
+                EndCache();
+                menuCacheKey = key;
             }
+            DrawCache(menuCache);
+            RenderChampionBlink();
             break;
         }
-        case UIState::PAUSE_MENU:
-            RenderPauseMenu();
-            break;
-        case UIState::GAME_OVER:
-            RenderGameOver();
+            
+        default: {
+            // Static menus are redrawn only when the selection changes
+            int key = GetMenuCacheKey();
+            if (key != menuCacheKey) {
+                BeginCache(menuCache);
+                switch (currentState) {
+                    case UIState::MAIN_MENU: RenderMainMenu(); break;
+                    case UIState::BIKE_SELECT: RenderBikeSelect(); break;
+                    case UIState::LEVEL_SELECT: RenderLevelSelect(); break;
+                    case UIState::PAUSE_MENU: RenderPauseMenu(); break;
+                    default: break;
+                }
+                EndCache();
+                menuCacheKey = key;
+            }
+            DrawCache(menuCache);
             break;
+        }
     }
 }
 
+int UIManager::GetMenuCacheKey() const {
+    return (int)currentState * 100 + selectedMenuOption * 10 + selectedBikeIndex;
+}
+
+void UIManager::BeginCache(RenderTexture2D& target) const {
+    BeginTextureMode(target);
+    ClearBackground(BLANK);
+    
+    // Accumulate premultiplied colour with proper coverage alpha, so
+    // translucent panels composite correctly when the cache is drawn
+    rlSetBlendFactorsSeparate(RL_SRC_ALPHA, RL_ONE_MINUS_SRC_ALPHA, RL_ONE, RL_ONE_MINUS_SRC_ALPHA,
+                              RL_FUNC_ADD, RL_FUNC_ADD);
+    BeginBlendMode(BLEND_CUSTOM_SEPARATE);
+}
+
+void UIManager::EndCache() const {
+    EndBlendMode();
+    EndTextureMode();
+}
+
+void UIManager::DrawCache(const RenderTexture2D& target) const {
+    // Render textures are stored upside down
+    Rectangle source = {0.0f, 0.0f, (float)target.texture.width, -(float)target.texture.height};
+    BeginBlendMode(BLEND_ALPHA_PREMULTIPLY);
+    DrawTextureRec(target.texture, source, {0.0f, 0.0f}, WHITE);
+    EndBlendMode();
+}
+
 void UIManager::SetState(UIState state) {
     currentState = state;
     selectedMenuOption = 0;
     
+    // Entering a screen always redraws it (results and HUD values may be new)
+    menuCacheKey = HUD_UNSET;
+    hudDirty = true;
+    
     // Set max menu options based on state
     switch (state) {
         case UIState::MAIN_MENU: maxMenuOptions = 3; break;
@@ -126,6 +251,33 @@ void UIManager::UpdateHUD(int playerID, float speed, int currentLap, int totalLa
     hud.totalLaps = totalLaps;
     hud.lapTime = lapTime;
     hud.position = position;
+    
+    // Reformat only the fields whose displayed value changed
+    HUDDisplay& display = (playerID == 0) ? player1Display : player2Display;
+    int shownSpeed = (int)speed;
+    int shownSeconds = (int)lapTime;
+    
+    if (shownSpeed != display.speed) {
+        display.speed = shownSpeed;
+        std::snprintf(display.speedText, sizeof(display.speedText), "%d km/h", shownSpeed);
+        hudDirty = true;
+    }
+    if (currentLap != display.currentLap || totalLaps != display.totalLaps) {
+        display.currentLap = currentLap;
+        display.totalLaps = totalLaps;
+        std::snprintf(display.lapText, sizeof(display.lapText), "%d/%d", currentLap, totalLaps);
+        hudDirty = true;
+    }
+    if (shownSeconds != display.seconds) {
+        display.seconds = shownSeconds;
+        std::snprintf(display.timeText, sizeof(display.timeText), "%ds", shownSeconds);
+        hudDirty = true;
+    }
+    if (position != display.position) {
+        display.position = position;
+        std::snprintf(display.positionText, sizeof(display.positionText), "%d%s", position, OrdinalSuffix(position));
+        hudDirty = true;
+    }
 }
 
 void UIManager::RenderMainMenu() const {
@@ -135,15 +287,15 @@ void UIManager::RenderMainMenu() const {
     
     // Title with shadow
     const char* title = "BIKE RACE GAME";
-    int titleWidth = MeasureText(title, 80);
+    int titleWidth = MeasureUIText(title, 80);
     int titleX = (Config::SCREEN_WIDTH - titleWidth) / 2;
-    DrawText(title, titleX + 3, 103, 80, (Color){0, 0, 0, 180}); // Shadow
-    DrawText(title, titleX, 100, 80, ORANGE);
+    DrawUIText(title, titleX + 3, 103, 80, (Color){0, 0, 0, 180}); // Shadow
+    DrawUIText(title, titleX, 100, 80, ORANGE);
     
     // Subtitle
     const char* subtitle = "Two-Player Racing Action";
-    int subWidth = MeasureText(subtitle, 25);
-    DrawText(subtitle, (Config::SCREEN_WIDTH - subWidth) / 2, 200, 25, SKYBLUE);
+    int subWidth = MeasureUIText(subtitle, 25);
+    DrawUIText(subtitle, (Config::SCREEN_WIDTH - subWidth) / 2, 200, 25, SKYBLUE);
     
     // Menu options with better styling
     const char* menuOptions[] = {"START GAME", "OPTIONS", "QUIT"};
@@ -151,7 +303,7 @@ void UIManager::RenderMainMenu() const {
         Color optionColor = (i == selectedMenuOption) ? YELLOW : WHITE;
         Color bgColor = (i == selectedMenuOption) ? (Color){255, 200, 0, 100} : (Color){70, 80, 100, 150};
         
-        int textWidth = MeasureText(menuOptions[i], 35);
+        int textWidth = MeasureUIText(menuOptions[i], 35);
         int boxX = (Config::SCREEN_WIDTH - textWidth - 60) / 2;
         int boxY = 300 + i * 70;
         
@@ -160,16 +312,16 @@ void UIManager::RenderMainMenu() const {
         DrawRectangleLines(boxX, boxY - 10, textWidth + 60, 50, optionColor);
         
         // Draw text
-        DrawText(menuOptions[i], boxX + 30, boxY, 35, optionColor);
+        DrawUIText(menuOptions[i], boxX + 30, boxY, 35, optionColor);
     }
     
     // Controls hint with icons
     DrawRectangle(200, 550, 880, 120, (Color){0, 0, 0, 150});
-    DrawText("CONTROLS", 520, 565, 30, GOLD);
-    DrawText("Player 1: W/A/S/D + LEFT SHIFT (Nitro)", 250, 605, 22, LIGHTGRAY);
-    DrawText("Player 2: ARROW KEYS + RIGHT SHIFT (Nitro)", 250, 635, 22, LIGHTGRAY);
+    DrawUIText("CONTROLS", 520, 565, 30, GOLD);
+    DrawUIText("Player 1: W/A/S/D + LEFT SHIFT (Nitro)", 250, 605, 22, LIGHTGRAY);
+    DrawUIText("Player 2: ARROW KEYS + RIGHT SHIFT (Nitro)", 250, 635, 22, LIGHTGRAY);
     
-    DrawText("Press ENTER to continue", 440, 680, 20, YELLOW);
+    DrawUIText("Press ENTER to continue", 440, 680, 20, YELLOW);
 }
 
 void UIManager::RenderBikeSelect() const {
@@ -188,7 +340,7 @@ void UIManager::RenderBikeSelect() const {
         Color bgColor = isSelected ? ColorAlpha(bikeColors[i], 0.3f) : ColorAlpha(bikeColors[i], 0.1f);
         int fontSize = isSelected ? 40 : 32;
         
-        int textWidth = MeasureText(bikeOptions[i], fontSize);
+        int textWidth = MeasureUIText(bikeOptions[i], fontSize);
         int boxX = (Config::SCREEN_WIDTH - textWidth - 80) / 2;
         int boxY = 300 + i * 100;
         
@@ -196,15 +348,15 @@ void UIManager::RenderBikeSelect() const {
         DrawRectangle(boxX, boxY - 10, textWidth + 80, 60, bgColor);
         if (isSelected) {
             DrawRectangleLines(boxX, boxY - 10, textWidth + 80, 60, YELLOW);
-            DrawText(">", boxX - 40, boxY, fontSize, YELLOW);
+            DrawUIText(">", boxX - 40, boxY, fontSize, YELLOW);
         }
         
         // Draw bike name
-        DrawText(bikeOptions[i], boxX + 40, boxY, fontSize, textColor);
+        DrawUIText(bikeOptions[i], boxX + 40, boxY, fontSize, textColor);
     }
     
-    DrawText("Use ARROW KEYS to select", Config::SCREEN_WIDTH / 2 - 150, 520, 22, LIGHTGRAY);
-    DrawText("Press ENTER to continue", Config::SCREEN_WIDTH / 2 - 135, Config::SCREEN_HEIGHT - 50, 20, YELLOW);
+    DrawUIText("Use ARROW KEYS to select", Config::SCREEN_WIDTH / 2 - 150, 520, 22, LIGHTGRAY);
+    DrawUIText("Press ENTER to continue", Config::SCREEN_WIDTH / 2 - 135, Config::SCREEN_HEIGHT - 50, 20, YELLOW);
 }
 
 void UIManager::RenderLevelSelect() const {
@@ -222,8 +374,8 @@ void UIManager::RenderLevelSelect() const {
         Color color = isSelected ? GOLD : LIGHTGRAY; // Gold for selected, lightgray for others
         int fontSize = isSelected ? 38 : 30;
         
-        std::string text = std::string(tracks[i]) + " " + difficulty[i];
-        int textWidth = MeasureText(text.c_str(), fontSize);
+        const char* text = TextFormat("%s %s", tracks[i], difficulty[i]);
+        int textWidth = MeasureUIText(text, fontSize);
         int x = Config::SCREEN_WIDTH / 2 - textWidth / 2;
         int y = 300 + i * 80;
         
@@ -233,63 +385,46 @@ void UIManager::RenderLevelSelect() const {
             DrawRectangleLines(x - 20, y - 10, textWidth + 40, fontSize + 20, GOLD);
         }
         
-        DrawText(text.c_str(), x, y, fontSize, color);
+        DrawUIText(text, x, y, fontSize, color);
     }
     
-    DrawText("Press ENTER to start race", Config::SCREEN_WIDTH / 2 - 135, Config::SCREEN_HEIGHT - 50, 22, YELLOW);
+    DrawUIText("Press ENTER to start race", Config::SCREEN_WIDTH / 2 - 135, Config::SCREEN_HEIGHT - 50, 22, YELLOW);
 }
 
-void UIManager::RenderInGameHUD(const Player& player1, const Player& player2) const {
-    // Player 1 HUD (left side) - Improved design
-    DrawRectangle(10, 10, 280, 180, (Color){0, 0, 0, 180});
-    DrawRectangleLines(10, 10, 280, 180, RED);
-    
-    DrawText("PLAYER 1", 25, 20, 28, RED);
-    DrawRectangle(25, 52, 100, 3, RED);
-    
-    std::string speed1 = std::to_string((int)player1.GetBike()->GetSpeed());
-    DrawText("SPEED", 25, 65, 18, LIGHTGRAY);
-    DrawText((speed1 + " km/h").c_str(), 25, 85, 24, WHITE);
-    
-    std::string lap1 = std::to_string(player1.GetCurrentLap()) + "/3";
-    DrawText("LAP", 25, 115, 18, LIGHTGRAY);
-    DrawText(lap1.c_str(), 25, 135, 24, GOLD);
+void UIManager::RenderInGameHUD() const {
+    // Player 1 HUD (left side) and Player 2 HUD (right side)
+    DrawPlayerHUD(0, {10, 10, 280, 180});
+    DrawPlayerHUD(1, {(float)(Config::SCREEN_WIDTH - 290), 10, 280, 180});
     
-    std::string pos1 = player1.GetRacePosition() == 1 ? "1st" : "2nd";
-    DrawText("POS", 160, 65, 18, LIGHTGRAY);
-    DrawText(pos1.c_str(), 160, 85, 32, player1.GetRacePosition() == 1 ? GREEN : ORANGE);
-    
-    std::string time1 = std::to_string((int)player1.GetCurrentLapTime()) + "s";
-    DrawText("TIME", 160, 130, 18, LIGHTGRAY);
-    DrawText(time1.c_str(), 160, 150, 20, SKYBLUE);
-    
-    // Player 2 HUD (right side) - Improved design
-    int p2X = Config::SCREEN_WIDTH - 290;
-    DrawRectangle(p2X, 10, 280, 180, (Color){0, 0, 0, 180});
-    DrawRectangleLines(p2X, 10, 280, 180, BLUE);
+    // Center instruction
+    const char* hint = "ESC - Pause";
+    DrawUIText(hint, (Config::SCREEN_WIDTH - MeasureUIText(hint, 18)) / 2, 10, 18, (Color){255, 255, 255, 150});
+}
+
+void UIManager::DrawPlayerHUD(int playerID, Rectangle hudArea) const {
+    const HUDDisplay& display = (playerID == 0) ? player1Display : player2Display;
+    Color accent = (playerID == 0) ? RED : BLUE;
+    const char* title = (playerID == 0) ? "PLAYER 1" : "CPU";
+    int x = (int)hudArea.x;
+    int y = (int)hudArea.y;
     
-    DrawText("CPU", p2X + 15, 20, 28, BLUE);
-    DrawRectangle(p2X + 15, 52, 100, 3, BLUE);
+    DrawRectangle(x, y, (int)hudArea.width, (int)hudArea.height, (Color){0, 0, 0, 180});
+    DrawRectangleLines(x, y, (int)hudArea.width, (int)hudArea.height, accent);
     
-    std::string speed2 = std::to_string((int)player2.GetBike()->GetSpeed());
-    DrawText("SPEED", p2X + 15, 65, 18, LIGHTGRAY);
-    DrawText((speed2 + " km/h").c_str(), p2X + 15, 85, 24, WHITE);
+    DrawUIText(title, x + 15, y + 10, 28, accent);
+    DrawRectangle(x + 15, y + 42, 100, 3, accent);
     
-    std::string lap2 = std::to_string(player2.GetCurrentLap()) + "/3";
-    DrawText("LAP", p2X + 15, 115, 18, LIGHTGRAY);
-    DrawText(lap2.c_str(), p2X + 15, 135, 24, GOLD);
+    DrawUIText("SPEED", x + 15, y + 55, 18, LIGHTGRAY);
+    DrawUIText(display.speedText, x + 15, y + 75, 24, WHITE);
     
-    std::string pos2 = player2.GetRacePosition() == 1 ? "1st" : "2nd";
-    DrawText("POS", p2X + 150, 65, 18, LIGHTGRAY);
-    DrawText(pos2.c_str(), p2X + 150, 85, 32, player2.GetRacePosition() == 1 ? GREEN : ORANGE);
+    DrawUIText("LAP", x + 15, y + 105, 18, LIGHTGRAY);
+    DrawUIText(display.lapText, x + 15, y + 125, 24, GOLD);
     
-    std::string time2 = std::to_string((int)player2.GetCurrentLapTime()) + "s";
-    DrawText("TIME", p2X + 150, 130, 18, LIGHTGRAY);
-    DrawText(time2.c_str(), p2X + 150, 150, 20, SKYBLUE);
+    DrawUIText("POS", x + 150, y + 55, 18, LIGHTGRAY);
+    DrawUIText(display.positionText, x + 150, y + 75, 32, display.position == 1 ? GREEN : ORANGE);
     
-    // Center instruction
-    const char* hint = "ESC - Pause";
-    DrawText(hint, (Config::SCREEN_WIDTH - MeasureText(hint, 18)) / 2, 10, 18, (Color){255, 255, 255, 150});
+    DrawUIText("TIME", x + 150, y + 120, 18, LIGHTGRAY);
+    DrawUIText(display.timeText, x + 150, y + 140, 20, SKYBLUE);
 }
 
 void UIManager::RenderPauseMenu() const {
@@ -305,22 +440,12 @@ void UIManager::RenderPauseMenu() const {
         Color color = (i == selectedMenuOption) ? YELLOW : WHITE;
         int fontSize = (i == selectedMenuOption) ? 35 : 28;
         const char* text = menuItems[i];
-        int textWidth = MeasureText(text, fontSize);
-        DrawText(text, Config::SCREEN_WIDTH / 2 - textWidth / 2, startY + i * 60, fontSize, color);
+        int textWidth = MeasureUIText(text, fontSize);
+        DrawUIText(text, Config::SCREEN_WIDTH / 2 - textWidth / 2, startY + i * 60, fontSize, color);
     }
 }
 
-void UIManager::RenderGameOver() const {
-    DrawRectangleGradientV(0, 0, Config::SCREEN_WIDTH, Config::SCREEN_HEIGHT, 
-                           (Color){10, 10, 20, 255}, (Color){30, 20, 40, 255});
-    
-    auto& levelMgr = *GameEngine::GetInstance().GetLevelManager();
-    int winner = levelMgr.GetWinner();
-    Player* player1 = levelMgr.GetPlayer(0);
-    Player* player2 = levelMgr.GetPlayer(1);
-    
-    if (!player1 || !player2) return;
-    
+void UIManager::RenderConfetti() const {
     // Confetti animation (simple particles)
     for (int i = 0; i < 50; i++) {
         int x = ((int)(GetTime() * 50) + i * 37) % Config::SCREEN_WIDTH;
@@ -328,32 +453,51 @@ void UIManager::RenderGameOver() const {
         Color confettiColor = (i % 4 == 0) ? GOLD : (i % 4 == 1) ? RED : (i % 4 == 2) ? BLUE : GREEN;
         DrawCircle(x, y, 5, confettiColor);
     }
+}
+
+void UIManager::RenderChampionBlink() const {
+    // Fun fact for winner
+    if (GetTime() - (int)GetTime() < 0.5) {  // Blink effect
+        int winner = GameEngine::GetInstance().GetLevelManager()->GetWinner();
+        const char* celebration = (winner == 0) ? "🎉 PLAYER 1 IS CHAMPION! 🎉" : "🎉 CPU IS CHAMPION! 🎉";
+        int celebWidth = MeasureUIText(celebration, 20);
+        DrawUIText(celebration, (Config::SCREEN_WIDTH - celebWidth) / 2, 660, 20, GOLD);
+    }
+}
+
+void UIManager::RenderGameOver() const {
+    // Static results layer; background, confetti and blinking text are drawn live
+    auto& levelMgr = *GameEngine::GetInstance().GetLevelManager();
+    int winner = levelMgr.GetWinner();
+    Player* player1 = levelMgr.GetPlayer(0);
+    Player* player2 = levelMgr.GetPlayer(1);
+    
+    if (!player1 || !player2) return;
     
     // Victory Title with shadow
     const char* title = "🏁 RACE COMPLETE! 🏁";
-    int titleWidth = MeasureText(title, 70);
-    DrawText(title, (Config::SCREEN_WIDTH - titleWidth) / 2 + 3, 53, 70, (Color){0, 0, 0, 180});
-    DrawText(title, (Config::SCREEN_WIDTH - titleWidth) / 2, 50, 70, GOLD);
+    int titleWidth = MeasureUIText(title, 70);
+    DrawUIText(title, (Config::SCREEN_WIDTH - titleWidth) / 2 + 3, 53, 70, (Color){0, 0, 0, 180});
+    DrawUIText(title, (Config::SCREEN_WIDTH - titleWidth) / 2, 50, 70, GOLD);
     
     // Winner announcement
-    Player* winnerPlayer = (winner == 0) ? player1 : player2;
     std::string winnerText = (winner == 0) ? "PLAYER 1 WINS!" : "CPU WINS!";
     Color winnerColor = (winner == 0) ? RED : BLUE;
     
-    int winnerWidth = MeasureText(winnerText.c_str(), 60);
+    int winnerWidth = MeasureUIText(winnerText.c_str(), 60);
     DrawRectangle(Config::SCREEN_WIDTH / 2 - winnerWidth / 2 - 40, 150, winnerWidth + 80, 100, (Color){0, 0, 0, 200});
     DrawRectangleLines(Config::SCREEN_WIDTH / 2 - winnerWidth / 2 - 40, 150, winnerWidth + 80, 100, winnerColor);
-    DrawText(winnerText.c_str(), Config::SCREEN_WIDTH / 2 - winnerWidth / 2, 170, 60, winnerColor);
+    DrawUIText(winnerText.c_str(), Config::SCREEN_WIDTH / 2 - winnerWidth / 2, 170, 60, winnerColor);
     
     // Crown emoji for winner
-    DrawText("👑", Config::SCREEN_WIDTH / 2 - 30, 120, 60, GOLD);
+    DrawUIText("👑", Config::SCREEN_WIDTH / 2 - 30, 120, 60, GOLD);
     
     // Podium/Results Box
     int boxY = 280;
     DrawRectangle(240, boxY, 800, 280, (Color){0, 0, 0, 180});
     DrawRectangleLines(240, boxY, 800, 280, GOLD);
     
-    DrawText("RACE RESULTS", 450, boxY + 15, 35, YELLOW);
+    DrawUIText("RACE RESULTS", 450, boxY + 15, 35, YELLOW);
     DrawRectangle(450, boxY + 55, 200, 3, YELLOW);
     
     // Player 1 stats
@@ -361,69 +505,73 @@ void UIManager::RenderGameOver() const {
     std::string p1Pos = (player1->GetRacePosition() == 1) ? "1st" : "2nd";
     Color p1PosColor = (player1->GetRacePosition() == 1) ? GOLD : LIGHTGRAY;
     
-    DrawText("PLAYER 1", 270, p1Y, 28, RED);
-    DrawText(p1Pos.c_str(), 450, p1Y, 28, p1PosColor);
+    DrawUIText("PLAYER 1", 270, p1Y, 28, RED);
+    DrawUIText(p1Pos.c_str(), 450, p1Y, 28, p1PosColor);
     
     std::string p1Laps = "Laps: " + std::to_string(player1->GetCurrentLap());
-    DrawText(p1Laps.c_str(), 550, p1Y, 22, LIGHTGRAY);
+    DrawUIText(p1Laps.c_str(), 550, p1Y, 22, LIGHTGRAY);
     
     std::string p1Time = "Best Lap: " + std::to_string((int)player1->GetBestLapTime()) + "s";
-    DrawText(p1Time.c_str(), 720, p1Y, 22, SKYBLUE);
+    DrawUIText(p1Time.c_str(), 720, p1Y, 22, SKYBLUE);
     
     std::string p1Points = "+" + std::to_string((player1->GetRacePosition() == 1) ? 100 : 50) + " pts";
-    DrawText(p1Points.c_str(), 270, p1Y + 35, 20, GREEN);
+    DrawUIText(p1Points.c_str(), 270, p1Y + 35, 20, GREEN);
     
     // Player 2 stats
     int p2Y = boxY + 155;
     std::string p2Pos = (player2->GetRacePosition() == 1) ? "1st" : "2nd";
     Color p2PosColor = (player2->GetRacePosition() == 1) ? GOLD : LIGHTGRAY;
     
-    DrawText("CPU", 270, p2Y, 28, BLUE);
-    DrawText(p2Pos.c_str(), 450, p2Y, 28, p2PosColor);
+    DrawUIText("CPU", 270, p2Y, 28, BLUE);
+    DrawUIText(p2Pos.c_str(), 450, p2Y, 28, p2PosColor);
     
     std::string p2Laps = "Laps: " + std::to_string(player2->GetCurrentLap());
-    DrawText(p2Laps.c_str(), 550, p2Y, 22, LIGHTGRAY);
+    DrawUIText(p2Laps.c_str(), 550, p2Y, 22, LIGHTGRAY);
     
     std::string p2Time = "Best Lap: " + std::to_string((int)player2->GetBestLapTime()) + "s";
-    DrawText(p2Time.c_str(), 720, p2Y, 22, SKYBLUE);
+    DrawUIText(p2Time.c_str(), 720, p2Y, 22, SKYBLUE);
     
     std::string p2Points = "+" + std::to_string((player2->GetRacePosition() == 1) ? 100 : 50) + " pts";
-    DrawText(p2Points.c_str(), 270, p2Y + 35, 20, GREEN);
+    DrawUIText(p2Points.c_str(), 270, p2Y + 35, 20, GREEN);
     
     // Total points display
     DrawRectangle(350, boxY + 220, 500, 45, (Color){30, 30, 30, 200});
     std::string totalP1 = "P1 Total: " + std::to_string(player1->GetTotalPoints()) + " pts";
     std::string totalP2 = "P2 Total: " + std::to_string(player2->GetTotalPoints()) + " pts";
-    DrawText(totalP1.c_str(), 380, boxY + 230, 24, RED);
-    DrawText(totalP2.c_str(), 620, boxY + 230, 24, BLUE);
+    DrawUIText(totalP1.c_str(), 380, boxY + 230, 24, RED);
+    DrawUIText(totalP2.c_str(), 620, boxY + 230, 24, BLUE);
     
     // Continue prompt
     const char* prompt = "Press ENTER to return to menu";
     DrawRectangle(380, 590, 520, 50, (Color){0, 0, 0, 150});
-    DrawText(prompt, 400, 600, 25, YELLOW);
-    
-    // Fun fact for winner
-    if (GetTime() - (int)GetTime() < 0.5) {  // Blink effect
-        const char* celebration = (winner == 0) ? "🎉 PLAYER 1 IS CHAMPION! 🎉" : "🎉 CPU IS CHAMPION! 🎉";
-        int celebWidth = MeasureText(celebration, 20);
-        DrawText(celebration, (Config::SCREEN_WIDTH - celebWidth) / 2, 660, 20, GOLD);
-    }
+    DrawUIText(prompt, 400, 600, 25, YELLOW);
 }
 
-void UIManager::DrawTitle(const std::string& title, int yPos) const {
+void UIManager::DrawTitle(const char* title, int yPos) const {
     int fontSize = 60;
-    int textWidth = MeasureText(title.c_str(), fontSize);
-    DrawText(title.c_str(), Config::SCREEN_WIDTH / 2 - textWidth / 2, yPos, fontSize, GOLD);
+    int textWidth = MeasureUIText(title, fontSize);
+    DrawUIText(title, Config::SCREEN_WIDTH / 2 - textWidth / 2, yPos, fontSize, GOLD);
 }
 
-void UIManager::DrawButton(Rectangle bounds, const std::string& text, Color color, bool highlighted) const {
+void UIManager::DrawButton(Rectangle bounds, const char* text, Color color, bool highlighted) const {
     Color bgColor = highlighted ? ColorAlpha(color, 0.5f) : ColorAlpha(color, 0.2f);
     DrawRectangleRec(bounds, bgColor);
     DrawRectangleLinesEx(bounds, 2, color);
     
-    int textWidth = MeasureText(text.c_str(), 24);
-    DrawText(text.c_str(), 
+    int textWidth = MeasureUIText(text, 24);
+    DrawUIText(text, 
              (int)bounds.x + ((int)bounds.width - textWidth) / 2,
              (int)bounds.y + ((int)bounds.height - 24) / 2,
              24, WHITE);
 }
+
+void UIManager::DrawUIText(const char* text, int x, int y, int fontSize, Color color) const {
+    // Same spacing rule DrawText uses for the default font
+    float spacing = fontLoaded ? fontSize * 0.05f : (float)(std::max(fontSize, 10) / 10);
+    DrawTextEx(titleFont, text, {(float)x, (float)y}, (float)fontSize, spacing, color);
+}
+
+int UIManager::MeasureUIText(const char* text, int fontSize) const {
+    float spacing = fontLoaded ? fontSize * 0.05f : (float)(std::max(fontSize, 10) / 10);
+    return (int)MeasureTextEx(titleFont, text, (float)fontSize, spacing).x;
+}
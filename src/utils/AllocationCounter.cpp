@@ -0,0 +1,28 @@
+#include "utils/AllocationCounter.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+    std::atomic<uint64_t> allocationCount{0};
+
+    void* CountedAlloc(std::size_t size) {
+        allocationCount.fetch_add(1, std::memory_order_relaxed);
+        void* ptr = std::malloc(size ? size : 1);
+        if (!ptr) throw std::bad_alloc();
+        return ptr;
+    }
+}
+
+uint64_t AllocationCounter::GetCount() {
+    return allocationCount.load(std::memory_order_relaxed);
+}
+
+// Replacement global allocation functions. The nothrow forms forward to these
+// in the standard library; over-aligned allocations keep the default versions.
+void* operator new(std::size_t size) { return CountedAlloc(size); }
+void* operator new[](std::size_t size) { return CountedAlloc(size); }
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { std::free(ptr); }
@@ -0,0 +1,297 @@
+#include "utils/AssetArchive.h"
+#include "utils/Crc32.h"
+#include "utils/Logger.h"
+#include "utils/ThreadPool.h"
+#include "raylib.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace {
+    constexpr char MAGIC[4] = {'B', 'R', 'P', 'K'};
+    constexpr uint32_t VERSION = 1;
+
+    // Compressed data must save at least this much to be kept compressed
+    constexpr float MIN_COMPRESSION_SAVING = 0.05f;
+    // raylib's inflater can look a few bytes past the end of the stream
+    // (an assert in debug builds), so compressed entries are zero-padded
+    constexpr int DEFLATE_PADDING = 8;
+
+    bool ReadWholeFile(const std::string& path, std::vector<unsigned char>& data) {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file) return false;
+        std::streamoff size = file.tellg();
+        if (size < 0) return false;
+        data.resize((size_t)size);
+        file.seekg(0);
+        file.read(reinterpret_cast<char*>(data.data()), size);
+        return (bool)file;
+    }
+
+    // Paths under the directory with '/' separators, sorted
+    bool ListFiles(const std::string& directory, std::vector<std::string>& names, std::error_code& error) {
+        namespace fs = std::filesystem;
+        names.clear();
+        for (fs::recursive_directory_iterator it(directory, error), end; !error && it != end; it.increment(error)) {
+            if (it->is_regular_file(error)) {
+                names.push_back(fs::relative(it->path(), directory, error).generic_string());
+            }
+        }
+        std::sort(names.begin(), names.end());
+        return !error;
+    }
+}
+
+static_assert(sizeof(AssetArchiveHeader) == 16, "Archive header layout changed");
+static_assert(sizeof(AssetArchiveEntry) == 32, "Archive entry layout changed");
+
+AssetArchive::AssetArchive() :
+    entries(nullptr),
+    names(nullptr),
+    entryCount(0),
+    cacheBytes(0)
+{
+}
+
+bool AssetArchive::Open(const std::string& archivePath) {
+    Close();
+    if (!file.Open(archivePath)) return false;
+
+    // Check the table of contents once, so lookups and loads can trust it
+    const uint8_t* base = file.GetData();
+    size_t size = file.GetSize();
+    AssetArchiveHeader header = {};
+    bool valid = size >= sizeof(header);
+    if (valid) {
+        std::memcpy(&header, base, sizeof(header));
+        valid = std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) == 0 &&
+                header.version == VERSION &&
+                header.namesSize > 0 &&
+                sizeof(header) + (uint64_t)header.entryCount * sizeof(AssetArchiveEntry) + header.namesSize <= size;
+    }
+    if (valid) {
+        entries = reinterpret_cast<const AssetArchiveEntry*>(base + sizeof(header));
+        names = reinterpret_cast<const char*>(entries + header.entryCount);
+        valid = names[header.namesSize - 1] == '\0';
+        for (uint32_t i = 0; valid && i < header.entryCount; i++) {
+            const AssetArchiveEntry& entry = entries[i];
+            valid = entry.nameOffset < header.namesSize &&
+                    entry.dataOffset + entry.storedSize <= size &&
+                    (entry.codec == AssetCodec::DEFLATE ||
+                     (entry.codec == AssetCodec::STORED && entry.storedSize == entry.size)) &&
+                    (i == 0 || std::strcmp(names + entries[i - 1].nameOffset, names + entry.nameOffset) < 0);
+        }
+    }
+    if (!valid) {
+        LOG_WARNING("Ignoring invalid asset archive: %s", archivePath);
+        Close();
+        return false;
+    }
+
+    entryCount = header.entryCount;
+    path = archivePath;
+    cache.assign(entryCount, nullptr);
+    LOG_INFO("Mounted asset archive %s (%u entries)", archivePath, entryCount);
+    return true;
+}
+
+void AssetArchive::Close() {
+    file.Close();
+    entries = nullptr;
+    names = nullptr;
+    entryCount = 0;
+    path.clear();
+    cache.clear();
+    cacheBytes = 0;
+}
+
+void AssetArchive::SetLooseRoot(const std::string& root) {
+    looseRoot = root;
+    looseNames.clear();
+    if (root.empty()) return;
+
+    std::error_code error;
+    if (std::filesystem::is_directory(root, error) && ListFiles(root, looseNames, error)) {
+        LOG_INFO("Loose assets under %s override the archive (%zu files)", root, looseNames.size());
+    }
+}
+
+const char* AssetArchive::GetEntryName(int index) const {
+    if (index < 0 || index >= (int)entryCount) return nullptr;
+    return names + entries[index].nameOffset;
+}
+
+const AssetArchiveEntry* AssetArchive::Find(const std::string& name) const {
+    const AssetArchiveEntry* end = entries + entryCount;
+    const AssetArchiveEntry* found = std::lower_bound(entries, end, name,
+        [this](const AssetArchiveEntry& entry, const std::string& key) {
+            return std::strcmp(names + entry.nameOffset, key.c_str()) < 0;
+        });
+    if (found == end || name != names + found->nameOffset) return nullptr;
+    return found;
+}
+
+bool AssetArchive::Contains(const std::string& name) const {
+    return IsOpen() && Find(name) != nullptr;
+}
+
+bool AssetArchive::Extract(const AssetArchiveEntry& entry, std::vector<unsigned char>& data) const {
+    const unsigned char* stored = file.GetData() + entry.dataOffset;
+    if (entry.codec == AssetCodec::STORED) {
+        data.assign(stored, stored + entry.size);
+    } else {
+        int size = 0;
+        unsigned char* inflated = DecompressData(stored, (int)entry.storedSize, &size);
+        if (!inflated) return false;
+        if ((uint32_t)size == entry.size) {
+            data.assign(inflated, inflated + size);
+        }
+        MemFree(inflated);
+        if ((uint32_t)size != entry.size) return false;
+    }
+    return Crc32::Compute(data.data(), data.size()) == entry.crc;
+}
+
+bool AssetArchive::LoadLoose(const std::string& name, std::vector<unsigned char>& data) const {
+    return std::binary_search(looseNames.begin(), looseNames.end(), name) && ReadWholeFile(looseRoot + name, data);
+}
+
+bool AssetArchive::LoadEntry(const AssetArchiveEntry& entry, std::vector<unsigned char>& data) const {
+    size_t index = &entry - entries;
+    std::shared_ptr<const std::vector<unsigned char>> cached;
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        cached = cache[index];
+    }
+    if (cached) {
+        data = *cached;
+        return true;
+    }
+
+    if (!Extract(entry, data)) return false;
+
+    // Two threads may inflate the same entry at once; either copy will do
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    if (!cache[index] && cacheBytes + data.size() <= CACHE_BUDGET) {
+        cache[index] = std::make_shared<const std::vector<unsigned char>>(data);
+        cacheBytes += data.size();
+    }
+    return true;
+}
+
+bool AssetArchive::Load(const std::string& name, std::vector<unsigned char>& data) const {
+    if (LoadLoose(name, data)) return true;
+
+    const AssetArchiveEntry* entry = IsOpen() ? Find(name) : nullptr;
+    if (!entry) {
+        data.clear();
+        return false;
+    }
+    if (!LoadEntry(*entry, data)) {
+        LOG_ERROR("Corrupt asset %s in %s", name, path);
+        data.clear();
+        return false;
+    }
+    return true;
+}
+
+int AssetArchive::LoadMany(const std::vector<std::string>& assetNames, std::vector<std::vector<unsigned char>>& data,
+                           ThreadPool* pool) const {
+    data.resize(assetNames.size());
+    std::atomic<int> loaded{0};
+    auto task = [&](int i) {
+        if (Load(assetNames[i], data[i])) {
+            loaded.fetch_add(1, std::memory_order_relaxed);
+        }
+    };
+    if (pool) {
+        pool->ParallelFor((int)assetNames.size(), task);
+    } else {
+        for (int i = 0; i < (int)assetNames.size(); i++) task(i);
+    }
+    return loaded.load();
+}
+
+bool AssetArchive::Pack(const std::string& directory, const std::string& archivePath) {
+    namespace fs = std::filesystem;
+    std::error_code error;
+
+    // Sorted, so the reader can binary search the names
+    std::vector<std::string> assetNames;
+    if (!ListFiles(directory, assetNames, error)) {
+        LOG_ERROR("Failed to list assets in %s: %s", directory, error.message());
+        return false;
+    }
+
+    std::vector<AssetArchiveEntry> toc(assetNames.size());
+    std::string nameBlock;
+    for (size_t i = 0; i < assetNames.size(); i++) {
+        toc[i].nameOffset = (uint32_t)nameBlock.size();
+        nameBlock += assetNames[i];
+        nameBlock += '\0';
+    }
+    if (nameBlock.empty()) nameBlock += '\0';
+
+    std::vector<unsigned char> blob;   // Every entry's stored bytes, in order
+    uint64_t dataStart = sizeof(AssetArchiveHeader) + toc.size() * sizeof(AssetArchiveEntry) + nameBlock.size();
+    std::vector<unsigned char> contents;
+    for (size_t i = 0; i < assetNames.size(); i++) {
+        if (!ReadWholeFile(directory + "/" + assetNames[i], contents)) {
+            LOG_ERROR("Failed to read asset %s", assetNames[i]);
+            return false;
+        }
+
+        AssetArchiveEntry& entry = toc[i];
+        entry.dataOffset = dataStart + blob.size();
+        entry.size = (uint32_t)contents.size();
+        entry.crc = Crc32::Compute(contents.data(), contents.size());
+        entry.codec = AssetCodec::STORED;
+
+        int compressedSize = 0;
+        unsigned char* compressed = contents.empty() ? nullptr
+                                  : CompressData(contents.data(), (int)contents.size(), &compressedSize);
+        if (compressed && compressedSize + DEFLATE_PADDING < contents.size() * (1.0f - MIN_COMPRESSION_SAVING)) {
+            entry.codec = AssetCodec::DEFLATE;
+            entry.storedSize = (uint32_t)(compressedSize + DEFLATE_PADDING);
+            blob.insert(blob.end(), compressed, compressed + compressedSize);
+            blob.insert(blob.end(), DEFLATE_PADDING, 0);
+        } else {
+            entry.storedSize = entry.size;
+            blob.insert(blob.end(), contents.begin(), contents.end());
+        }
+        if (compressed) MemFree(compressed);
+    }
+
+    AssetArchiveHeader header = {};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.entryCount = (uint32_t)toc.size();
+    header.namesSize = (uint32_t)nameBlock.size();
+
+    fs::path target(archivePath);
+    if (target.has_parent_path()) {
+        fs::create_directories(target.parent_path(), error);
+    }
+    std::string tempPath = archivePath + ".tmp";
+    {
+        std::ofstream out(tempPath, std::ios::binary);
+        out.write((const char*)&header, sizeof(header));
+        out.write((const char*)toc.data(), toc.size() * sizeof(AssetArchiveEntry));
+        out.write(nameBlock.data(), nameBlock.size());
+        out.write((const char*)blob.data(), blob.size());
+        if (!out) {
+            LOG_ERROR("Failed to write asset archive: %s", tempPath);
+            return false;
+        }
+    }
+    fs::rename(tempPath, target, error);
+    if (error) {
+        LOG_ERROR("Failed to replace asset archive %s: %s", archivePath, error.message());
+        return false;
+    }
+
+    LOG_INFO("Packed %zu assets into %s (%zu bytes of data)", toc.size(), archivePath, blob.size());
+    return true;
+}
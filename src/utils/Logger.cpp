@@ -0,0 +1,311 @@
+#include "utils/Logger.h"
+#include <cstdio>
+#include <ctime>
+#include <iostream>
+
+namespace {
+    constexpr auto IDLE_SLEEP = std::chrono::milliseconds(1);
+
+    const char* LevelToString(Logger::Level level) {
+        switch (level) {
+            case Logger::Level::DEBUG: return "DEBUG";
+            case Logger::Level::INFO: return "INFO";
+            case Logger::Level::WARNING: return "WARNING";
+            case Logger::Level::ERROR: return "ERROR";
+            default: return "UNKNOWN";
+        }
+    }
+
+    const char* GetColorCode(Logger::Level level) {
+        switch (level) {
+            case Logger::Level::DEBUG: return "\033[36m";    // Cyan
+            case Logger::Level::INFO: return "\033[32m";     // Green
+            case Logger::Level::WARNING: return "\033[33m";  // Yellow
+            case Logger::Level::ERROR: return "\033[31m";    // Red
+            default: return "\033[0m";                       // Reset
+        }
+    }
+}
+
+Logger::Logger() :
+    cells(new Cell[QUEUE_CAPACITY]),
+    enqueuePos(0),
+    dequeuePos(0),
+    droppedCount(0),
+    running(true),
+    writerGone(false),
+    consoleOutput(true),
+    reportedDrops(0),
+    steadyBase(Now()),
+    wallBase(std::chrono::system_clock::now()),
+    cachedSecond(-1),
+    cachedSecondText{}
+{
+    for (size_t i = 0; i < QUEUE_CAPACITY; i++) {
+        cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    line.reserve(512);
+    writer = std::thread(&Logger::WriterLoop, this);
+}
+
+Logger::~Logger() {
+    Shutdown();
+    if (logFile.is_open()) {
+        logFile.close();
+    }
+}
+
+void Logger::Init(const std::string& filename) {
+    std::lock_guard<std::mutex> lock(fileMutex);
+    logFile.open(filename, std::ios::app);
+    if (!logFile.is_open()) {
+        std::cerr << "Failed to open log file: " << filename << std::endl;
+    }
+}
+
+void Logger::Shutdown() {
+    if (!running.exchange(false)) return;
+    if (writer.joinable()) {
+        writer.join();
+    }
+    // From here on producers drain what they publish themselves. Anything
+    // published after the writer's last pass is either seen by this drain
+    // or by the producer, which then sees writerGone (the fences pair up).
+    writerGone.store(true, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    std::lock_guard<std::mutex> lock(drainMutex);
+    Drain();
+}
+
+Logger::Cell* Logger::ClaimCell() {
+    size_t pos = enqueuePos.load(std::memory_order_relaxed);
+    for (;;) {
+        Cell* cell = &cells[pos & (QUEUE_CAPACITY - 1)];
+        size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        intptr_t diff = (intptr_t)sequence - (intptr_t)pos;
+        if (diff == 0) {
+            if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                return cell;
+            }
+        } else if (diff < 0) {
+            // Writer hasn't caught up: drop rather than wait
+            droppedCount.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        } else {
+            pos = enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+void Logger::PublishCell(Cell* cell) {
+    size_t pos = cell->sequence.load(std::memory_order_relaxed);
+    cell->sequence.store(pos + 1, std::memory_order_release);
+
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (writerGone.load(std::memory_order_relaxed)) {
+        // No writer any more (static destruction, after Shutdown)
+        std::lock_guard<std::mutex> lock(drainMutex);
+        Drain();
+    }
+}
+
+void Logger::CaptureText(Record& record, Arg& arg, const char* text, size_t length) {
+    arg.type = ArgType::STRING;
+    if (record.textUsed >= TEXT_CAPACITY) {
+        // Out of room: point at the terminator of the previous string
+        arg.textOffset = TEXT_CAPACITY - 1;
+        return;
+    }
+
+    arg.textOffset = record.textUsed;
+    size_t available = TEXT_CAPACITY - record.textUsed - 1;
+    if (length > available) length = available;   // Truncate, never block or allocate
+    if (length > 0) {
+        std::memcpy(record.text + record.textUsed, text, length);
+    }
+    record.text[record.textUsed + length] = '\0';
+    record.textUsed = (uint16_t)(record.textUsed + length + 1);
+}
+
+void Logger::WriterLoop() {
+    while (running.load(std::memory_order_acquire)) {
+        if (Drain() == 0) {
+            std::this_thread::sleep_for(IDLE_SLEEP);
+        }
+    }
+}
+
+size_t Logger::Drain() {
+    size_t written = 0;
+    for (;;) {
+        Cell* cell = &cells[dequeuePos & (QUEUE_CAPACITY - 1)];
+        size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        if (sequence != dequeuePos + 1) break;
+
+        FormatLine(cell->record, line);
+        WriteLine(cell->record.level, line);
+        cell->sequence.store(dequeuePos + QUEUE_CAPACITY, std::memory_order_release);
+        dequeuePos++;
+        written++;
+    }
+
+    uint64_t dropped = droppedCount.load(std::memory_order_relaxed);
+    if (dropped != reportedDrops) {
+        Record notice = {};
+        notice.timestamp = Now();
+        notice.format = "Log buffer full, dropped %llu messages";
+        notice.level = Level::WARNING;
+        notice.argCount = 1;
+        notice.args[0].type = ArgType::UINT;
+        notice.args[0].u = dropped - reportedDrops;
+        reportedDrops = dropped;
+
+        FormatLine(notice, line);
+        WriteLine(notice.level, line);
+        written++;
+    }
+
+    if (written > 0) {
+        // One flush per batch instead of one per line
+        std::fflush(stdout);
+        std::lock_guard<std::mutex> lock(fileMutex);
+        if (logFile.is_open()) {
+            logFile.flush();
+        }
+    }
+    return written;
+}
+
+void Logger::FormatLine(const Record& record, std::string& out) {
+    out.clear();
+    out += '[';
+    FormatTimestamp(record.timestamp, out);
+    out += "] [";
+    out += LevelToString(record.level);
+    out += "] ";
+    FormatMessage(record, out);
+}
+
+void Logger::FormatTimestamp(int64_t timestamp, std::string& out) {
+    // Steady timestamps are converted to wall time here, off the caller's thread
+    int64_t elapsed = timestamp - steadyBase;
+    auto wall = wallBase + std::chrono::duration_cast<std::chrono::system_clock::duration>(
+        std::chrono::nanoseconds(elapsed));
+    int64_t millis = std::chrono::duration_cast<std::chrono::milliseconds>(wall.time_since_epoch()).count();
+    int64_t second = millis / 1000;
+
+    if (second != cachedSecond) {
+        std::time_t seconds = (std::time_t)second;
+        std::strftime(cachedSecondText, sizeof(cachedSecondText), "%Y-%m-%d %H:%M:%S", std::localtime(&seconds));
+        cachedSecond = second;
+    }
+
+    char buf[8];
+    std::snprintf(buf, sizeof(buf), ".%03d", (int)(millis % 1000));
+    out += cachedSecondText;
+    out += buf;
+}
+
+void Logger::FormatMessage(const Record& record, std::string& out) const {
+    const char* p = record.format;
+    int argIndex = 0;
+    char spec[32];
+    char buf[128];
+
+    while (*p) {
+        if (*p != '%') {
+            out += *p++;
+            continue;
+        }
+        if (p[1] == '%') {
+            out += '%';
+            p += 2;
+            continue;
+        }
+
+        // Keep flags, width and precision; length modifiers are replaced by
+        // the width of the captured value
+        size_t len = 0;
+        spec[len++] = *p++;
+        while (*p && std::strchr("-+ #0123456789.", *p) && len < sizeof(spec) - 4) {
+            spec[len++] = *p++;
+        }
+        while (*p && std::strchr("hlLjzt", *p)) {
+            p++;
+        }
+        char conversion = *p;
+        if (!conversion) break;
+        p++;
+
+        if (argIndex >= record.argCount) {
+            out += "<missing>";
+            continue;
+        }
+        const Arg& arg = record.args[argIndex++];
+
+        long long asInt = arg.type == ArgType::DOUBLE ? (long long)arg.d :
+                          arg.type == ArgType::UINT ? (long long)arg.u : arg.i;
+        double asDouble = arg.type == ArgType::DOUBLE ? arg.d :
+                          arg.type == ArgType::UINT ? (double)arg.u : (double)arg.i;
+
+        switch (conversion) {
+            case 'd': case 'i': case 'u': case 'x': case 'X': case 'o':
+                if (arg.type == ArgType::STRING) {
+                    out += record.text + arg.textOffset;
+                    continue;
+                }
+                spec[len++] = 'l';
+                spec[len++] = 'l';
+                spec[len++] = conversion;
+                spec[len] = '\0';
+                std::snprintf(buf, sizeof(buf), spec, asInt);
+                break;
+            case 'c':
+                spec[len++] = 'c';
+                spec[len] = '\0';
+                std::snprintf(buf, sizeof(buf), spec, (int)asInt);
+                break;
+            case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+                spec[len++] = conversion;
+                spec[len] = '\0';
+                std::snprintf(buf, sizeof(buf), spec, asDouble);
+                break;
+            case 'p':
+                std::snprintf(buf, sizeof(buf), "%p", arg.p);
+                break;
+            case 's':
+            default:
+                if (arg.type == ArgType::STRING) {
+                    spec[len++] = 's';
+                    spec[len] = '\0';
+                    if (len == 2) {
+                        out += record.text + arg.textOffset;
+                        continue;
+                    }
+                    std::snprintf(buf, sizeof(buf), spec, record.text + arg.textOffset);
+                } else if (arg.type == ArgType::DOUBLE) {
+                    std::snprintf(buf, sizeof(buf), "%g", arg.d);
+                } else if (arg.type == ArgType::POINTER) {
+                    std::snprintf(buf, sizeof(buf), "%p", arg.p);
+                } else {
+                    std::snprintf(buf, sizeof(buf), arg.type == ArgType::UINT ? "%llu" : "%lld", asInt);
+                }
+                break;
+        }
+        out += buf;
+    }
+}
+
+void Logger::WriteLine(Level level, const std::string& text) {
+    // Console output with colors; one stdio call so lines never interleave
+    // with other stdout writers
+    if (consoleOutput.load(std::memory_order_relaxed)) {
+        std::fprintf(stdout, "%s%s\033[0m\n", GetColorCode(level), text.c_str());
+    }
+
+    // File output
+    std::lock_guard<std::mutex> lock(fileMutex);
+    if (logFile.is_open()) {
+        logFile << text << '\n';
+    }
+}
@@ -0,0 +1,74 @@
+#include "utils/Profiler.h"
+#include <cstdio>
+
+Profiler::Profiler() : startNs(Now()) {
+}
+
+Profiler::ThreadBuffer& Profiler::GetThreadBuffer() {
+    thread_local ThreadBuffer* buffer = nullptr;
+    if (!buffer) {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        auto created = std::make_unique<ThreadBuffer>();
+        created->events.reset(new ZoneEvent[EVENTS_PER_THREAD]);
+        created->writeIndex.store(0, std::memory_order_relaxed);
+        created->threadName = nullptr;
+        created->threadID = (int)buffers.size() + 1;
+        buffer = created.get();
+        buffers.push_back(std::move(created));
+    }
+    return *buffer;
+}
+
+void Profiler::Record(const char* name, int64_t zoneStartNs, int64_t zoneEndNs) {
+    ThreadBuffer& buffer = GetThreadBuffer();
+    uint64_t index = buffer.writeIndex.load(std::memory_order_relaxed);
+    ZoneEvent& event = buffer.events[index & (EVENTS_PER_THREAD - 1)];
+    event.name = name;
+    event.startNs = zoneStartNs;
+    event.endNs = zoneEndNs;
+    buffer.writeIndex.store(index + 1, std::memory_order_release);
+}
+
+void Profiler::SetThreadName(const char* name) {
+    GetThreadBuffer().threadName = name;
+}
+
+bool Profiler::WriteChromeTrace(const std::string& filename) {
+    FILE* file = std::fopen(filename.c_str(), "w");
+    if (!file) return false;
+
+    std::fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    bool first = true;
+
+    std::lock_guard<std::mutex> lock(registryMutex);
+    std::vector<ZoneEvent> snapshot;
+    snapshot.reserve(EVENTS_PER_THREAD);
+
+    for (const auto& buffer : buffers) {
+        // Copy first, then drop anything the owner may have overwritten meanwhile
+        uint64_t end = buffer->writeIndex.load(std::memory_order_acquire);
+        uint64_t begin = end > EVENTS_PER_THREAD ? end - EVENTS_PER_THREAD : 0;
+        snapshot.clear();
+        for (uint64_t i = begin; i < end; i++) {
+            snapshot.push_back(buffer->events[i & (EVENTS_PER_THREAD - 1)]);
+        }
+        uint64_t endAfter = buffer->writeIndex.load(std::memory_order_acquire);
+        size_t skip = endAfter > begin + EVENTS_PER_THREAD ? (size_t)(endAfter - begin - EVENTS_PER_THREAD) : 0;
+
+        const char* threadName = buffer->threadName ? buffer->threadName : "Thread";
+        std::fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+                     first ? "" : ",\n", buffer->threadID, threadName);
+        first = false;
+
+        for (size_t i = skip; i < snapshot.size(); i++) {
+            const ZoneEvent& event = snapshot[i];
+            std::fprintf(file, ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+                         event.name, buffer->threadID,
+                         (event.startNs - startNs) / 1000.0,
+                         (event.endNs - event.startNs) / 1000.0);
+        }
+    }
+
+    std::fprintf(file, "\n]}\n");
+    return std::fclose(file) == 0;
+}
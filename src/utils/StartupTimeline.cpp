@@ -0,0 +1,92 @@
+#include "utils/StartupTimeline.h"
+#include "utils/Logger.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+    const std::chrono::steady_clock::time_point PROCESS_START = std::chrono::steady_clock::now();
+
+    constexpr int BAR_WIDTH = 40;   // Characters spanning the whole timeline
+}
+
+double StartupTimeline::Now() {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - PROCESS_START).count();
+}
+
+void StartupTimeline::Record(const char* name, double startMs, double endMs) {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::thread::id id = std::this_thread::get_id();
+    auto found = std::find(threads.begin(), threads.end(), id);
+    if (found == threads.end()) {
+        found = threads.insert(threads.end(), id);
+    }
+    events.push_back({name, startMs, endMs, (int)(found - threads.begin()), startMs == endMs});
+}
+
+void StartupTimeline::Mark(const char* name) {
+    double now = Now();
+    Record(name, now, now);
+}
+
+double StartupTimeline::GetMark(const char* name) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const Event& event : events) {
+        if (event.mark && std::strcmp(event.name, name) == 0) {
+            return event.startMs;
+        }
+    }
+    return -1.0;
+}
+
+std::vector<StartupTimeline::Event> StartupTimeline::SortedEvents() const {
+    std::vector<Event> sorted;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        sorted = events;
+    }
+    // Phases are recorded when they end; report them by when they began
+    std::stable_sort(sorted.begin(), sorted.end(), [](const Event& a, const Event& b) {
+        return a.startMs < b.startMs;
+    });
+    return sorted;
+}
+
+void StartupTimeline::LogReport() const {
+    std::vector<Event> sorted = SortedEvents();
+    double endMs = 0.0;
+    for (const Event& event : sorted) {
+        endMs = std::max(endMs, event.endMs);
+    }
+    double scale = endMs > 0.0 ? BAR_WIDTH / endMs : 0.0;
+
+    LOG_INFO("Startup timeline (%.1f ms):", endMs);
+    for (const Event& event : sorted) {
+        char bar[BAR_WIDTH + 1];
+        int from = std::min((int)(event.startMs * scale), BAR_WIDTH - 1);
+        int to = std::max(std::min((int)(event.endMs * scale), BAR_WIDTH), from + 1);
+        for (int i = 0; i < BAR_WIDTH; i++) {
+            bar[i] = (i >= from && i < to) ? (event.mark ? '|' : '#') : '.';
+        }
+        bar[BAR_WIDTH] = '\0';
+        if (event.mark) {
+            LOG_INFO("  %8.2f ms           t%d %s %s", event.startMs, event.thread, bar, event.name);
+        } else {
+            LOG_INFO("  %8.2f ms %8.2f ms t%d %s %s", event.startMs, event.endMs - event.startMs, event.thread, bar,
+                     event.name);
+        }
+    }
+}
+
+void StartupTimeline::PrintReport() const {
+    std::vector<Event> sorted = SortedEvents();
+    std::printf("{\"startup\":[");
+    for (size_t i = 0; i < sorted.size(); i++) {
+        const Event& event = sorted[i];
+        std::printf("%s{\"name\":\"%s\",\"start_ms\":%.3f,\"ms\":%.3f,\"thread\":%d}", i ? "," : "", event.name,
+                    event.startMs, event.endMs - event.startMs, event.thread);
+    }
+    std::printf("]}\n");
+    std::fflush(stdout);
+}
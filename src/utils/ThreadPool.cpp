@@ -0,0 +1,76 @@
+#include "utils/ThreadPool.h"
+
+ThreadPool::ThreadPool(int workerCount) :
+    currentTask(nullptr),
+    taskCount(0),
+    nextIndex(0),
+    busyWorkers(0),
+    generation(0),
+    stopping(false)
+{
+    for (int i = 0; i < workerCount; i++) {
+        workers.emplace_back(&ThreadPool::WorkerLoop, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::ParallelFor(int count, const std::function<void(int)>& task) {
+    if (workers.empty() || count <= 1) {
+        for (int i = 0; i < count; i++) {
+            task(i);
+        }
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        currentTask = &task;
+        taskCount = count;
+        nextIndex.store(0, std::memory_order_relaxed);
+        busyWorkers = (int)workers.size();
+        generation++;
+    }
+    wake.notify_all();
+
+    RunTasks();
+
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [this]() { return busyWorkers == 0; });
+    currentTask = nullptr;
+}
+
+void ThreadPool::WorkerLoop() {
+    uint64_t seenGeneration = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [&]() { return stopping || generation != seenGeneration; });
+            if (stopping) return;
+            seenGeneration = generation;
+        }
+
+        RunTasks();
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--busyWorkers == 0) {
+            done.notify_one();
+        }
+    }
+}
+
+void ThreadPool::RunTasks() {
+    int index;
+    while ((index = nextIndex.fetch_add(1, std::memory_order_relaxed)) < taskCount) {
+        (*currentTask)(index);
+    }
+}
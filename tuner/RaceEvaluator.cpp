@@ -0,0 +1,90 @@
+#include "RaceEvaluator.h"
+#include "physics/PhysicsEngine.h"
+#include "systems/LevelManager.h"
+#include "utils/Config.h"
+#include "raymath.h"
+#include <algorithm>
+#include <random>
+
+namespace {
+    constexpr float BIKE_COLLISION_RADIUS = 2.0f;      // As in LevelManager::CheckCollisions
+    constexpr float BARRIER_SPREAD = 6.0f;             // Metres either side of the line
+    constexpr float GRID_CLEARANCE = 30.0f;            // No barriers this close to the start
+    constexpr float STALLED_PROGRESS = 0.5f;           // Checkpoints credited to a racer that never moved
+
+    // Barriers on and around the racing line, where they get in the way
+    void ScatterBarriers(Track& track, int count, uint32_t seed) {
+        const RacingLine& line = track.GetRacingLine();
+        if (line.IsEmpty()) return;
+
+        std::mt19937 rng(seed);
+        std::uniform_int_distribution<int> sample(0, line.GetSampleCount() - 1);
+        std::uniform_real_distribution<float> offset(-BARRIER_SPREAD, BARRIER_SPREAD);
+        Vector3 start = line.GetSample(0).position;
+        int placed = 0;
+        while (placed < count) {
+            int index = sample(rng);
+            Vector3 position = line.GetSample(index).position;
+            Vector3 ahead = Vector3Subtract(line.GetSample(line.Advance(index, 1)).position, position);
+            Vector3 across = Vector3Normalize({ahead.z, 0.0f, -ahead.x});
+            position = Vector3Add(position, Vector3Scale(across, offset(rng)));
+            if (Vector3Distance(position, start) < GRID_CLEARANCE) continue;
+            track.AddObstacle({position.x, 1.0f, position.z}, ObstacleType::STATIC_BARRIER, {2, 2, 2});
+            placed++;
+        }
+    }
+}
+
+RaceResult RunRace(const RaceSettings& settings, int trackID, uint32_t seed, const AIParams& params) {
+    PhysicsEngine physics;
+    LevelManager level;
+    level.Initialize(&physics, nullptr);
+    level.SetRacerCount(settings.racers);
+    AIParamsTable table;
+    table.fill(params);
+    level.SetAIParams(table);
+    level.SetHumanPlayerCount(0);
+    level.SetSeed(seed);
+    level.LoadLevel(trackID);
+
+    Track* track = level.GetCurrentTrack();
+    ScatterBarriers(*track, settings.extraObstacles, seed);
+    level.StartRace();
+
+    int maxTicks = (int)(settings.timeLimit / Config::FIXED_TIMESTEP);
+    int contactTicks = 0;
+    int racingTicks = 0;
+    while (!level.IsRaceFinished() && racingTicks < maxTicks) {
+        level.Update(Config::FIXED_TIMESTEP);
+        if (level.GetRaceState() != RaceState::RACING) continue;
+        racingTicks++;
+
+        for (int i = 0; i < level.GetPlayerCount(); i++) {
+            Vector3 position = level.GetPlayer(i)->GetBike()->GetPosition();
+            for (const auto& obstacle : track->GetObstacles()) {
+                if (obstacle->CheckCollision(position, BIKE_COLLISION_RADIUS)) {
+                    contactTicks++;
+                    break;
+                }
+            }
+        }
+    }
+
+    // Everyone is timed at the race's end; the rest of their race is
+    // projected at the pace they've managed so far
+    float raceSeconds = racingTicks * Config::FIXED_TIMESTEP;
+    int perLap = track->GetTotalCheckpoints();
+    float total = (float)(track->GetRequiredLaps() * perLap);
+    float pace = 0.0f;
+    for (int i = 0; i < level.GetPlayerCount(); i++) {
+        const Player* player = level.GetPlayer(i);
+        float progress = (float)((player->GetCurrentLap() - 1) * perLap + player->GetCheckpointsPassed());
+        pace += raceSeconds * total / std::max(progress, STALLED_PROGRESS);
+    }
+
+    RaceResult result;
+    result.pace = pace / level.GetPlayerCount();
+    result.contactSeconds = contactTicks * Config::FIXED_TIMESTEP / level.GetPlayerCount();
+    result.finished = level.IsRaceFinished();
+    return result;
+}
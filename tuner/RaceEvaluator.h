@@ -0,0 +1,26 @@
+#ifndef RACEEVALUATOR_H
+#define RACEEVALUATOR_H
+
+#include "entities/AIParams.h"
+#include <cstdint>
+
+struct RaceSettings {
+    int racers;            // All AI, all driving the candidate's parameters
+    int extraObstacles;    // Barriers scattered along the racing line per seed
+    float timeLimit;       // Seconds of racing before giving up
+};
+
+struct RaceResult {
+    float pace;                // Mean projected race time over the racers
+    float contactSeconds;      // Mean time per racer spent touching an obstacle
+    bool finished;             // Someone completed the race within the limit
+};
+
+// Runs one headless race: the seed shuffles the grid and places the extra
+// barriers, so every candidate can be raced on identical layouts. Racers
+// still going when the race ends are projected from their progress, which
+// also scores crashes and stalls. Safe to call from many threads at once;
+// each call has its own simulation.
+RaceResult RunRace(const RaceSettings& settings, int trackID, uint32_t seed, const AIParams& params);
+
+#endif // RACEEVALUATOR_H
@@ -0,0 +1,307 @@
+// BikeRaceTuner: headless evolutionary search over the AI driving
+// parameters. Every candidate races the same seeded layouts, all races of a
+// generation run in parallel, and the best set per difficulty is written to
+// the file the game loads. Progress is printed as one JSON line per
+// generation.
+//
+//     ./bin/BikeRaceTuner [--difficulty 0-3] [--population n] [--generations n]
+//                         [--seeds n] [--racers n] [--obstacles n]
+//                         [--threads n] [--seed s] [--out path]
+//
+// Hard is tuned for the fastest clean race. Medium and easy are tuned to
+// race a set margin slower than the best hard set on the same layouts, so
+// the levels stay apart however the tuning goes.
+
+#include "RaceEvaluator.h"
+#include "utils/Config.h"
+#include "utils/Logger.h"
+#include "utils/ThreadPool.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    constexpr float CONTACT_PENALTY = 3.0f;        // Seconds of cost per second touching a barrier
+    constexpr float UNFINISHED_PENALTY = 10.0f;    // Per race nobody finished
+    constexpr float SLOWER_THAN_HARD[] = {0.18f, 0.08f, 0.0f};   // Easy, medium, hard
+    constexpr int ELITE_COUNT = 2;
+    constexpr int TOURNAMENT_SIZE = 3;
+    constexpr float MUTATION_START = 0.12f;        // Gaussian sigma as a share of each field's range...
+    constexpr float MUTATION_END = 0.03f;          // ...narrowing over the generations
+    constexpr int VALIDATION_FINALISTS = 4;
+    constexpr int VALIDATION_SEED_FACTOR = 4;      // Final check uses this many times the seeds
+
+    using Genes = std::array<float, AIParams::FIELD_COUNT>;   // Each field mapped to [0, 1]
+
+    struct TunerSettings {
+        int difficulty;      // 0 for all three
+        int population;
+        int generations;
+        int seedsPerCandidate;
+        int threads;
+        uint32_t baseSeed;
+        std::string outPath;
+        RaceSettings race;
+    };
+
+    struct Candidate {
+        Genes genes;
+        float cost;
+        float pace;
+        float contactSeconds;
+    };
+
+    Genes ToGenes(const AIParams& params) {
+        Genes genes;
+        for (int i = 0; i < AIParams::FIELD_COUNT; i++) {
+            const AIParams::Field& field = AIParams::FIELDS[i];
+            genes[i] = std::clamp((params.*(field.member) - field.min) / (field.max - field.min), 0.0f, 1.0f);
+        }
+        return genes;
+    }
+
+    AIParams ToParams(const Genes& genes) {
+        AIParams params;
+        for (int i = 0; i < AIParams::FIELD_COUNT; i++) {
+            const AIParams::Field& field = AIParams::FIELDS[i];
+            params.*(field.member) = field.min + genes[i] * (field.max - field.min);
+        }
+        return params;
+    }
+
+    class Tuner {
+    public:
+        explicit Tuner(const TunerSettings& tunerSettings) :
+            settings(tunerSettings),
+            pool(std::max(tunerSettings.threads - 1, 0)),
+            rng(tunerSettings.baseSeed),
+            racesRun(0)
+        {
+        }
+
+        AIParams Tune(int difficulty, const AIParams& start, const AIParams& hard);
+        long long GetRacesRun() const { return racesRun; }
+        int GetThreadCount() const { return pool.GetThreadCount(); }
+
+    private:
+        // Races every candidate (and, below hard, the hard set as the
+        // reference) on the same seeds and fills in their costs
+        void Evaluate(std::vector<Candidate>& candidates, int difficulty, const AIParams& hard,
+                      uint32_t firstSeed, int seedCount);
+        Genes Breed(const std::vector<Candidate>& population, float sigma);
+        const Candidate& Tournament(const std::vector<Candidate>& population);
+
+        TunerSettings settings;
+        ThreadPool pool;
+        std::mt19937 rng;
+        long long racesRun;
+        std::vector<RaceResult> results;   // Scratch: candidate-major, seed-minor
+    };
+
+    void Tuner::Evaluate(std::vector<Candidate>& candidates, int difficulty, const AIParams& hard,
+                         uint32_t firstSeed, int seedCount) {
+        bool relative = SLOWER_THAN_HARD[difficulty - 1] > 0.0f;
+        int rows = (int)candidates.size() + (relative ? 1 : 0);
+        results.assign(rows * seedCount, RaceResult{});
+
+        pool.ParallelFor(rows * seedCount, [&](int job) {
+            int row = job / seedCount;
+            uint32_t seed = firstSeed + job % seedCount;
+            const AIParams params = (row < (int)candidates.size()) ? ToParams(candidates[row].genes) : hard;
+            results[job] = RunRace(settings.race, difficulty, seed, params);
+        });
+        racesRun += rows * seedCount;
+
+        const RaceResult* reference = relative ? &results[candidates.size() * seedCount] : nullptr;
+        for (size_t row = 0; row < candidates.size(); row++) {
+            Candidate& candidate = candidates[row];
+            candidate.cost = 0.0f;
+            candidate.pace = 0.0f;
+            candidate.contactSeconds = 0.0f;
+            for (int s = 0; s < seedCount; s++) {
+                const RaceResult& result = results[row * seedCount + s];
+                float timing = result.pace;
+                if (reference) {
+                    timing = fabsf(result.pace - reference[s].pace * (1.0f + SLOWER_THAN_HARD[difficulty - 1]));
+                }
+                candidate.cost += timing + CONTACT_PENALTY * result.contactSeconds +
+                                  (result.finished ? 0.0f : UNFINISHED_PENALTY);
+                candidate.pace += result.pace;
+                candidate.contactSeconds += result.contactSeconds;
+            }
+            candidate.cost /= seedCount;
+            candidate.pace /= seedCount;
+            candidate.contactSeconds /= seedCount;
+        }
+    }
+
+    const Candidate& Tuner::Tournament(const std::vector<Candidate>& population) {
+        std::uniform_int_distribution<int> pick(0, (int)population.size() - 1);
+        const Candidate* best = &population[pick(rng)];
+        for (int i = 1; i < TOURNAMENT_SIZE; i++) {
+            const Candidate& other = population[pick(rng)];
+            if (other.cost < best->cost) best = &other;
+        }
+        return *best;
+    }
+
+    Genes Tuner::Breed(const std::vector<Candidate>& population, float sigma) {
+        const Candidate& a = Tournament(population);
+        const Candidate& b = Tournament(population);
+        std::bernoulli_distribution coin(0.5);
+        std::normal_distribution<float> mutation(0.0f, sigma);
+        Genes child;
+        for (int i = 0; i < AIParams::FIELD_COUNT; i++) {
+            child[i] = std::clamp((coin(rng) ? a.genes[i] : b.genes[i]) + mutation(rng), 0.0f, 1.0f);
+        }
+        return child;
+    }
+
+    AIParams Tuner::Tune(int difficulty, const AIParams& start, const AIParams& hard) {
+        // The starting set plus mutants of it
+        std::vector<Candidate> population(settings.population);
+        population[0].genes = ToGenes(start);
+        std::normal_distribution<float> spread(0.0f, MUTATION_START * 2.0f);
+        for (size_t i = 1; i < population.size(); i++) {
+            for (int g = 0; g < AIParams::FIELD_COUNT; g++) {
+                population[i].genes[g] = std::clamp(population[0].genes[g] + spread(rng), 0.0f, 1.0f);
+            }
+        }
+
+        auto startTime = std::chrono::steady_clock::now();
+        long long startRaces = racesRun;
+        for (int generation = 0; generation < settings.generations; generation++) {
+            // Fresh seeds each generation so nothing overfits one layout;
+            // elites are re-raced on them too
+            uint32_t firstSeed = settings.baseSeed + (uint32_t)(generation * settings.seedsPerCandidate);
+            Evaluate(population, difficulty, hard, firstSeed, settings.seedsPerCandidate);
+            std::sort(population.begin(), population.end(),
+                      [](const Candidate& a, const Candidate& b) { return a.cost < b.cost; });
+
+            float meanCost = 0.0f;
+            for (const Candidate& candidate : population) {
+                meanCost += candidate.cost;
+            }
+            meanCost /= population.size();
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+            std::printf("{\"tuner\":\"generation\",\"difficulty\":\"%s\",\"generation\":%d,\"best_cost\":%.3f,"
+                        "\"mean_cost\":%.3f,\"best_pace_s\":%.2f,\"best_contact_s\":%.3f,\"races\":%lld,"
+                        "\"races_per_min\":%.0f}\n",
+                        AIParamsFile::GetSectionName(difficulty), generation, population[0].cost, meanCost,
+                        population[0].pace, population[0].contactSeconds, racesRun,
+                        seconds > 0.0 ? (racesRun - startRaces) * 60.0 / seconds : 0.0);
+            std::fflush(stdout);
+
+            if (generation + 1 == settings.generations) break;
+            float t = settings.generations > 1 ? generation / (float)(settings.generations - 1) : 1.0f;
+            float sigma = MUTATION_START + (MUTATION_END - MUTATION_START) * t;
+            std::vector<Candidate> next(population.begin(), population.begin() + ELITE_COUNT);
+            while ((int)next.size() < settings.population) {
+                next.push_back({Breed(population, sigma), 0.0f, 0.0f, 0.0f});
+            }
+            population.swap(next);
+        }
+
+        // One generation's seeds are noisy: settle it between the finalists
+        // and the starting set on a wider, unseen set of layouts
+        std::vector<Candidate> finalists(population.begin(),
+                                         population.begin() + std::min(VALIDATION_FINALISTS, (int)population.size()));
+        finalists.push_back({ToGenes(start), 0.0f, 0.0f, 0.0f});
+        uint32_t validationSeed = settings.baseSeed + (uint32_t)(settings.generations * settings.seedsPerCandidate);
+        Evaluate(finalists, difficulty, hard, validationSeed, settings.seedsPerCandidate * VALIDATION_SEED_FACTOR);
+        const Candidate& best = *std::min_element(finalists.begin(), finalists.end(),
+            [](const Candidate& a, const Candidate& b) { return a.cost < b.cost; });
+
+        std::printf("{\"tuner\":\"result\",\"difficulty\":\"%s\",\"cost\":%.3f,\"start_cost\":%.3f,"
+                    "\"pace_s\":%.2f,\"contact_s\":%.3f}\n",
+                    AIParamsFile::GetSectionName(difficulty), best.cost, finalists.back().cost,
+                    best.pace, best.contactSeconds);
+        return ToParams(best.genes);
+    }
+
+    std::string DescribeRun(const TunerSettings& settings) {
+        char text[256];
+        std::snprintf(text, sizeof(text),
+                      "AI driving parameters per difficulty, loaded at startup.\n"
+                      "Written by BikeRaceTuner (population %d, %d generations, %d seeds, %d racers, %d barriers).\n"
+                      "Fields left out keep their built-in defaults.",
+                      settings.population, settings.generations, settings.seedsPerCandidate,
+                      settings.race.racers, settings.race.extraObstacles);
+        return text;
+    }
+}
+
+int main(int argc, char** argv) {
+    TunerSettings settings = {};
+    settings.difficulty = 0;
+    settings.population = 32;
+    settings.generations = 20;
+    settings.seedsPerCandidate = 6;
+    settings.threads = std::max((int)std::thread::hardware_concurrency(), 1);
+    settings.baseSeed = 1000;
+    settings.outPath = Config::AI_PARAMS_FILE;
+    settings.race.racers = 5;
+    settings.race.extraObstacles = 8;
+    settings.race.timeLimit = 120.0f;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--difficulty" && hasValue) {
+            settings.difficulty = std::clamp(std::atoi(argv[++i]), 0, AIParams::DIFFICULTY_COUNT);
+        } else if (arg == "--population" && hasValue) {
+            settings.population = std::max(std::atoi(argv[++i]), ELITE_COUNT + 1);
+        } else if (arg == "--generations" && hasValue) {
+            settings.generations = std::max(std::atoi(argv[++i]), 1);
+        } else if (arg == "--seeds" && hasValue) {
+            settings.seedsPerCandidate = std::max(std::atoi(argv[++i]), 1);
+        } else if (arg == "--racers" && hasValue) {
+            settings.race.racers = std::max(std::atoi(argv[++i]), 1);
+        } else if (arg == "--obstacles" && hasValue) {
+            settings.race.extraObstacles = std::max(std::atoi(argv[++i]), 0);
+        } else if (arg == "--threads" && hasValue) {
+            settings.threads = std::max(std::atoi(argv[++i]), 1);
+        } else if (arg == "--seed" && hasValue) {
+            settings.baseSeed = (uint32_t)std::strtoul(argv[++i], nullptr, 10);
+        } else if (arg == "--out" && hasValue) {
+            settings.outPath = argv[++i];
+        } else {
+            std::fprintf(stderr, "Usage: %s [--difficulty 0-3] [--population n] [--generations n] [--seeds n] "
+                                 "[--racers n] [--obstacles n] [--threads n] [--seed s] [--out path]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    // Progress goes to stdout; race log lines are of no use here
+    Logger::GetInstance().SetConsoleOutput(false);
+
+    // Start from whatever the game would load now, so tuning one
+    // difficulty keeps the others
+    AIParamsTable table = AIParamsFile::Defaults();
+    AIParamsFile::Load(settings.outPath, table);
+
+    Tuner tuner(settings);
+    auto start = std::chrono::steady_clock::now();
+    // Hard first: the others are measured against it
+    for (int difficulty = AIParams::DIFFICULTY_COUNT; difficulty >= 1; difficulty--) {
+        if (settings.difficulty != 0 && settings.difficulty != difficulty) continue;
+        table[difficulty - 1] = tuner.Tune(difficulty, table[difficulty - 1], table[AIParams::DIFFICULTY_COUNT - 1]);
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    bool saved = AIParamsFile::Save(settings.outPath, table, DescribeRun(settings));
+    std::printf("{\"tuner\":\"done\",\"threads\":%d,\"races\":%lld,\"seconds\":%.1f,\"races_per_min\":%.0f,"
+                "\"saved\":%s}\n",
+                tuner.GetThreadCount(), tuner.GetRacesRun(), seconds,
+                seconds > 0.0 ? tuner.GetRacesRun() * 60.0 / seconds : 0.0, saved ? "true" : "false");
+
+    Logger::GetInstance().Shutdown();
+    return saved ? 0 : 1;
+}